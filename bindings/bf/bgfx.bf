@@ -2139,6 +2139,8 @@ public static class bgfx
 			public uint32 minResourceCbSize;
 			public uint32 transientVbSize;
 			public uint32 transientIbSize;
+			public uint16 maxSortThreads;
+			public uint32 maxUploadSize;
 		}
 	
 		public RendererType type;
@@ -2269,6 +2271,9 @@ public static class bgfx
 		public uint32 numBlit;
 		public uint32 maxGpuLatency;
 		public uint32 gpuFrameNum;
+		public uint32 numPipelinesPending;
+		public uint32 numPipelineCacheHits;
+		public uint32 numPipelineCacheMisses;
 		public uint16 numDynamicIndexBuffers;
 		public uint16 numDynamicVertexBuffers;
 		public uint16 numFrameBuffers;
@@ -2284,9 +2289,20 @@ public static class bgfx
 		public int64 rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public int64 dynamicIbTotal;
+		public int64 dynamicIbFree;
+		public uint32 dynamicIbLargestFree;
+		public int64 dynamicVbTotal;
+		public int64 dynamicVbFree;
+		public uint32 dynamicVbLargestFree;
 		public uint32[5] numPrims;
 		public int64 gpuMemoryMax;
 		public int64 gpuMemoryUsed;
+		public int64 gpuMemoryAllocated;
+		public int64 gpuMemoryBlockFree;
+		public int64 gpuMemoryLargestFree;
+		public uint32 numGpuMemoryAllocs;
+		public uint32 numGpuMemorySubAllocs;
 		public uint16 width;
 		public uint16 height;
 		public uint16 textWidth;
@@ -2311,6 +2327,12 @@ public static class bgfx
 	{
 	}
 	
+	[CRepr]
+	public struct DrawBundleHandle {
+	    public uint16 idx;
+	    public bool Valid => idx != uint16.MaxValue;
+	}
+	
 	[CRepr]
 	public struct DynamicIndexBufferHandle {
 	    public uint16 idx;
@@ -2545,6 +2567,27 @@ public static class bgfx
 	[LinkName("bgfx_topology_sort_tri_list")]
 	public static extern void topology_sort_tri_list(TopologySort _sort, void* _dst, uint32 _dstSize, float _dir, float _pos, void* _vertices, uint32 _stride, void* _indices, uint32 _numIndices, bool _index32);
 	
+	/// <summary>
+	/// Sort indices, using caller provided scratch memory.
+	/// </summary>
+	///
+	/// <param name="_sort">Sort order, see `TopologySort::Enum`.</param>
+	/// <param name="_dst">Destination index buffer.</param>
+	/// <param name="_dstSize">Destination index buffer in bytes. It must be large enough to contain output indices. If destination size is insufficient index buffer will be truncated.</param>
+	/// <param name="_dir">Direction (vector must be normalized).</param>
+	/// <param name="_pos">Position.</param>
+	/// <param name="_vertices">Pointer to first vertex represented as float x, y, z. Must contain at least number of vertices referencende by index buffer.</param>
+	/// <param name="_stride">Vertex stride.</param>
+	/// <param name="_indices">Source indices.</param>
+	/// <param name="_numIndices">Number of input indices.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_scratch">Scratch memory. If this argument is NULL function will only return required scratch memory size.</param>
+	/// <param name="_scratchSize">Scratch memory size in bytes.</param>
+	/// <param name="_coherent">Set to `true` when the same scratch memory was used to sort the same index buffer before. Triangle order of the previous sort is used as starting point, which is faster when view changes a little between sorts.</param>
+	///
+	[LinkName("bgfx_topology_sort_tri_list_scratch")]
+	public static extern uint32 topology_sort_tri_list_scratch(TopologySort _sort, void* _dst, uint32 _dstSize, float _dir, float _pos, void* _vertices, uint32 _stride, void* _indices, uint32 _numIndices, bool _index32, void* _scratch, uint32 _scratchSize, bool _coherent);
+	
 	/// <summary>
 	/// Returns supported backend API renderers.
 	/// </summary>
@@ -3284,6 +3327,15 @@ public static class bgfx
 	[LinkName("bgfx_get_direct_access_ptr")]
 	public static extern void* get_direct_access_ptr(TextureHandle _handle);
 	
+	/// <summary>
+	/// Returns texture residency.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	///
+	[LinkName("bgfx_is_texture_resident")]
+	public static extern bool is_texture_resident(TextureHandle _handle);
+	
 	/// <summary>
 	/// Destroy texture.
 	/// </summary>
@@ -3463,6 +3515,23 @@ public static class bgfx
 	[LinkName("bgfx_destroy_occlusion_query")]
 	public static extern void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create draw bundle. Draw bundle retains draw calls recorded with
+	/// `bgfx::Encoder::beginDrawBundle` across frames.
+	/// </summary>
+	///
+	[LinkName("bgfx_create_draw_bundle")]
+	public static extern DrawBundleHandle create_draw_bundle();
+	
+	/// <summary>
+	/// Destroy draw bundle.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw bundle object.</param>
+	///
+	[LinkName("bgfx_destroy_draw_bundle")]
+	public static extern void destroy_draw_bundle(DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -4004,6 +4073,39 @@ public static class bgfx
 	[LinkName("bgfx_encoder_submit_indirect_count")]
 	public static extern void encoder_submit_indirect_count(Encoder* _this, ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint32 _start, IndexBufferHandle _numHandle, uint32 _numIndex, uint32 _numMax, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Start recording draw calls into draw bundle. All draw calls submitted
+	/// until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+	/// being submitted for rendering. Previous content of draw bundle is
+	/// discarded.
+	/// @remark
+	///   Transient buffers and occlusion queries can't be recorded.
+	///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+	///   and dynamic buffers must not be resized, while draw bundle is in use.
+	///   Otherwise submit of draw bundle is dropped until it's recorded again.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[LinkName("bgfx_encoder_begin_draw_bundle")]
+	public static extern void encoder_begin_draw_bundle(Encoder* _this, DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// Stop recording draw calls into draw bundle.
+	/// </summary>
+	///
+	[LinkName("bgfx_encoder_end_draw_bundle")]
+	public static extern void encoder_end_draw_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// Submit all draw calls retained in draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[LinkName("bgfx_encoder_submit_draw_bundle")]
+	public static extern void encoder_submit_draw_bundle(Encoder* _this, DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4581,6 +4683,39 @@ public static class bgfx
 	[LinkName("bgfx_submit_indirect_count")]
 	public static extern void submit_indirect_count(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint32 _start, IndexBufferHandle _numHandle, uint32 _numIndex, uint32 _numMax, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Start recording draw calls into draw bundle. All draw calls submitted
+	/// until `bgfx::endDrawBundle` are retained in draw bundle instead of
+	/// being submitted for rendering. Previous content of draw bundle is
+	/// discarded.
+	/// @remark
+	///   Transient buffers and occlusion queries can't be recorded.
+	///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+	///   and dynamic buffers must not be resized, while draw bundle is in use.
+	///   Otherwise submit of draw bundle is dropped until it's recorded again.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[LinkName("bgfx_begin_draw_bundle")]
+	public static extern void begin_draw_bundle(DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// Stop recording draw calls into draw bundle.
+	/// </summary>
+	///
+	[LinkName("bgfx_end_draw_bundle")]
+	public static extern void end_draw_bundle();
+	
+	/// <summary>
+	/// Submit all draw calls retained in draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[LinkName("bgfx_submit_draw_bundle")]
+	public static extern void submit_draw_bundle(DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
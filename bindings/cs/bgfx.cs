@@ -2115,6 +2115,8 @@ public static partial class bgfx
 			public uint minResourceCbSize;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public ushort maxSortThreads;
+			public uint maxUploadSize;
 		}
 	
 		public RendererType type;
@@ -2234,6 +2236,9 @@ public static partial class bgfx
 		public uint numBlit;
 		public uint maxGpuLatency;
 		public uint gpuFrameNum;
+		public uint numPipelinesPending;
+		public uint numPipelineCacheHits;
+		public uint numPipelineCacheMisses;
 		public ushort numDynamicIndexBuffers;
 		public ushort numDynamicVertexBuffers;
 		public ushort numFrameBuffers;
@@ -2249,9 +2254,20 @@ public static partial class bgfx
 		public long rtMemoryUsed;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public long dynamicIbTotal;
+		public long dynamicIbFree;
+		public uint dynamicIbLargestFree;
+		public long dynamicVbTotal;
+		public long dynamicVbFree;
+		public uint dynamicVbLargestFree;
 		public fixed uint numPrims[5];
 		public long gpuMemoryMax;
 		public long gpuMemoryUsed;
+		public long gpuMemoryAllocated;
+		public long gpuMemoryBlockFree;
+		public long gpuMemoryLargestFree;
+		public uint numGpuMemoryAllocs;
+		public uint numGpuMemorySubAllocs;
 		public ushort width;
 		public ushort height;
 		public ushort textWidth;
@@ -2274,6 +2290,11 @@ public static partial class bgfx
 	{
 	}
 	
+	public struct DrawBundleHandle {
+	    public ushort idx;
+	    public bool Valid => idx != UInt16.MaxValue;
+	}
+	
 	public struct DynamicIndexBufferHandle {
 	    public ushort idx;
 	    public bool Valid => idx != UInt16.MaxValue;
@@ -2497,6 +2518,27 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_topology_sort_tri_list", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void topology_sort_tri_list(TopologySort _sort, void* _dst, uint _dstSize, float _dir, float _pos, void* _vertices, uint _stride, void* _indices, uint _numIndices, bool _index32);
 	
+	/// <summary>
+	/// Sort indices, using caller provided scratch memory.
+	/// </summary>
+	///
+	/// <param name="_sort">Sort order, see `TopologySort::Enum`.</param>
+	/// <param name="_dst">Destination index buffer.</param>
+	/// <param name="_dstSize">Destination index buffer in bytes. It must be large enough to contain output indices. If destination size is insufficient index buffer will be truncated.</param>
+	/// <param name="_dir">Direction (vector must be normalized).</param>
+	/// <param name="_pos">Position.</param>
+	/// <param name="_vertices">Pointer to first vertex represented as float x, y, z. Must contain at least number of vertices referencende by index buffer.</param>
+	/// <param name="_stride">Vertex stride.</param>
+	/// <param name="_indices">Source indices.</param>
+	/// <param name="_numIndices">Number of input indices.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_scratch">Scratch memory. If this argument is NULL function will only return required scratch memory size.</param>
+	/// <param name="_scratchSize">Scratch memory size in bytes.</param>
+	/// <param name="_coherent">Set to `true` when the same scratch memory was used to sort the same index buffer before. Triangle order of the previous sort is used as starting point, which is faster when view changes a little between sorts.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_topology_sort_tri_list_scratch", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint topology_sort_tri_list_scratch(TopologySort _sort, void* _dst, uint _dstSize, float _dir, float _pos, void* _vertices, uint _stride, void* _indices, uint _numIndices, bool _index32, void* _scratch, uint _scratchSize, bool _coherent);
+	
 	/// <summary>
 	/// Returns supported backend API renderers.
 	/// </summary>
@@ -3240,6 +3282,16 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_get_direct_access_ptr", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void* get_direct_access_ptr(TextureHandle _handle);
 	
+	/// <summary>
+	/// Returns texture residency.
+	/// </summary>
+	///
+	/// <param name="_handle">Texture handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_is_texture_resident", CallingConvention = CallingConvention.Cdecl)]
+	[return: MarshalAs(UnmanagedType.I1)]
+	public static extern unsafe bool is_texture_resident(TextureHandle _handle);
+	
 	/// <summary>
 	/// Destroy texture.
 	/// </summary>
@@ -3419,6 +3471,23 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_occlusion_query", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Create draw bundle. Draw bundle retains draw calls recorded with
+	/// `bgfx::Encoder::beginDrawBundle` across frames.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe DrawBundleHandle create_draw_bundle();
+	
+	/// <summary>
+	/// Destroy draw bundle.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to draw bundle object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_draw_bundle(DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3960,6 +4029,39 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_indirect_count", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_submit_indirect_count(Encoder* _this, ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint _start, IndexBufferHandle _numHandle, uint _numIndex, uint _numMax, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Start recording draw calls into draw bundle. All draw calls submitted
+	/// until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+	/// being submitted for rendering. Previous content of draw bundle is
+	/// discarded.
+	/// @remark
+	///   Transient buffers and occlusion queries can't be recorded.
+	///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+	///   and dynamic buffers must not be resized, while draw bundle is in use.
+	///   Otherwise submit of draw bundle is dropped until it's recorded again.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_begin_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_begin_draw_bundle(Encoder* _this, DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// Stop recording draw calls into draw bundle.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_end_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_end_draw_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// Submit all draw calls retained in draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_draw_bundle(Encoder* _this, DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4537,6 +4639,39 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_submit_indirect_count", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void submit_indirect_count(ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint _start, IndexBufferHandle _numHandle, uint _numIndex, uint _numMax, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Start recording draw calls into draw bundle. All draw calls submitted
+	/// until `bgfx::endDrawBundle` are retained in draw bundle instead of
+	/// being submitted for rendering. Previous content of draw bundle is
+	/// discarded.
+	/// @remark
+	///   Transient buffers and occlusion queries can't be recorded.
+	///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+	///   and dynamic buffers must not be resized, while draw bundle is in use.
+	///   Otherwise submit of draw bundle is dropped until it's recorded again.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_begin_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void begin_draw_bundle(DrawBundleHandle _handle);
+	
+	/// <summary>
+	/// Stop recording draw calls into draw bundle.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_end_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void end_draw_bundle();
+	
+	/// <summary>
+	/// Submit all draw calls retained in draw bundle for rendering.
+	/// </summary>
+	///
+	/// <param name="_handle">Draw bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_draw_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_draw_bundle(DrawBundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -1355,6 +1355,8 @@ pub const Init = extern struct {
         minResourceCbSize: u32,
         transientVbSize: u32,
         transientIbSize: u32,
+        maxSortThreads: u16,
+        maxUploadSize: u32,
     };
 
         type: RendererType,
@@ -1473,6 +1475,9 @@ pub const Init = extern struct {
         numBlit: u32,
         maxGpuLatency: u32,
         gpuFrameNum: u32,
+        numPipelinesPending: u32,
+        numPipelineCacheHits: u32,
+        numPipelineCacheMisses: u32,
         numDynamicIndexBuffers: u16,
         numDynamicVertexBuffers: u16,
         numFrameBuffers: u16,
@@ -1488,9 +1493,20 @@ pub const Init = extern struct {
         rtMemoryUsed: i64,
         transientVbUsed: i32,
         transientIbUsed: i32,
+        dynamicIbTotal: i64,
+        dynamicIbFree: i64,
+        dynamicIbLargestFree: u32,
+        dynamicVbTotal: i64,
+        dynamicVbFree: i64,
+        dynamicVbLargestFree: u32,
         numPrims: [5]u32,
         gpuMemoryMax: i64,
         gpuMemoryUsed: i64,
+        gpuMemoryAllocated: i64,
+        gpuMemoryBlockFree: i64,
+        gpuMemoryLargestFree: i64,
+        numGpuMemoryAllocs: u32,
+        numGpuMemorySubAllocs: u32,
         width: u16,
         height: u16,
         textWidth: u16,
@@ -1789,6 +1805,28 @@ pub const Init = extern struct {
         pub inline fn submitIndirectCount(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void {
             return bgfx_encoder_submit_indirect_count(self, _id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags);
         }
+        /// Start recording draw calls into draw bundle. All draw calls submitted
+        /// until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+        /// being submitted for rendering. Previous content of draw bundle is
+        /// discarded.
+        /// @remark
+        ///   Transient buffers and occlusion queries can't be recorded.
+        ///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+        ///   and dynamic buffers must not be resized, while draw bundle is in use.
+        ///   Otherwise submit of draw bundle is dropped until it's recorded again.
+        /// <param name="_handle">Draw bundle handle.</param>
+        pub inline fn beginDrawBundle(self: ?*Encoder, _handle: DrawBundleHandle) void {
+            return bgfx_encoder_begin_draw_bundle(self, _handle);
+        }
+        /// Stop recording draw calls into draw bundle.
+        pub inline fn endDrawBundle(self: ?*Encoder) void {
+            return bgfx_encoder_end_draw_bundle(self);
+        }
+        /// Submit all draw calls retained in draw bundle for rendering.
+        /// <param name="_handle">Draw bundle handle.</param>
+        pub inline fn submitDrawBundle(self: ?*Encoder, _handle: DrawBundleHandle) void {
+            return bgfx_encoder_submit_draw_bundle(self, _handle);
+        }
         /// Set compute index buffer.
         /// <param name="_stage">Compute stage.</param>
         /// <param name="_handle">Index buffer handle.</param>
@@ -1880,6 +1918,10 @@ pub const Init = extern struct {
         }
     };
 
+pub const DrawBundleHandle = extern struct {
+    idx: c_ushort,
+};
+
 pub const DynamicIndexBufferHandle = extern struct {
     idx: c_ushort,
 };
@@ -2044,6 +2086,25 @@ pub inline fn topologySortTriList(_sort: TopologySort, _dst: ?*anyopaque, _dstSi
 }
 extern fn bgfx_topology_sort_tri_list(_sort: TopologySort, _dst: ?*anyopaque, _dstSize: u32, _dir: [3]f32, _pos: [3]f32, _vertices: ?*const anyopaque, _stride: u32, _indices: ?*const anyopaque, _numIndices: u32, _index32: bool) void;
 
+/// Sort indices, using caller provided scratch memory.
+/// <param name="_sort">Sort order, see `TopologySort::Enum`.</param>
+/// <param name="_dst">Destination index buffer.</param>
+/// <param name="_dstSize">Destination index buffer in bytes. It must be large enough to contain output indices. If destination size is insufficient index buffer will be truncated.</param>
+/// <param name="_dir">Direction (vector must be normalized).</param>
+/// <param name="_pos">Position.</param>
+/// <param name="_vertices">Pointer to first vertex represented as float x, y, z. Must contain at least number of vertices referencende by index buffer.</param>
+/// <param name="_stride">Vertex stride.</param>
+/// <param name="_indices">Source indices.</param>
+/// <param name="_numIndices">Number of input indices.</param>
+/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+/// <param name="_scratch">Scratch memory. If this argument is NULL function will only return required scratch memory size.</param>
+/// <param name="_scratchSize">Scratch memory size in bytes.</param>
+/// <param name="_coherent">Set to `true` when the same scratch memory was used to sort the same index buffer before. Triangle order of the previous sort is used as starting point, which is faster when view changes a little between sorts.</param>
+pub inline fn topologySortTriListScratch(_sort: TopologySort, _dst: ?*anyopaque, _dstSize: u32, _dir: [3]f32, _pos: [3]f32, _vertices: ?*const anyopaque, _stride: u32, _indices: ?*const anyopaque, _numIndices: u32, _index32: bool, _scratch: ?*anyopaque, _scratchSize: u32, _coherent: bool) u32 {
+    return bgfx_topology_sort_tri_list_scratch(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, _scratch, _scratchSize, _coherent);
+}
+extern fn bgfx_topology_sort_tri_list_scratch(_sort: TopologySort, _dst: ?*anyopaque, _dstSize: u32, _dir: [3]f32, _pos: [3]f32, _vertices: ?*const anyopaque, _stride: u32, _indices: ?*const anyopaque, _numIndices: u32, _index32: bool, _scratch: ?*anyopaque, _scratchSize: u32, _coherent: bool) u32;
+
 /// Returns supported backend API renderers.
 /// <param name="_max">Maximum number of elements in _enum array.</param>
 /// <param name="_enum">Array where supported renderers will be written.</param>
@@ -2636,6 +2697,13 @@ pub inline fn getDirectAccessPtr(_handle: TextureHandle) ?*anyopaque {
 }
 extern fn bgfx_get_direct_access_ptr(_handle: TextureHandle) ?*anyopaque;
 
+/// Returns texture residency.
+/// <param name="_handle">Texture handle.</param>
+pub inline fn isTextureResident(_handle: TextureHandle) bool {
+    return bgfx_is_texture_resident(_handle);
+}
+extern fn bgfx_is_texture_resident(_handle: TextureHandle) bool;
+
 /// Destroy texture.
 /// <param name="_handle">Texture handle.</param>
 pub inline fn destroyTexture(_handle: TextureHandle) void {
@@ -2786,6 +2854,20 @@ pub inline fn destroyOcclusionQuery(_handle: OcclusionQueryHandle) void {
 }
 extern fn bgfx_destroy_occlusion_query(_handle: OcclusionQueryHandle) void;
 
+/// Create draw bundle. Draw bundle retains draw calls recorded with
+/// `bgfx::Encoder::beginDrawBundle` across frames.
+pub inline fn createDrawBundle() DrawBundleHandle {
+    return bgfx_create_draw_bundle();
+}
+extern fn bgfx_create_draw_bundle() DrawBundleHandle;
+
+/// Destroy draw bundle.
+/// <param name="_handle">Handle to draw bundle object.</param>
+pub inline fn destroyDrawBundle(_handle: DrawBundleHandle) void {
+    return bgfx_destroy_draw_bundle(_handle);
+}
+extern fn bgfx_destroy_draw_bundle(_handle: DrawBundleHandle) void;
+
 /// Set palette color value.
 /// <param name="_index">Index into palette.</param>
 /// <param name="_rgba">RGBA floating point values.</param>
@@ -3153,6 +3235,25 @@ extern fn bgfx_encoder_submit_indirect(self: ?*Encoder, _id: ViewId, _program: P
 /// <param name="_flags">Discard or preserve states. See `BGFX_DISCARD_*`.</param>
 extern fn bgfx_encoder_submit_indirect_count(self: ?*Encoder, _id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void;
 
+/// Start recording draw calls into draw bundle. All draw calls submitted
+/// until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+/// being submitted for rendering. Previous content of draw bundle is
+/// discarded.
+/// @remark
+///   Transient buffers and occlusion queries can't be recorded.
+///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+///   and dynamic buffers must not be resized, while draw bundle is in use.
+///   Otherwise submit of draw bundle is dropped until it's recorded again.
+/// <param name="_handle">Draw bundle handle.</param>
+extern fn bgfx_encoder_begin_draw_bundle(self: ?*Encoder, _handle: DrawBundleHandle) void;
+
+/// Stop recording draw calls into draw bundle.
+extern fn bgfx_encoder_end_draw_bundle(self: ?*Encoder) void;
+
+/// Submit all draw calls retained in draw bundle for rendering.
+/// <param name="_handle">Draw bundle handle.</param>
+extern fn bgfx_encoder_submit_draw_bundle(self: ?*Encoder, _handle: DrawBundleHandle) void;
+
 /// Set compute index buffer.
 /// <param name="_stage">Compute stage.</param>
 /// <param name="_handle">Index buffer handle.</param>
@@ -3610,6 +3711,34 @@ pub inline fn submitIndirectCount(_id: ViewId, _program: ProgramHandle, _indirec
 }
 extern fn bgfx_submit_indirect_count(_id: ViewId, _program: ProgramHandle, _indirectHandle: IndirectBufferHandle, _start: u32, _numHandle: IndexBufferHandle, _numIndex: u32, _numMax: u32, _depth: u32, _flags: u8) void;
 
+/// Start recording draw calls into draw bundle. All draw calls submitted
+/// until `bgfx::endDrawBundle` are retained in draw bundle instead of
+/// being submitted for rendering. Previous content of draw bundle is
+/// discarded.
+/// @remark
+///   Transient buffers and occlusion queries can't be recorded.
+///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+///   and dynamic buffers must not be resized, while draw bundle is in use.
+///   Otherwise submit of draw bundle is dropped until it's recorded again.
+/// <param name="_handle">Draw bundle handle.</param>
+pub inline fn beginDrawBundle(_handle: DrawBundleHandle) void {
+    return bgfx_begin_draw_bundle(_handle);
+}
+extern fn bgfx_begin_draw_bundle(_handle: DrawBundleHandle) void;
+
+/// Stop recording draw calls into draw bundle.
+pub inline fn endDrawBundle() void {
+    return bgfx_end_draw_bundle();
+}
+extern fn bgfx_end_draw_bundle() void;
+
+/// Submit all draw calls retained in draw bundle for rendering.
+/// <param name="_handle">Draw bundle handle.</param>
+pub inline fn submitDrawBundle(_handle: DrawBundleHandle) void {
+    return bgfx_submit_draw_bundle(_handle);
+}
+extern fn bgfx_submit_draw_bundle(_handle: DrawBundleHandle) void;
+
 /// Set compute index buffer.
 /// <param name="_stage">Compute stage.</param>
 /// <param name="_handle">Index buffer handle.</param>
@@ -119,6 +119,7 @@ public:
 		m_dim        = 16;
 		m_maxDim     = 40;
 		m_transform  = 0;
+		m_numSessions = 1;
 
 		m_timeOffset = bx::getHPCounter();
 
@@ -126,6 +127,8 @@ public:
 		m_deltaTimeAvgNs = 0;
 		m_numFrames      = 0;
 
+		bx::memSet(m_submitTime, 0, sizeof(m_submitTime) );
+
 		bgfx::Init init;
 		init.type     = args.m_type;
 		init.vendorId = args.m_pciId;
@@ -234,61 +237,74 @@ public:
 
 	void submit(uint32_t _tid, uint32_t _xstart, uint32_t _num)
 	{
-		bgfx::Encoder* encoder = bgfx::begin();
-		if (0 != _tid)
-		{
-			m_sync.post();
-		}
+		const int64_t begin = bx::getHPCounter();
+		const double freq = double(bx::getHPFrequency() );
+		float time = (float)( (begin-m_timeOffset)/freq);
 
-		if (NULL != encoder)
-		{
-			const int64_t now = bx::getHPCounter();
-			const double freq = double(bx::getHPFrequency() );
-			float time = (float)( (now-m_timeOffset)/freq);
+		const float* mod = s_mod[_tid%BX_COUNTOF(s_mod)];
+
+		float mtxS[16];
+		const float scale = 0 == m_transform ? 0.25f : 0.0f;
+		bx::mtxScale(mtxS, scale, scale, scale);
 
-			const float* mod = s_mod[_tid%BX_COUNTOF(s_mod)];
+		const float step = 0.6f;
+		float pos[3];
+		pos[0] = -step*m_dim / 2.0f;
+		pos[1] = -step*m_dim / 2.0f;
+		pos[2] = -15.0;
 
-			float mtxS[16];
-			const float scale = 0 == m_transform ? 0.25f : 0.0f;
-			bx::mtxScale(mtxS, scale, scale, scale);
+		// Splitting work into multiple encoder sessions per thread stresses render item
+		// slot reservation in the same way as many short-lived encoders do.
+		const uint32_t numSessions = bx::min<uint32_t>(m_numSessions, m_dim);
 
-			const float step = 0.6f;
-			float pos[3];
-			pos[0] = -step*m_dim / 2.0f;
-			pos[1] = -step*m_dim / 2.0f;
-			pos[2] = -15.0;
+		for (uint32_t session = 0; session < numSessions; ++session)
+		{
+			bgfx::Encoder* encoder = bgfx::begin();
+			if (0 != _tid
+			&&  session == numSessions-1)
+			{
+				m_sync.post();
+			}
 
-			for (uint32_t zz = 0; zz < uint32_t(m_dim); ++zz)
+			if (NULL != encoder)
 			{
-				for (uint32_t yy = 0; yy < uint32_t(m_dim); ++yy)
+				const uint32_t zbegin = session*m_dim/numSessions;
+				const uint32_t zend   = (session+1)*m_dim/numSessions;
+
+				for (uint32_t zz = zbegin; zz < zend; ++zz)
 				{
-					for (uint32_t xx = _xstart, xend = _xstart+_num; xx < xend; ++xx)
+					for (uint32_t yy = 0; yy < uint32_t(m_dim); ++yy)
 					{
-						float mtxR[16];
-						bx::mtxRotateXYZ(mtxR
-							, (time + xx*0.21f)*mod[0]
-							, (time + yy*0.37f)*mod[1]
-							, (time + zz*0.13f)*mod[2]
-							);
-
-						float mtx[16];
-						bx::mtxMul(mtx, mtxS, mtxR);
-
-						mtx[12] = pos[0] + float(xx)*step;
-						mtx[13] = pos[1] + float(yy)*step;
-						mtx[14] = pos[2] + float(zz)*step;
-
-						encoder->setTransform(mtx);
-						encoder->setVertexBuffer(0, m_vbh);
-						encoder->setIndexBuffer(m_ibh);
-						encoder->setState(BGFX_STATE_DEFAULT);
-						encoder->submit(0, m_program);
+						for (uint32_t xx = _xstart, xend = _xstart+_num; xx < xend; ++xx)
+						{
+							float mtxR[16];
+							bx::mtxRotateXYZ(mtxR
+								, (time + xx*0.21f)*mod[0]
+								, (time + yy*0.37f)*mod[1]
+								, (time + zz*0.13f)*mod[2]
+								);
+
+							float mtx[16];
+							bx::mtxMul(mtx, mtxS, mtxR);
+
+							mtx[12] = pos[0] + float(xx)*step;
+							mtx[13] = pos[1] + float(yy)*step;
+							mtx[14] = pos[2] + float(zz)*step;
+
+							encoder->setTransform(mtx);
+							encoder->setVertexBuffer(0, m_vbh);
+							encoder->setIndexBuffer(m_ibh);
+							encoder->setState(BGFX_STATE_DEFAULT);
+							encoder->submit(0, m_program);
+						}
 					}
 				}
-			}
 
-			bgfx::end(encoder);
+				bgfx::end(encoder);
+			}
 		}
+
+		m_submitTime[_tid] = bx::getHPCounter() - begin;
 	}
 
 	bool update() override
@@ -367,6 +383,31 @@ public:
 			ImGui::Text("Draw calls: %d", m_dim*m_dim*m_dim);
 			ImGui::Text("Avg Delta Time (1 second) [ms]: %0.4f", m_deltaTimeAvgNs/1000.0f);
 
+			ImGui::SliderInt("Sessions", &m_numSessions, 1, 64);
+			if (ImGui::IsItemHovered() )
+			{
+				ImGui::SetTooltip("Number of encoder begin/end sessions per thread.\nRun with --noop to measure submit overhead only.");
+			}
+
+			{
+				// Thread time spent in submit, summed over all submitting threads.
+				int64_t submitTime = m_submitTime[0];
+				if (1 < numThreads)
+				{
+					submitTime = 0;
+					for (uint32_t ii = 0; ii < numThreads; ++ii)
+					{
+						submitTime += m_submitTime[ii+1];
+					}
+				}
+
+				const double numDraws = double(m_dim*m_dim*m_dim);
+				ImGui::Text("Submit %0.4f [ms], %0.1f [ns/draw]"
+					, double(submitTime)*toMs
+					, double(submitTime)*1000000.0*toMs/numDraws
+					);
+			}
+
 			ImGui::Separator();
 			const bgfx::Stats* stats = bgfx::getStats();
 			ImGui::Text("GPU %0.6f [ms]", double(stats->gpuTimeEnd - stats->gpuTimeBegin)*1000.0/stats->gpuTimerFreq);
@@ -439,6 +480,7 @@ public:
 	int32_t  m_transform;
 	int32_t  m_numThreads;
 	int32_t  m_maxThreads;
+	int32_t  m_numSessions;
 
 	int64_t  m_timeOffset;
 
@@ -449,6 +491,8 @@ public:
 	bx::Thread m_thread[5];
 	bx::Semaphore m_sync;
 
+	int64_t m_submitTime[BX_COUNTOF(m_thread)+1];
+
 	bgfx::ProgramHandle m_program;
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
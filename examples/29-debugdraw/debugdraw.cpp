@@ -798,6 +798,7 @@ public:
 				);
 
 		m_timeOffset = bx::getHPCounter();
+		m_ddTime     = 0.0;
 
 		cameraCreate();
 
@@ -895,6 +896,18 @@ public:
 			static float timeScale = 1.0f;
 			ImGui::SliderFloat("T scale", &timeScale, -1.0f, 1.0f);
 
+			ImGui::Separator();
+
+			static bool stress = false;
+			ImGui::Checkbox("Stress test", &stress);
+
+			static int32_t stressNum = 10000;
+			ImGui::SliderInt("Shapes", &stressNum, 1000, 50000);
+
+			const bgfx::Stats* stats = bgfx::getStats();
+			ImGui::Text("Draw calls: %d", stats->numDraw);
+			ImGui::Text("CPU: %0.3f [ms]", m_ddTime);
+
 			ImGui::End();
 
 			imguiEndFrame();
@@ -944,6 +957,8 @@ public:
 			constexpr uint32_t kOverlapA = 0xff0000ff;
 			constexpr uint32_t kOverlapB = 0xff8080ff;
 
+			const int64_t ddStart = bx::getHPCounter();
+
 			DebugDrawEncoder dde;
 
 			dde.begin(0);
@@ -1200,8 +1215,40 @@ public:
 
 			dde.pop();
 
+			if (stress)
+			{
+				dde.push();
+					dde.setLod(UINT8_MAX);
+
+					const uint32_t size = uint32_t(bx::ceil(bx::sqrt(float(stressNum) ) ) );
+					const float    step = 0.5f;
+
+					for (uint32_t ii = 0, num = uint32_t(stressNum); ii < num; ++ii)
+					{
+						const bx::Vec3 pos =
+						{
+							(float(ii%size) - size*0.5f) * step,
+							-4.0f,
+							(float(ii/size) - size*0.5f) * step,
+						};
+
+						dde.setColor(0xff000000 | (ii*0x9e3779b9 >> 8) );
+
+						switch (ii%4)
+						{
+						case 0: dde.draw(bx::Sphere{ pos, 0.2f }); break;
+						case 1: dde.draw(bx::Cone{ pos, bx::add(pos, { 0.0f, 0.4f, 0.0f }), 0.2f }); break;
+						case 2: dde.draw(bx::Cylinder{ pos, bx::add(pos, { 0.0f, 0.4f, 0.0f }), 0.1f }); break;
+						default: dde.draw(bx::Capsule{ pos, bx::add(pos, { 0.0f, 0.4f, 0.0f }), 0.1f }); break;
+						}
+					}
+				dde.pop();
+			}
+
 			dde.end();
 
+			m_ddTime = double(bx::getHPCounter() - ddStart)*1000.0/freq;
+
 			// Advance to next frame. Rendering thread will be kicked to
 			// process submitted rendering primitives.
 			bgfx::frame();
@@ -1218,6 +1265,7 @@ public:
 	GeometryHandle m_bunny;
 
 	int64_t m_timeOffset;
+	double  m_ddTime;
 
 	uint32_t m_width;
 	uint32_t m_height;
@@ -267,7 +267,7 @@ public:
 
 		ddInit();
 
-		psInit();
+		psInit(64, NULL, kNumThreads);
 
 		bimg::ImageContainer* image = imageLoad(
 			  "textures/particle.ktx"
@@ -297,6 +297,8 @@ public:
 		cameraSetVerticalAngle(0.0f);
 
 		m_timeOffset = bx::getHPCounter();
+		m_updateTime = 0.0f;
+		m_renderTime = 0.0f;
 	}
 
 	virtual int shutdown() override
@@ -400,6 +402,20 @@ public:
 
 			m_emitter[currentEmitter].imgui();
 
+			ImGui::Separator();
+
+			// Times are averaged over recent frames, so numbers are readable.
+			const uint32_t numParticles = psGetNumParticles();
+			ImGui::Text("Particles: %d, threads: %d", numParticles, kNumThreads+1);
+			ImGui::Text("Update: %.3f ms, %.0f particles/ms"
+				, m_updateTime
+				, 0.0f < m_updateTime ? numParticles/m_updateTime : 0.0f
+				);
+			ImGui::Text("Render: %.3f ms, %.0f particles/ms"
+				, m_renderTime
+				, 0.0f < m_renderTime ? numParticles/m_renderTime : 0.0f
+				);
+
 			ImGui::End();
 
 			m_emitter[currentEmitter].gizmo(view, proj);
@@ -415,8 +431,18 @@ public:
 
 			m_emitter[currentEmitter].update();
 
+			const double toMs = 1000.0/freq;
+
+			int64_t updateTime = -bx::getHPCounter();
 			psUpdate(deltaTime * timeScale);
+			updateTime += bx::getHPCounter();
+
+			int64_t renderTime = -bx::getHPCounter();
 			psRender(0, view, eye);
+			renderTime += bx::getHPCounter();
+
+			m_updateTime = bx::lerp(m_updateTime, float(updateTime*toMs), 0.05f);
+			m_renderTime = bx::lerp(m_renderTime, float(renderTime*toMs), 0.05f);
 
 			if (showBounds)
 			{
@@ -443,7 +469,12 @@ public:
 
 	entry::MouseState m_mouseState;
 
+	/// Number of worker threads, calling thread also updates emitters.
+	static constexpr uint16_t kNumThreads = 3;
+
 	int64_t m_timeOffset;
+	float m_updateTime;
+	float m_renderTime;
 
 	uint32_t m_width;
 	uint32_t m_height;
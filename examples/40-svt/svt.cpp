@@ -13,6 +13,8 @@
   *   http://web.archive.org/web/20190103162730/http://www.celestiamotherlode.net/catalog/mars.php
   */
 
+#include <bx/commandline.h>
+
 #include "common.h"
 #include "bgfx_utils.h"
 #include "imgui/imgui.h"
@@ -142,20 +144,31 @@ public:
 		m_vti = new vt::VirtualTextureInfo();
 		m_vti->m_virtualTextureSize = 8192; // The actual size will be read from the tile data file
 		m_vti->m_tileSize = 128;
-		m_vti->m_borderSize = 1;
+		m_vti->m_borderSize = 2; // Page size is multiple of 4 so pages can be BC1 compressed
 
 		// Generate tile data file (if not yet created)
+		// --tilegen-threads <n> sets number of worker threads, --tilegen-force regenerates file,
+		// generation time is printed to debug output.
 		{
-			vt::TileGenerator tileGenerator(m_vti);
-			tileGenerator.generate("textures/8k_mars.jpg");
+			bx::CommandLine cmdLine(_argc, _argv);
+
+			int32_t numThreads = 3;
+			const char* threads = cmdLine.findOption("tilegen-threads");
+			if (nullptr != threads)
+			{
+				bx::fromString(&numThreads, threads);
+			}
+
+			vt::TileGenerator tileGenerator(m_vti, uint32_t(bx::max(numThreads, 0) ) );
+			tileGenerator.generate("textures/8k_mars.jpg", cmdLine.hasArg("tilegen-force") );
 		}
 
 		// Load tile data file
-		auto tileDataFile = new vt::TileDataFile("temp/8k_mars.vt", m_vti);
-		tileDataFile->readInfo();
+		m_tileDataFile = new vt::TileDataFile("temp/8k_mars.vt", m_vti);
+		m_tileDataFile->readInfo();
 
 		// Create virtual texture and feedback buffer
-		m_vt = new vt::VirtualTexture(tileDataFile, m_vti, 2048, 1);
+		m_vt = new vt::VirtualTexture(m_tileDataFile, m_vti, 2048, 1);
 		m_feedbackBuffer = new vt::FeedbackBuffer(m_vti, 64, 64);
 
 	}
@@ -174,8 +187,10 @@ public:
 		bgfx::destroy(m_vt_unlit);
 		bgfx::destroy(m_vt_mip);
 
-		delete m_vti;
+		// Virtual texture loader threads use texture info
 		delete m_vt;
+		delete m_tileDataFile;
+		delete m_vti;
 		delete m_feedbackBuffer;
 
 		// Shutdown bgfx.
@@ -367,6 +382,7 @@ public:
 
 	bx::DefaultAllocator m_vtAllocator;
 	vt::VirtualTextureInfo* m_vti;
+	vt::TileDataFile* m_tileDataFile;
 	vt::VirtualTexture* m_vt;
 	vt::FeedbackBuffer* m_feedbackBuffer;
 };
@@ -13,17 +13,197 @@
   *   http://web.archive.org/web/20190103162730/http://www.celestiamotherlode.net/catalog/mars.php
   */
 
+#include <bx/cpu.h>
 #include <bx/file.h>
 #include <bx/sort.h>
+#include <bx/timer.h>
 
 #include "vt.h"
+#include "workerpool.h"
+
+#if BX_PLATFORM_WINDOWS
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // WIN32_LEAN_AND_MEAN
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif // NOMINMAX
+#	include <windows.h>
+#elif BX_PLATFORM_POSIX
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif // BX_PLATFORM_*
 
 namespace vt
 {
 
 // Constants
 static const int s_channelCount = 4;
-static const int s_tileFileDataOffset = sizeof(VirtualTextureInfo);
+static const uint32_t s_tileFileMagic = BX_MAKEFOURCC('V', 'T', 'F', 0);
+static const uint32_t s_tileFileVersion = 2;
+
+// Tile data file header, followed by page offset table
+struct TileDataHeader
+{
+	uint32_t m_magic;
+	uint32_t m_version;
+	int32_t  m_virtualTextureSize;
+	int32_t  m_tileSize;
+	int32_t  m_borderSize;
+	uint32_t m_pageFormat;
+	uint32_t m_numPages;
+	uint32_t m_reserved;
+};
+
+static uint16_t packRgb565(const float* _rgb)
+{
+	const uint32_t rr = uint32_t(bx::clamp(_rgb[0] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f) );
+	const uint32_t gg = uint32_t(bx::clamp(_rgb[1] * 63.0f / 255.0f + 0.5f, 0.0f, 63.0f) );
+	const uint32_t bb = uint32_t(bx::clamp(_rgb[2] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f) );
+	return uint16_t( (rr << 11) | (gg << 5) | bb);
+}
+
+static void unpackRgb565(float* _rgb, uint16_t _color)
+{
+	const uint32_t rr = (_color >> 11) & 0x1f;
+	const uint32_t gg = (_color >>  5) & 0x3f;
+	const uint32_t bb = (_color      ) & 0x1f;
+	_rgb[0] = float( (rr << 3) | (rr >> 2) );
+	_rgb[1] = float( (gg << 2) | (gg >> 4) );
+	_rgb[2] = float( (bb << 3) | (bb >> 2) );
+}
+
+static void storeBc1Block(uint8_t* _dst, uint16_t _color0, uint16_t _color1, uint32_t _indices)
+{
+	_dst[0] = uint8_t(_color0);
+	_dst[1] = uint8_t(_color0 >> 8);
+	_dst[2] = uint8_t(_color1);
+	_dst[3] = uint8_t(_color1 >> 8);
+	_dst[4] = uint8_t(_indices);
+	_dst[5] = uint8_t(_indices >> 8);
+	_dst[6] = uint8_t(_indices >> 16);
+	_dst[7] = uint8_t(_indices >> 24);
+}
+
+// Encodes 4x4 BGRA8 block, endpoints are corners of inset color bounding box.
+static void encodeBc1Block(uint8_t* _dst, const uint8_t* _src, uint32_t _srcPitch)
+{
+	float rgb[16][3];
+	float minColor[3] = { 255.0f, 255.0f, 255.0f };
+	float maxColor[3] = {   0.0f,   0.0f,   0.0f };
+
+	for (uint32_t ii = 0; ii < 16; ++ii)
+	{
+		const uint8_t* src = &_src[(ii / 4) * _srcPitch + (ii % 4) * s_channelCount];
+		rgb[ii][0] = float(src[2]);
+		rgb[ii][1] = float(src[1]);
+		rgb[ii][2] = float(src[0]);
+
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			minColor[jj] = bx::min(minColor[jj], rgb[ii][jj]);
+			maxColor[jj] = bx::max(maxColor[jj], rgb[ii][jj]);
+		}
+	}
+
+	for (uint32_t jj = 0; jj < 3; ++jj)
+	{
+		const float inset = (maxColor[jj] - minColor[jj]) / 16.0f;
+		minColor[jj] += inset;
+		maxColor[jj] -= inset;
+	}
+
+	uint16_t color0 = packRgb565(maxColor);
+	uint16_t color1 = packRgb565(minColor);
+
+	if (color0 < color1)
+	{
+		bx::swap(color0, color1);
+	}
+
+	uint32_t indices = 0;
+
+	// Equal endpoints leave all indices at 0, otherwise color0 > color1 selects 4 color mode
+	if (color0 != color1)
+	{
+		float palette[4][3];
+		unpackRgb565(palette[0], color0);
+		unpackRgb565(palette[1], color1);
+
+		for (uint32_t jj = 0; jj < 3; ++jj)
+		{
+			palette[2][jj] = (2.0f * palette[0][jj] +        palette[1][jj]) / 3.0f;
+			palette[3][jj] = (       palette[0][jj] + 2.0f * palette[1][jj]) / 3.0f;
+		}
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			uint32_t best = 0;
+			float bestDist = bx::kFloatLargest;
+
+			for (uint32_t kk = 0; kk < 4; ++kk)
+			{
+				const float dr = rgb[ii][0] - palette[kk][0];
+				const float dg = rgb[ii][1] - palette[kk][1];
+				const float db = rgb[ii][2] - palette[kk][2];
+				const float dist = dr * dr + dg * dg + db * db;
+
+				if (dist < bestDist)
+				{
+					best = kk;
+					bestDist = dist;
+				}
+			}
+
+			indices |= best << (ii * 2);
+		}
+	}
+
+	storeBc1Block(_dst, color0, color1, indices);
+}
+
+static void compressPage(uint8_t* _dst, const uint8_t* _src, int _pagesize, bgfx::TextureFormat::Enum _format)
+{
+	const uint32_t pitch = _pagesize * s_channelCount;
+
+	if (bgfx::TextureFormat::BC1 != _format)
+	{
+		bx::memCopy(_dst, _src, pitch * _pagesize);
+		return;
+	}
+
+	for (int y = 0; y < _pagesize; y += 4)
+	{
+		for (int x = 0; x < _pagesize; x += 4)
+		{
+			encodeBc1Block(_dst, &_src[y * pitch + x * s_channelCount], pitch);
+			_dst += 8;
+		}
+	}
+}
+
+struct CompressPageTask
+{
+	const uint8_t*				m_src;
+	uint8_t*					m_dst;
+	uint32_t					m_srcPageSize;
+	uint32_t					m_dstPageSize;
+	int							m_pagesize;
+	bgfx::TextureFormat::Enum	m_format;
+};
+
+static void compressPageTask(void* _userData, uint32_t _idx, uint32_t /*_num*/)
+{
+	const CompressPageTask& task = *(const CompressPageTask*)_userData;
+	compressPage(
+		  &task.m_dst[_idx * task.m_dstPageSize]
+		, &task.m_src[_idx * task.m_srcPageSize]
+		, task.m_pagesize
+		, task.m_format
+		);
+}
 
 // Page
 Page::operator size_t() const
@@ -53,6 +233,7 @@ VirtualTextureInfo::VirtualTextureInfo()
 	: m_virtualTextureSize(0)
 	, m_tileSize(0)
 	, m_borderSize(0)
+	, m_pageFormat(bgfx::TextureFormat::BGRA8)
 {
 }
 
@@ -66,11 +247,24 @@ int VirtualTextureInfo::GetPageTableSize() const
 	return m_virtualTextureSize / m_tileSize;
 }
 
-StagingPool::StagingPool(int _width, int _height, int _count, bool _readBack)
+int VirtualTextureInfo::GetPageDataSize() const
+{
+	const int pagesize = GetPageSize();
+
+	if (bgfx::TextureFormat::BC1 == m_pageFormat)
+	{
+		return (pagesize / 4) * (pagesize / 4) * 8;
+	}
+
+	return pagesize * pagesize * s_channelCount;
+}
+
+StagingPool::StagingPool(int _width, int _height, int _count, bool _readBack, bgfx::TextureFormat::Enum _format)
 	: m_stagingTextureIndex(0)
 	, m_width(_width)
 	, m_height(_height)
 	, m_flags(0)
+	, m_format(_format)
 {
 	m_flags = BGFX_TEXTURE_BLIT_DST | BGFX_SAMPLER_UVW_CLAMP;
 	if (_readBack)
@@ -92,7 +286,7 @@ void StagingPool::grow(int count)
 {
 	while ((int)m_stagingTextures.size() < count)
 	{
-		auto stagingTexture = bgfx::createTexture2D((uint16_t)m_width, (uint16_t)m_height, false, 1, bgfx::TextureFormat::BGRA8, 0, m_flags);
+		auto stagingTexture = bgfx::createTexture2D((uint16_t)m_width, (uint16_t)m_height, false, 1, m_format, 0, m_flags);
 		m_stagingTextures.push_back(stagingTexture);
 	}
 }
@@ -499,26 +693,185 @@ bgfx::TextureHandle PageTable::getTexture()
 }
 
 // PageLoader
-PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info)
+PageLoader::PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, int _numThreads)
 	: m_colorMipLevels(false)
 	, m_showBorders(false)
 	, m_tileDataFile(_tileDataFile)
 	, m_indexer(_indexer)
 	, m_info(_info)
+	, m_numThreads(0)
+	, m_exit(false)
+	, m_generation(0)
 {
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_numThreads = bx::clamp(_numThreads, 0, kMaxThreads);
+#else
+	BX_UNUSED(_numThreads);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	for (int i = 0; i < m_numThreads; ++i)
+	{
+		Worker& worker = m_worker[i];
+		worker.m_loader = this;
+		worker.m_completed = BX_NEW(VirtualTexture::getAllocator(), bx::SpScUnboundedQueueT<ReadState>)(VirtualTexture::getAllocator());
+		worker.m_thread.init(workerFunc, &worker, 0, "vt page loader");
+	}
 }
 
-void PageLoader::submit(Page request)
+PageLoader::~PageLoader()
 {
-	ReadState state;
-	state.m_page = request;
-	loadPage(state);
-	onPageLoadComplete(state);
+	m_exit = true;
+	m_sem.post(m_numThreads);
+
+	for (int i = 0; i < m_numThreads; ++i)
+	{
+		Worker& worker = m_worker[i];
+		worker.m_thread.shutdown();
+
+		while (ReadState* state = worker.m_completed->pop())
+		{
+			bx::deleteObject(VirtualTexture::getAllocator(), state);
+		}
+
+		bx::deleteObject(VirtualTexture::getAllocator(), worker.m_completed);
+	}
+
+	for (auto state : m_pending)
+	{
+		bx::deleteObject(VirtualTexture::getAllocator(), state);
+	}
+}
+
+void PageLoader::submit(Page request, int count)
+{
+	if (0 == m_numThreads)
+	{
+		ReadState* state = BX_NEW(VirtualTexture::getAllocator(), ReadState);
+		state->m_page = request;
+		state->m_generation = m_generation;
+		loadPage(*state);
+		m_pending.push_back(state);
+		return;
+	}
+
+	{
+		bx::MutexScope lock(m_mutex);
+		m_requests.push_back({ request, count, m_generation });
+	}
+
+	m_sem.post();
+}
+
+bool PageLoader::popRequest(ReadState& state)
+{
+	bx::MutexScope lock(m_mutex);
+
+	if (m_requests.empty())
+	{
+		return false;
+	}
+
+	// Pick the lowest resolution page, and the most requested one among them
+	uint32_t best = 0;
+	for (uint32_t i = 1; i < m_requests.size(); ++i)
+	{
+		const Request& lhs = m_requests[i];
+		const Request& rhs = m_requests[best];
+		if (lhs.m_page.m_mip > rhs.m_page.m_mip
+		|| (lhs.m_page.m_mip == rhs.m_page.m_mip && lhs.m_count > rhs.m_count))
+		{
+			best = i;
+		}
+	}
+
+	state.m_page = m_requests[best].m_page;
+	state.m_generation = m_requests[best].m_generation;
+
+	m_requests[best] = m_requests.back();
+	m_requests.pop_back();
+
+	return true;
+}
+
+int32_t PageLoader::workerFunc(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+
+	Worker& worker = *(Worker*)_userData;
+	PageLoader* loader = worker.m_loader;
+
+	for (;;)
+	{
+		loader->m_sem.wait();
+
+		if (loader->m_exit)
+		{
+			break;
+		}
+
+		ReadState* state = BX_NEW(VirtualTexture::getAllocator(), ReadState);
+
+		// Request might be dropped by clear in the meantime
+		if (!loader->popRequest(*state))
+		{
+			bx::deleteObject(VirtualTexture::getAllocator(), state);
+			continue;
+		}
+
+		loader->loadPage(*state);
+		worker.m_completed->push(state);
+	}
+
+	return 0;
+}
+
+void PageLoader::update(int maxPages)
+{
+	for (int i = 0; i < m_numThreads; ++i)
+	{
+		while (ReadState* state = m_worker[i].m_completed->pop())
+		{
+			m_pending.push_back(state);
+		}
+	}
+
+	uint32_t num = 0;
+	for (int uploaded = 0; num < m_pending.size() && uploaded < maxPages; ++num)
+	{
+		ReadState* state = m_pending[num];
+
+		// Pages requested before clear are dropped
+		if (state->m_generation == m_generation)
+		{
+			onPageLoadComplete(*state);
+			++uploaded;
+		}
+
+		bx::deleteObject(VirtualTexture::getAllocator(), state);
+	}
+
+	m_pending.erase(m_pending.begin(), m_pending.begin() + num);
+}
+
+void PageLoader::clear()
+{
+	{
+		bx::MutexScope lock(m_mutex);
+		m_requests.clear();
+	}
+
+	for (auto state : m_pending)
+	{
+		bx::deleteObject(VirtualTexture::getAllocator(), state);
+	}
+
+	m_pending.clear();
+	++m_generation;
 }
 
 void PageLoader::loadPage(ReadState& state)
 {
-	int size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	int size = m_info->GetPageDataSize();
 	state.m_data.resize(size);
 
 	if (m_colorMipLevels)
@@ -527,7 +880,12 @@ void PageLoader::loadPage(ReadState& state)
 	}
 	else if (m_tileDataFile != nullptr)
 	{
-		m_tileDataFile->readPage(m_indexer->getIndexFromPage(state.m_page), &state.m_data[0]);
+		uint32_t pageSize;
+		const uint8_t* page = m_tileDataFile->getPage(m_indexer->getIndexFromPage(state.m_page), &pageSize);
+		BX_ASSERT(int(pageSize) == size, "Invalid page size %d, expected %d.", pageSize, size);
+
+		// Copy here so mapped file is paged in on loader thread instead of main thread
+		bx::memCopy(&state.m_data[0], page, bx::min(int(pageSize), size) );
 	}
 
 	if (m_showBorders)
@@ -546,6 +904,23 @@ void PageLoader::copyBorder(uint8_t* image)
 	int pagesize = m_info->GetPageSize();
 	int bordersize = m_info->m_borderSize;
 
+	if (bgfx::TextureFormat::BC1 == m_info->m_pageFormat)
+	{
+		// Mark whole row and column of blocks that contain border
+		const float green[3] = { 0.0f, 255.0f, 0.0f };
+		const uint16_t color = packRgb565(green);
+		const int numBlocks = pagesize / 4;
+		const int border = bordersize / 4;
+
+		for (int i = 0; i < numBlocks; ++i)
+		{
+			storeBc1Block(&image[(border * numBlocks + i) * 8], color, color, 0);
+			storeBc1Block(&image[(i * numBlocks + border) * 8], color, color, 0);
+		}
+
+		return;
+	}
+
 	for (int i = 0; i < pagesize; ++i)
 	{
 		int xindex = bordersize * pagesize + i;
@@ -582,6 +957,25 @@ void PageLoader::copyColor(uint8_t* image, Page request)
 
 	int pagesize = m_info->GetPageSize();
 
+	if (bgfx::TextureFormat::BC1 == m_info->m_pageFormat)
+	{
+		const float rgb[3] =
+		{
+			float(colors[request.m_mip].m_r),
+			float(colors[request.m_mip].m_g),
+			float(colors[request.m_mip].m_b),
+		};
+		const uint16_t color = packRgb565(rgb);
+		const int numBlocks = (pagesize / 4) * (pagesize / 4);
+
+		for (int i = 0; i < numBlocks; ++i)
+		{
+			storeBc1Block(&image[i * 8], color, color, 0);
+		}
+
+		return;
+	}
+
 	for (int y = 0; y < pagesize; ++y)
 	{
 		for (int x = 0; x < pagesize; ++x)
@@ -629,7 +1023,7 @@ bool PageCache::touch(Page page)
 }
 
 // Schedule a load if not already loaded or loading
-bool PageCache::request(Page request, bgfx::ViewId blitViewId)
+bool PageCache::request(Page request, int count, bgfx::ViewId blitViewId)
 {
 	m_blitViewId = blitViewId;
 	if (m_loading.find(request) == m_loading.end())
@@ -637,7 +1031,7 @@ bool PageCache::request(Page request, bgfx::ViewId blitViewId)
 		if (m_lru_used.find(request) == m_lru_used.end())
 		{
 			m_loading.insert(request);
-			m_loader->submit(request);
+			m_loader->submit(request, count);
 			return true;
 		}
 	}
@@ -658,6 +1052,10 @@ void PageCache::clear()
 	m_lru.clear();
 	m_lru.reserve(m_count * m_count);
 	m_current = 0;
+
+	// Pages that are still loading were prepared with old settings
+	m_loading.clear();
+	m_loader->clear();
 }
 
 void PageCache::loadComplete(Page page, uint8_t* data)
@@ -700,7 +1098,7 @@ void PageCache::loadComplete(Page page, uint8_t* data)
 // TextureAtlas
 TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, int _count, int _uploadsperframe)
 	: m_info(_info)
-	, m_stagingPool(_info->GetPageSize(), _info->GetPageSize(), _uploadsperframe, false)
+	, m_stagingPool(_info->GetPageSize(), _info->GetPageSize(), _uploadsperframe, false, _info->m_pageFormat)
 {
 	// Create atlas texture
 	int pagesize = m_info->GetPageSize();
@@ -711,7 +1109,7 @@ TextureAtlas::TextureAtlas(VirtualTextureInfo* _info, int _count, int _uploadspe
 		, (uint16_t)size
 		, false
 		, 1
-		, bgfx::TextureFormat::BGRA8
+		, m_info->m_pageFormat
 		, 0
 		, BGFX_SAMPLER_UVW_CLAMP | BGFX_TEXTURE_BLIT_DST
 		);
@@ -743,7 +1141,7 @@ void TextureAtlas::uploadPage(Point pt, uint8_t* data, bgfx::ViewId blitViewId)
 		, 0
 		, pagesize
 		, pagesize
-		, bgfx::copy(data, pagesize * pagesize * s_channelCount)
+		, bgfx::copy(data, m_info->GetPageDataSize() )
 		);
 
 	// Copy the texture part to the actual atlas texture
@@ -878,7 +1276,7 @@ int FeedbackBuffer::getHeight() const
 }
 
 // VirtualTexture
-VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo* _info, int _atlassize, int _uploadsperframe, int _mipBias)
+VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo* _info, int _atlassize, int _uploadsperframe, int _mipBias, int _numLoaderThreads)
 	: m_tileDataFile(_tileDataFile)
 	, m_info(_info)
 	, m_uploadsPerFrame(_uploadsperframe)
@@ -893,7 +1291,7 @@ VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo*
 
 	// Setup classes
 	m_atlas = BX_NEW(VirtualTexture::getAllocator(), TextureAtlas)(m_info, m_atlasCount, m_uploadsPerFrame);
-	m_loader = BX_NEW(VirtualTexture::getAllocator(), PageLoader)(m_tileDataFile, m_indexer, m_info);
+	m_loader = BX_NEW(VirtualTexture::getAllocator(), PageLoader)(m_tileDataFile, m_indexer, m_info, _numLoaderThreads);
 	m_cache = BX_NEW(VirtualTexture::getAllocator(), PageCache)(m_atlas, m_loader, m_atlasCount);
 	m_pageTable = BX_NEW(VirtualTexture::getAllocator(), PageTable)(m_cache, m_info, m_indexer);
 
@@ -906,10 +1304,10 @@ VirtualTexture::VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo*
 
 VirtualTexture::~VirtualTexture()
 {
-	// Destroy
+	// Destroy, loader first since its threads use indexer
+	bx::deleteObject(VirtualTexture::getAllocator(), m_loader);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_indexer);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_atlas);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_loader);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_cache);
 	bx::deleteObject(VirtualTexture::getAllocator(), m_pageTable);
 	// Destroy all uniforms and textures
@@ -1065,9 +1463,16 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 		});
 
 		// if more pages than will fit in memory or more than update per frame drop high res pages with lowest use count
-		int loadcount = bx::min(bx::min((int)m_pagesToLoad.size(), m_uploadsPerFrame), m_atlasCount * m_atlasCount);
-		for (int i = 0; i < loadcount; ++i)
-			m_cache->request(m_pagesToLoad[i].m_page, blitViewId);
+		// pages that are still loading don't count, so the loader can work ahead
+		int loadcount = bx::min(m_uploadsPerFrame, m_atlasCount * m_atlasCount);
+		for (int i = 0; i < (int)m_pagesToLoad.size() && loadcount > 0; ++i)
+		{
+			const PageCount& pc = m_pagesToLoad[i];
+			if (m_cache->request(pc.m_page, pc.m_count, blitViewId))
+			{
+				--loadcount;
+			}
+		}
 	}
 	else
 	{
@@ -1076,6 +1481,9 @@ void VirtualTexture::update(const tinystl::vector<int>& requests, bgfx::ViewId b
 		--m_mipBias;
 	}
 
+	// Upload loaded pages, at most as many as there are staging textures
+	m_loader->update(m_uploadsPerFrame);
+
 	// Update the page table
 	m_pageTable->update(blitViewId);
 }
@@ -1092,61 +1500,251 @@ bx::AllocatorI* VirtualTexture::getAllocator()
 	return s_allocator;
 }
 
-TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite) : m_info(_info)
-{
-	const char* access = _readWrite ? "w+b" : "rb";
-	m_file = fopen(filename.getCPtr(), access);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+TileDataFile::TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info)
+	: m_info(_info)
+	, m_data(nullptr)
+	, m_size(0)
+	, m_offsets(nullptr)
+	, m_numPages(0)
+	, m_mapped(false)
+{
+#if BX_PLATFORM_WINDOWS
+	HANDLE file = CreateFileA(filename.getCPtr(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE != file)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size)
+		&&  0 < size.QuadPart)
+		{
+			HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (NULL != mapping)
+			{
+				m_data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				m_size = uint64_t(size.QuadPart);
+				m_mapped = nullptr != m_data;
+
+				// View keeps mapping alive
+				CloseHandle(mapping);
+			}
+		}
+
+		CloseHandle(file);
+	}
+#elif BX_PLATFORM_POSIX
+	int fd = open(filename.getCPtr(), O_RDONLY);
+	if (-1 != fd)
+	{
+		struct stat st;
+		if (0 == fstat(fd, &st)
+		&&  0 < st.st_size)
+		{
+			void* ptr = mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (MAP_FAILED != ptr)
+			{
+				m_data = (const uint8_t*)ptr;
+				m_size = uint64_t(st.st_size);
+				m_mapped = true;
+			}
+		}
+
+		// Mapping stays valid after file is closed
+		close(fd);
+	}
+#endif // BX_PLATFORM_*
+
+	if (!m_mapped)
+	{
+		// Fallback for platforms without memory mapped files, load whole file
+		bx::Error err;
+		bx::FileReader fileReader;
+
+		if (bx::open(&fileReader, filename, &err) )
+		{
+			m_size = uint64_t(bx::getSize(&fileReader) );
+
+			if (0 < m_size)
+			{
+				uint8_t* data = (uint8_t*)bx::alloc(VirtualTexture::getAllocator(), size_t(m_size) );
+				bx::read(&fileReader, data, int32_t(m_size), &err);
+				m_data = data;
+			}
+
+			bx::close(&fileReader);
+		}
+	}
 }
 
 TileDataFile::~TileDataFile()
 {
-	fclose(m_file);
-}
+	if (nullptr == m_data)
+	{
+		return;
+	}
 
-void TileDataFile::readInfo()
-{
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fread(m_info, sizeof(*m_info), 1, m_file);
-	BX_UNUSED(ret);
-	m_size = m_info->GetPageSize() * m_info->GetPageSize() * s_channelCount;
+	if (m_mapped)
+	{
+#if BX_PLATFORM_WINDOWS
+		UnmapViewOfFile(m_data);
+#elif BX_PLATFORM_POSIX
+		munmap(const_cast<uint8_t*>(m_data), size_t(m_size) );
+#endif // BX_PLATFORM_*
+	}
+	else
+	{
+		bx::free(VirtualTexture::getAllocator(), const_cast<uint8_t*>(m_data) );
+	}
 }
 
-void TileDataFile::writeInfo()
+bool TileDataFile::readInfo()
 {
-	fseek(m_file, 0, SEEK_SET);
-	auto ret = fwrite(m_info, sizeof(*m_info), 1, m_file);
-	BX_UNUSED(ret);
+	if (m_size < sizeof(TileDataHeader) )
+	{
+		return false;
+	}
+
+	TileDataHeader header;
+	bx::memCopy(&header, m_data, sizeof(header) );
+
+	if (s_tileFileMagic   != header.m_magic
+	||  s_tileFileVersion != header.m_version)
+	{
+		bx::debugPrintf("Tile data file version mismatch.\n");
+		return false;
+	}
+
+	if (uint32_t(bgfx::TextureFormat::BC1)   != header.m_pageFormat
+	&&  uint32_t(bgfx::TextureFormat::BGRA8) != header.m_pageFormat)
+	{
+		bx::debugPrintf("Tile data file page format %d is not supported.\n", header.m_pageFormat);
+		return false;
+	}
+
+	const uint64_t tableEnd = sizeof(TileDataHeader) + (uint64_t(header.m_numPages) + 1) * sizeof(uint64_t);
+	if (m_size < tableEnd)
+	{
+		return false;
+	}
+
+	m_offsets  = (const uint64_t*)&m_data[sizeof(TileDataHeader)];
+	m_numPages = header.m_numPages;
+
+	if (m_size < m_offsets[m_numPages])
+	{
+		bx::debugPrintf("Tile data file is truncated.\n");
+		return false;
+	}
+
+	m_info->m_virtualTextureSize = header.m_virtualTextureSize;
+	m_info->m_tileSize           = header.m_tileSize;
+	m_info->m_borderSize         = header.m_borderSize;
+	m_info->m_pageFormat         = bgfx::TextureFormat::Enum(header.m_pageFormat);
+	return true;
 }
 
-void TileDataFile::readPage(int index, uint8_t* data)
+const uint8_t* TileDataFile::getPage(int index, uint32_t* size) const
 {
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fread(data, m_size, 1, m_file);
-	BX_UNUSED(ret);
+	BX_ASSERT(uint32_t(index) < m_numPages, "Invalid page index %d (max %d).", index, m_numPages);
+
+	*size = uint32_t(m_offsets[index + 1] - m_offsets[index]);
+	return &m_data[m_offsets[index] ];
 }
 
-void TileDataFile::writePage(int index, uint8_t* data)
+bool TileDataFile::write(const bx::FilePath& filename, VirtualTextureInfo* _info, int numPages, const std::function<void(int, uint8_t*)>& readPage, WorkerPool* _pool)
 {
-	fseek(m_file, m_size * index + s_tileFileDataOffset, SEEK_SET);
-	auto ret = fwrite(data, m_size, 1, m_file);
-	BX_UNUSED(ret);
+	FILE* file = fopen(filename.getCPtr(), "wb");
+	if (nullptr == file)
+	{
+		return false;
+	}
+
+	const int pagesize = _info->GetPageSize();
+	_info->m_pageFormat = 0 == pagesize % 4
+		? bgfx::TextureFormat::BC1
+		: bgfx::TextureFormat::BGRA8
+		;
+
+	TileDataHeader header;
+	header.m_magic              = s_tileFileMagic;
+	header.m_version            = s_tileFileVersion;
+	header.m_virtualTextureSize = _info->m_virtualTextureSize;
+	header.m_tileSize           = _info->m_tileSize;
+	header.m_borderSize         = _info->m_borderSize;
+	header.m_pageFormat         = _info->m_pageFormat;
+	header.m_numPages           = uint32_t(numPages);
+	header.m_reserved           = 0;
+
+	bool ok = 1 == fwrite(&header, sizeof(header), 1, file);
+
+	// All pages have the same size for now, table allows variable size encodings
+	const uint32_t pageDataSize = uint32_t(_info->GetPageDataSize() );
+	uint64_t offset = sizeof(TileDataHeader) + (uint64_t(numPages) + 1) * sizeof(uint64_t);
+
+	for (int i = 0; i <= numPages && ok; ++i)
+	{
+		ok = 1 == fwrite(&offset, sizeof(offset), 1, file);
+		offset += pageDataSize;
+	}
+
+	// Pages are compressed in batches to keep memory use bounded
+	const int batchSize = 64;
+	const uint32_t rawPageSize = pagesize * pagesize * s_channelCount;
+
+	tinystl::vector<uint8_t> raw(batchSize * rawPageSize);
+	tinystl::vector<uint8_t> data(batchSize * pageDataSize);
+
+	CompressPageTask task;
+	task.m_src         = &raw[0];
+	task.m_dst         = &data[0];
+	task.m_srcPageSize = rawPageSize;
+	task.m_dstPageSize = pageDataSize;
+	task.m_pagesize    = pagesize;
+	task.m_format      = _info->m_pageFormat;
+
+	for (int first = 0; first < numPages && ok; first += batchSize)
+	{
+		const int num = bx::min(batchSize, numPages - first);
+
+		for (int i = 0; i < num; ++i)
+		{
+			readPage(first + i, &raw[i * rawPageSize]);
+		}
+
+		if (nullptr != _pool)
+		{
+			_pool->run(compressPageTask, &task, uint32_t(num) );
+		}
+		else
+		{
+			for (int i = 0; i < num; ++i)
+			{
+				compressPageTask(&task, uint32_t(i), uint32_t(num) );
+			}
+		}
+
+		ok = 1 == fwrite(&data[0], pageDataSize * num, 1, file);
+	}
+
+	fclose(file);
+	return ok;
 }
 
 // TileGenerator
-TileGenerator::TileGenerator(VirtualTextureInfo* _info)
+TileGenerator::TileGenerator(VirtualTextureInfo* _info, uint32_t _numThreads)
 	: m_info(_info)
 	, m_indexer(nullptr)
-	, m_tileDataFile(nullptr)
+	, m_scratchFile(nullptr)
 	, m_sourceImage(nullptr)
-	, m_page1Image(nullptr)
-	, m_page2Image(nullptr)
-	, m_2xtileImage(nullptr)
-	, m_4xtileImage(nullptr)
-	, m_tileImage(nullptr)
+	, m_workerPool(nullptr)
+	, m_nextPage(0)
 {
 	m_tilesize = m_info->m_tileSize;
 	m_pagesize = m_info->GetPageSize();
+
+	if (0 < _numThreads)
+	{
+		m_workerPool = BX_NEW(VirtualTexture::getAllocator(), WorkerPool);
+		m_workerPool->init(_numThreads, "vt tile generator");
+	}
 }
 
 TileGenerator::~TileGenerator()
@@ -1156,16 +1754,24 @@ TileGenerator::~TileGenerator()
 		bimg::imageFree(m_sourceImage);
 	}
 
+	if (m_scratchFile != nullptr)
+	{
+		fclose(m_scratchFile);
+	}
+
 	bx::deleteObject(VirtualTexture::getAllocator(), m_indexer);
+	bx::deleteObject(VirtualTexture::getAllocator(), m_workerPool);
 
-	bx::deleteObject(VirtualTexture::getAllocator(), m_page1Image);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_page2Image);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_2xtileImage);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_4xtileImage);
-	bx::deleteObject(VirtualTexture::getAllocator(), m_tileImage);
+	for (auto& scratch : m_scratch)
+	{
+		bx::deleteObject(VirtualTexture::getAllocator(), scratch.m_page1Image);
+		bx::deleteObject(VirtualTexture::getAllocator(), scratch.m_page2Image);
+		bx::deleteObject(VirtualTexture::getAllocator(), scratch.m_2xtileImage);
+		bx::deleteObject(VirtualTexture::getAllocator(), scratch.m_4xtileImage);
+	}
 }
 
-bool TileGenerator::generate(const bx::FilePath& _filePath)
+bool TileGenerator::generate(const bx::FilePath& _filePath, bool _force)
 {
 	const bx::StringView baseName = _filePath.getBaseName();
 
@@ -1176,15 +1782,16 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 	bx::FilePath cacheFilePath("temp");
 	cacheFilePath.join(tmp);
 
-	// Check if tile file already exist
+	// Check if tile file already exist, and was generated with the same settings
+	if (!_force)
 	{
-		bx::Error err;
-		bx::FileReader fileReader;
+		VirtualTextureInfo info;
+		TileDataFile tileDataFile(cacheFilePath, &info);
 
-		if (bx::open(&fileReader, cacheFilePath, &err) )
+		if (tileDataFile.readInfo()
+		&&  info.m_tileSize   == m_info->m_tileSize
+		&&  info.m_borderSize == m_info->m_borderSize)
 		{
-			bx::close(&fileReader);
-
 			bx::debugPrintf("Tile data file '%s' already exists. Skipping generation.\n", cacheFilePath.getCPtr() );
 			return true;
 		}
@@ -1237,45 +1844,128 @@ bool TileGenerator::generate(const bx::FilePath& _filePath)
 	m_info->m_virtualTextureSize = int(m_sourceImage->m_width);
 	m_indexer = BX_NEW(VirtualTexture::getAllocator(), PageIndexer)(m_info);
 
-	// Open tile data file
-	m_tileDataFile = BX_NEW(VirtualTexture::getAllocator(), TileDataFile)(cacheFilePath, m_info, true);
-	m_page1Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_page2Image   = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
-	m_tileImage    = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize, m_tilesize, s_channelCount, 0xff);
-	m_2xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 2, m_tilesize * 2, s_channelCount, 0xff);
-	m_4xtileImage  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 4, m_tilesize * 4, s_channelCount, 0xff);
+	// Open scratch file, raw pages are kept there while lower mips are generated
+	bx::snprintf(tmp, sizeof(tmp), "%.*s.vt.tmp", baseName.getLength(), baseName.getPtr() );
+
+	bx::FilePath scratchFilePath("temp");
+	scratchFilePath.join(tmp);
+
+	m_scratchFile = fopen(scratchFilePath.getCPtr(), "w+b");
+	if (nullptr == m_scratchFile)
+	{
+		bx::debugPrintf("Scratch file open failed '%s'.\n", scratchFilePath.getCPtr() );
+		return false;
+	}
+
+	// One set of scratch images per task
+	const uint32_t numTasks = nullptr != m_workerPool ? m_workerPool->getNumThreads() : 1;
+	m_scratch.resize(numTasks);
+
+	for (auto& scratch : m_scratch)
+	{
+		scratch.m_page1Image  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
+		scratch.m_page2Image  = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_pagesize, m_pagesize, s_channelCount, 0xff);
+		scratch.m_2xtileImage = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 2, m_tilesize * 2, s_channelCount, 0xff);
+		scratch.m_4xtileImage = BX_NEW(VirtualTexture::getAllocator(), SimpleImage)(m_tilesize * 4, m_tilesize * 4, s_channelCount, 0xff);
+	}
+
+	const double toMs = 1000.0 / double(bx::getHPFrequency() );
+	const int64_t start = bx::getHPCounter();
 
 	// Generate tiles
-	bx::debugPrintf("Generating tiles\n");
+	bx::debugPrintf("Generating tiles, %d threads\n", numTasks);
 	auto mipcount = m_indexer->getMipCount();
 	for (int i = 0; i < mipcount; ++i)
 	{
+		const int64_t mipStart = bx::getHPCounter();
 		int count = (m_info->m_virtualTextureSize / m_tilesize) >> i;
-		bx::debugPrintf("Generating Mip:%d Count:%dx%d\n", i, count, count);
-		for (int y = 0; y < count; ++y)
+
+		MipTask task = { this, i, count };
+		m_nextPage = 0;
+
+		if (nullptr != m_workerPool)
 		{
-			for (int x = 0; x < count; ++x)
-			{
-				Page page = { x, y, i };
-				int index = m_indexer->getIndexFromPage(page);
-				CopyTile(*m_page1Image, page);
-				m_tileDataFile->writePage(index, &m_page1Image->m_data[0]);
-			}
+			m_workerPool->run(generateTask, &task, numTasks);
+		}
+		else
+		{
+			generateTask(&task, 0, 1);
+		}
+
+		// Lower mips are generated from previous mip pages
+		if (0 == i)
+		{
+			bimg::imageFree(m_sourceImage);
+			m_sourceImage = nullptr;
 		}
+
+		bx::debugPrintf("Generating Mip:%d Count:%dx%d %.1f ms\n", i, count, count, double(bx::getHPCounter() - mipStart) * toMs);
+	}
+
+	const int64_t compressStart = bx::getHPCounter();
+	const bool ok = TileDataFile::write(cacheFilePath, m_info, m_indexer->getCount(), [&](int index, uint8_t* data) { readPage(index, data); }, m_workerPool);
+	const int64_t end = bx::getHPCounter();
+
+	bx::debugPrintf("Compressing %d pages %.1f ms\n", m_indexer->getCount(), double(end - compressStart) * toMs);
+	bx::debugPrintf("Tile generation %.1f ms\n", double(end - start) * toMs);
+
+	// Close and remove scratch file
+	fclose(m_scratchFile);
+	m_scratchFile = nullptr;
+	bx::remove(scratchFilePath);
+
+	if (!ok)
+	{
+		bx::debugPrintf("Tile data file write failed '%s'.\n", cacheFilePath.getCPtr() );
+		return false;
 	}
 
-	bx::debugPrintf("Finising\n");
-	// Write header
-	m_tileDataFile->writeInfo();
-	// Close tile file
-	bx::deleteObject(VirtualTexture::getAllocator(), m_tileDataFile);
-	m_tileDataFile = nullptr;
 	bx::debugPrintf("Done!\n");
 	return true;
 }
 
-void TileGenerator::CopyTile(SimpleImage& image, Page request)
+void TileGenerator::generateTask(void* _userData, uint32_t _idx, uint32_t /*_num*/)
+{
+	const MipTask& task = *(const MipTask*)_userData;
+	TileGenerator& generator = *task.m_generator;
+	TileScratch& scratch = generator.m_scratch[_idx];
+
+	const uint32_t numPages = uint32_t(task.m_count * task.m_count);
+
+	// Pages are handed out one at a time, so tasks finish at about the same time
+	for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&generator.m_nextPage, 1)
+		; idx < numPages
+		; idx = bx::atomicFetchAndAdd<uint32_t>(&generator.m_nextPage, 1)
+		)
+	{
+		Page page = { int(idx % task.m_count), int(idx / task.m_count), task.m_mip };
+		generator.CopyTile(scratch, page);
+		generator.writePage(generator.m_indexer->getIndexFromPage(page), &scratch.m_page1Image->m_data[0]);
+	}
+}
+
+void TileGenerator::readPage(int index, uint8_t* data)
+{
+	bx::MutexScope lock(m_mutex);
+	const int size = m_pagesize * m_pagesize * s_channelCount;
+	fseek(m_scratchFile, long(size) * index, SEEK_SET);
+	auto ret = fread(data, size, 1, m_scratchFile);
+	BX_UNUSED(ret);
+}
+
+void TileGenerator::writePage(int index, uint8_t* data)
 {
+	bx::MutexScope lock(m_mutex);
+	const int size = m_pagesize * m_pagesize * s_channelCount;
+	fseek(m_scratchFile, long(size) * index, SEEK_SET);
+	auto ret = fwrite(data, size, 1, m_scratchFile);
+	BX_UNUSED(ret);
+}
+
+void TileGenerator::CopyTile(TileScratch& scratch, Page request)
+{
+	SimpleImage& image = *scratch.m_page1Image;
+
 	if (request.m_mip == 0)
 	{
 		int x = request.m_x * m_tilesize - m_info->m_borderSize;
@@ -1303,7 +1993,7 @@ void TileGenerator::CopyTile(SimpleImage& image, Page request)
 
 		int size = m_info->GetPageTableSize() >> mip;
 
-		m_4xtileImage->clear((uint8_t)request.m_mip);
+		scratch.m_4xtileImage->clear((uint8_t)request.m_mip);
 
 		for (int y = 0; y < 4; ++y)
 		{
@@ -1315,19 +2005,19 @@ void TileGenerator::CopyTile(SimpleImage& image, Page request)
 				page.m_x = (int)bx::mod((float)page.m_x, (float)size);
 				page.m_y = (int)bx::mod((float)page.m_y, (float)size);
 
-				m_tileDataFile->readPage(m_indexer->getIndexFromPage(page), &m_page2Image->m_data[0]);
+				readPage(m_indexer->getIndexFromPage(page), &scratch.m_page2Image->m_data[0]);
 
 				Rect src_rect = { m_info->m_borderSize, m_info->m_borderSize, m_tilesize, m_tilesize };
 				Point dst_offset = { x * m_tilesize, y * m_tilesize };
 
-				m_4xtileImage->copy(dst_offset, *m_page2Image, src_rect);
+				scratch.m_4xtileImage->copy(dst_offset, *scratch.m_page2Image, src_rect);
 			}
 		}
 
-		SimpleImage::mipmap(&m_4xtileImage->m_data[0], m_4xtileImage->m_width, s_channelCount, &m_2xtileImage->m_data[0]);
+		SimpleImage::mipmap(&scratch.m_4xtileImage->m_data[0], scratch.m_4xtileImage->m_width, s_channelCount, &scratch.m_2xtileImage->m_data[0]);
 
 		Rect srect = { m_tilesize / 2 - m_info->m_borderSize, m_tilesize / 2 - m_info->m_borderSize, m_pagesize, m_pagesize };
-		image.copy({ 0,0 }, *m_2xtileImage, srect);
+		image.copy({ 0,0 }, *scratch.m_2xtileImage, srect);
 	}
 }
 
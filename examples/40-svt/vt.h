@@ -16,6 +16,10 @@
 #pragma once
 
 #include <bimg/decode.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/spscqueue.h>
+#include <bx/thread.h>
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_set.h>
 #include <tinystl/vector.h>
@@ -26,6 +30,8 @@
 
 #include <stdio.h> // FILE
 
+class WorkerPool;
+
 namespace vt
 {
 
@@ -104,17 +110,19 @@ struct VirtualTextureInfo
 	VirtualTextureInfo();
 	int GetPageSize() const;
 	int GetPageTableSize() const;
+	int GetPageDataSize() const;
 
 	int m_virtualTextureSize = 0;
 	int m_tileSize = 0;
 	int m_borderSize = 0;
+	bgfx::TextureFormat::Enum m_pageFormat = bgfx::TextureFormat::BGRA8;
 };
 
 // StagingPool
 class StagingPool
 {
 public:
-	StagingPool(int _width, int _height, int _count, bool _readBack);
+	StagingPool(int _width, int _height, int _count, bool _readBack, bgfx::TextureFormat::Enum _format = bgfx::TextureFormat::BGRA8);
 	~StagingPool();
 
 	void grow(int count);
@@ -129,6 +137,7 @@ private:
 	int			m_width;
 	int			m_height;
 	uint64_t	m_flags;
+	bgfx::TextureFormat::Enum m_format;
 };
 
 // PageIndexer
@@ -215,17 +224,29 @@ private:
 };
 
 // PageLoader
+// Pages are read and prepared on worker threads, loaded pages are handed back
+// to loadComplete on main thread by update.
 class PageLoader
 {
 public:
+	static constexpr int kMaxThreads = 8;
+
 	struct ReadState
 	{
 		Page						m_page;
+		uint32_t					m_generation;
 		tinystl::vector<uint8_t>	m_data;
 	};
 
-	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info);
-	void submit(Page request);
+	PageLoader(TileDataFile* _tileDataFile, PageIndexer* _indexer, VirtualTextureInfo* _info, int _numThreads);
+	~PageLoader();
+
+	// Queue page for loading, low resolution and most requested pages are loaded first
+	void submit(Page request, int count);
+	// Call loadComplete for at most maxPages loaded pages
+	void update(int maxPages);
+	// Drop queued requests and pages that are being loaded
+	void clear();
 	void loadPage(ReadState& state);
 	void onPageLoadComplete(ReadState& state);
 	void copyBorder(uint8_t* image);
@@ -237,9 +258,40 @@ public:
 	bool m_showBorders;
 
 private:
+	struct Request
+	{
+		Page		m_page;
+		int			m_count;
+		uint32_t	m_generation;
+	};
+
+	struct Worker
+	{
+		PageLoader*							m_loader;
+		bx::SpScUnboundedQueueT<ReadState>*	m_completed;
+		bx::Thread							m_thread;
+	};
+
+	static int32_t workerFunc(bx::Thread* _thread, void* _userData);
+	bool popRequest(ReadState& state);
+
 	TileDataFile*		m_tileDataFile;
 	PageIndexer*        m_indexer;
 	VirtualTextureInfo* m_info;
+
+	Worker		m_worker[kMaxThreads];
+	int			m_numThreads;
+	bool		m_exit;
+
+	bx::Mutex		m_mutex;
+	bx::Semaphore	m_sem;
+
+	// Guarded by m_mutex
+	tinystl::vector<Request> m_requests;
+
+	// Main thread only
+	tinystl::vector<ReadState*> m_pending;
+	uint32_t m_generation;
 };
 
 // PageCache
@@ -248,7 +300,7 @@ class PageCache
 public:
 	PageCache(TextureAtlas* _atlas, PageLoader* _loader, int _count);
 	bool touch(Page page);
-	bool request(Page request, bgfx::ViewId blitViewId);
+	bool request(Page request, int count, bgfx::ViewId blitViewId);
 	void clear();
 	void loadComplete(Page page, uint8_t* data);
 
@@ -342,7 +394,7 @@ private:
 class VirtualTexture
 {
 public:
-	VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo* _info, int _atlassize, int _uploadsperframe, int _mipBias = 4);
+	VirtualTexture(TileDataFile* _tileDataFile, VirtualTextureInfo* _info, int _atlassize, int _uploadsperframe, int _mipBias = 4, int _numLoaderThreads = 2);
 	~VirtualTexture();
 
 	int  getMipBias() const;
@@ -393,51 +445,85 @@ private:
 };
 
 // TileDataFile
+// Version 2 layout is header, page offset table with page count + 1 entries,
+// and page data. Pages are BC1 compressed when page size is multiple of 4,
+// otherwise they are stored as BGRA8. File is memory mapped and read-only.
 class TileDataFile
 {
 public:
-	TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info, bool _readWrite = false);
+	TileDataFile(const bx::FilePath& filename, VirtualTextureInfo* _info);
 	~TileDataFile();
 
-	void readInfo();
-	void writeInfo();
+	// Returns false if file is missing or not a version 2 tile data file
+	bool readInfo();
 
-	void readPage(int index, uint8_t* data);
-	void writePage(int index, uint8_t* data);
+	// Returns pointer to page data in mapped file, can be called from multiple threads
+	const uint8_t* getPage(int index, uint32_t* size) const;
+
+	// Writes tile data file from raw BGRA8 pages returned by readPage, pages are
+	// compressed in batches on worker pool when provided
+	static bool write(const bx::FilePath& filename, VirtualTextureInfo* _info, int numPages, const std::function<void(int, uint8_t*)>& readPage, WorkerPool* _pool = nullptr);
 
 private:
 	VirtualTextureInfo*	m_info;
-	int					m_size;
-	FILE*				m_file;
+	const uint8_t*		m_data;
+	uint64_t			m_size;
+	const uint64_t*		m_offsets;
+	uint32_t			m_numPages;
+	bool				m_mapped;
 };
 
 // TileGenerator
+// Pages of one mip level are generated in parallel, each task has its own
+// scratch images. Source image is released after mip 0, lower mips are built
+// from pages in scratch file, so memory use doesn't depend on mip count.
 class TileGenerator
 {
 public:
-	TileGenerator(VirtualTextureInfo* _info);
+	TileGenerator(VirtualTextureInfo* _info, uint32_t _numThreads = 0);
 	~TileGenerator();
 
-	bool generate(const bx::FilePath& filename);
+	// Generation time is reported per mip level, force regenerates existing tile data file
+	bool generate(const bx::FilePath& filename, bool _force = false);
 
 private:
-	void CopyTile(SimpleImage& image, Page request);
+	struct TileScratch
+	{
+		SimpleImage* m_page1Image;
+		SimpleImage* m_page2Image;
+		SimpleImage* m_2xtileImage;
+		SimpleImage* m_4xtileImage;
+	};
+
+	struct MipTask
+	{
+		TileGenerator*	m_generator;
+		int				m_mip;
+		int				m_count;
+	};
+
+	static void generateTask(void* _userData, uint32_t _idx, uint32_t _num);
+
+	void CopyTile(TileScratch& scratch, Page request);
+
+	// Scratch file reads and writes are serialized, they can be called from multiple threads
+	void readPage(int index, uint8_t* data);
+	void writePage(int index, uint8_t* data);
 
 private:
 	VirtualTextureInfo* m_info;
 	PageIndexer*		m_indexer;
-	TileDataFile*		m_tileDataFile;
+	FILE*				m_scratchFile;
+	bx::Mutex			m_mutex;
 
 	int	m_tilesize;
 	int	m_pagesize;
 
 	bimg::ImageContainer*	m_sourceImage;
 
-	SimpleImage* m_page1Image;
-	SimpleImage* m_page2Image;
-	SimpleImage* m_2xtileImage;
-	SimpleImage* m_4xtileImage;
-	SimpleImage* m_tileImage;
+	WorkerPool*						m_workerPool;
+	tinystl::vector<TileScratch>	m_scratch;
+	uint32_t						m_nextPage;
 };
 
 } // namespace vt
@@ -91,6 +91,140 @@ public:
 		return mem;
 	}
 
+	static uint32_t weldVerticesRef(uint32_t* _output, const bgfx::VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon)
+	{
+		// Brute force O(n^2) vertex welding, used as reference for bgfx::weldVertices.
+		const float epsilonSq = _epsilon*_epsilon;
+
+		uint32_t numVertices = 0;
+		bx::memSet(_output, 0xff, _num*sizeof(uint32_t) );
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			if (UINT32_MAX != _output[ii])
+			{
+				continue;
+			}
+
+			_output[ii] = ii;
+			++numVertices;
+
+			float pos[4];
+			bgfx::vertexUnpack(pos, bgfx::Attrib::Position, _layout, _data, ii);
+
+			for (uint32_t jj = ii+1; jj < _num; ++jj)
+			{
+				if (UINT32_MAX != _output[jj])
+				{
+					continue;
+				}
+
+				float test[4];
+				bgfx::vertexUnpack(test, bgfx::Attrib::Position, _layout, _data, jj);
+
+				const bx::Vec3 diff = bx::sub(bx::load<bx::Vec3>(test), bx::load<bx::Vec3>(pos) );
+				if (bx::dot(diff, diff) < epsilonSq)
+				{
+					_output[jj] = ii;
+				}
+			}
+		}
+
+		return numVertices;
+	}
+
+	void benchmarkWeld()
+	{
+		uint32_t* weld = (uint32_t*)bx::alloc(entry::getAllocator(), m_weldNum * sizeof(uint32_t) );
+
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+		int64_t elapsed = -bx::getHPCounter();
+		m_weldBench.m_numVertices = bgfx::weldVertices(weld, m_weldLayout, m_weldData, m_weldNum, true, kWeldEpsilon);
+		elapsed += bx::getHPCounter();
+		m_weldBench.m_time = float(double(elapsed)*toMs);
+
+		if (m_weldBench.m_reference)
+		{
+			uint32_t* ref = (uint32_t*)bx::alloc(entry::getAllocator(), m_weldNum * sizeof(uint32_t) );
+
+			int64_t refElapsed = -bx::getHPCounter();
+			m_weldBench.m_numVerticesRef = weldVerticesRef(ref, m_weldLayout, m_weldData, m_weldNum, kWeldEpsilon);
+			refElapsed += bx::getHPCounter();
+			m_weldBench.m_timeRef = float(double(refElapsed)*toMs);
+
+			m_weldBench.m_numDiff = 0;
+			for (uint32_t ii = 0; ii < m_weldNum; ++ii)
+			{
+				m_weldBench.m_numDiff += ref[ii] != weld[ii];
+			}
+
+			bx::free(entry::getAllocator(), ref);
+		}
+
+		bx::free(entry::getAllocator(), weld);
+	}
+
+	void benchmarkConvert()
+	{
+		bgfx::VertexLayout layout;
+		layout.begin();
+		for (uint32_t ii = 0; ii < bgfx::Attrib::Count; ++ii)
+		{
+			const bgfx::Attrib::Enum attr = bgfx::Attrib::Enum(ii);
+			if (m_weldLayout.has(attr) )
+			{
+				switch (attr)
+				{
+				case bgfx::Attrib::Position:  layout.add(attr, 3, bgfx::AttribType::Half);               break;
+				case bgfx::Attrib::TexCoord0: layout.add(attr, 2, bgfx::AttribType::Int16, true, true);  break;
+				default:                      layout.add(attr, 4, bgfx::AttribType::Uint8, true, true);  break;
+				}
+			}
+		}
+		layout.end();
+
+		const uint32_t size = layout.getSize(m_weldNum);
+		uint8_t* data = (uint8_t*)bx::alloc(entry::getAllocator(), size);
+		uint8_t* ref  = (uint8_t*)bx::alloc(entry::getAllocator(), size);
+		bx::memSet(data, 0, size);
+		bx::memSet(ref,  0, size);
+
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+		int64_t elapsed = -bx::getHPCounter();
+		bgfx::vertexConvert(layout, data, m_weldLayout, m_weldData, m_weldNum);
+		elapsed += bx::getHPCounter();
+		m_convertBench.m_time = float(double(elapsed)*toMs);
+
+		// Per-vertex unpack/pack, equivalent to vertexConvert before block kernels.
+		int64_t refElapsed = -bx::getHPCounter();
+		for (uint32_t ii = 0; ii < m_weldNum; ++ii)
+		{
+			for (uint32_t jj = 0; jj < bgfx::Attrib::Count; ++jj)
+			{
+				const bgfx::Attrib::Enum attr = bgfx::Attrib::Enum(jj);
+				if (layout.has(attr) )
+				{
+					float unpacked[4];
+					bgfx::vertexUnpack(unpacked, attr, m_weldLayout, m_weldData, ii);
+					bgfx::vertexPack(unpacked, true, attr, layout, ref, ii);
+				}
+			}
+		}
+		refElapsed += bx::getHPCounter();
+		m_convertBench.m_timeRef = float(double(refElapsed)*toMs);
+
+		m_convertBench.m_numDiff = 0;
+		for (uint32_t ii = 0; ii < size; ++ii)
+		{
+			m_convertBench.m_numDiff += ref[ii] != data[ii];
+		}
+
+		bx::free(entry::getAllocator(), ref);
+		bx::free(entry::getAllocator(), data);
+	}
+
 	void loadMesh(Mesh* _mesh)
 	{
 		// merge sub mesh
@@ -150,7 +284,7 @@ public:
 			bx::free(entry::getAllocator(), m_cacheWeld);
 			m_cacheWeld = (uint32_t*)bx::alloc(entry::getAllocator(), numVertices * sizeof(uint32_t) );
 
-			m_totalVertices	= bgfx::weldVertices(m_cacheWeld, _mesh->m_layout, vbData, numVertices, true, 0.00001f);
+			m_totalVertices	= bgfx::weldVertices(m_cacheWeld, _mesh->m_layout, vbData, numVertices, true, kWeldEpsilon);
 			remapIndices(m_cacheWeld, numVertices);
 		}
 
@@ -161,7 +295,11 @@ public:
 			, numVertices
 			, m_totalVertices
 			);
-		bx::free(entry::getAllocator(), vbData);
+
+		// Unwelded vertices are kept for weld benchmark.
+		m_weldData   = vbData;
+		m_weldNum    = numVertices;
+		m_weldLayout = _mesh->m_layout;
 
 		{
 			uint32_t* ibData = (uint32_t*)ib->data;
@@ -190,6 +328,7 @@ public:
 	}
 
 	const bx::FilePath kCacheFilePath = bx::FilePath("temp/bunnylod.cache");
+	const float kWeldEpsilon = 0.00001f;
 
 	void loadCache()
 	{
@@ -290,6 +429,10 @@ public:
 		loadMesh(mesh);
 		meshUnload(mesh);
 
+		bx::memSet(&m_weldBench, 0, sizeof(m_weldBench) );
+		bx::memSet(&m_convertBench, 0, sizeof(m_convertBench) );
+		m_convertBench.m_time = -1.0f;
+
 		m_timeOffset = bx::getHPCounter();
 		m_LOD = 1.0f;
 		m_lastLOD = m_LOD;
@@ -311,6 +454,7 @@ public:
 		bx::free(entry::getAllocator(), m_triangle);
 		bx::free(entry::getAllocator(), m_cacheWeld);
 		bx::free(entry::getAllocator(), m_cachePermutation);
+		bx::free(entry::getAllocator(), m_weldData);
 
 		// Shutdown bgfx.
 		bgfx::shutdown();
@@ -416,6 +560,44 @@ public:
 
 			ImGui::SliderFloat("LOD Level", &m_LOD, 0.05f, 1.0f);
 
+			ImGui::Separator();
+
+			ImGui::Checkbox("Compare with reference", &m_weldBench.m_reference);
+			if (ImGui::IsItemHovered() )
+			{
+				ImGui::SetTooltip("Brute force reference is O(n^2), it can take a while.");
+			}
+
+			if (ImGui::Button("Benchmark weld") )
+			{
+				benchmarkWeld();
+			}
+
+			if (0 != m_weldBench.m_numVertices)
+			{
+				ImGui::Text("Weld: %d -> %d, %.3f ms", m_weldNum, m_weldBench.m_numVertices, m_weldBench.m_time);
+			}
+
+			if (0 != m_weldBench.m_numVerticesRef)
+			{
+				ImGui::Text("Reference: %d, %.3f ms", m_weldBench.m_numVerticesRef, m_weldBench.m_timeRef);
+				ImGui::Text("Indices differ: %d", m_weldBench.m_numDiff);
+			}
+
+			ImGui::Separator();
+
+			if (ImGui::Button("Benchmark convert") )
+			{
+				benchmarkConvert();
+			}
+
+			if (0.0f <= m_convertBench.m_time)
+			{
+				ImGui::Text("vertexConvert: %.3f ms", m_convertBench.m_time);
+				ImGui::Text("Unpack/pack: %.3f ms", m_convertBench.m_timeRef);
+				ImGui::Text("Bytes differ: %d", m_convertBench.m_numDiff);
+			}
+
 			ImGui::End();
 
 			imguiEndFrame();
@@ -485,6 +667,31 @@ public:
 	uint32_t* m_cacheWeld;
 	uint32_t* m_cachePermutation;
 
+	uint8_t* m_weldData;
+	uint32_t m_weldNum;
+	bgfx::VertexLayout m_weldLayout;
+
+	struct WeldBenchmark
+	{
+		float    m_time;
+		float    m_timeRef;
+		uint32_t m_numVertices;
+		uint32_t m_numVerticesRef;
+		uint32_t m_numDiff;
+		bool     m_reference;
+	};
+
+	WeldBenchmark m_weldBench;
+
+	struct ConvertBenchmark
+	{
+		float    m_time;
+		float    m_timeRef;
+		uint32_t m_numDiff;
+	};
+
+	ConvertBenchmark m_convertBench;
+
 	int64_t m_timeOffset;
 	bgfx::VertexBufferHandle m_vb;
 	bgfx::DynamicIndexBufferHandle m_ib;
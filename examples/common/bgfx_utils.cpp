@@ -15,6 +15,8 @@ namespace stl = tinystl;
 #include <bx/endian.h>
 #include <bx/math.h>
 #include <bx/readerwriter.h>
+#include <bx/simd_t.h>
+#include <bx/sort.h>
 #include <bx/string.h>
 #include "entry/entry.h"
 #include <meshoptimizer/src/meshoptimizer.h>
@@ -368,6 +370,10 @@ void Group::reset()
 {
 	m_vbh.idx = bgfx::kInvalidHandle;
 	m_ibh.idx = bgfx::kInvalidHandle;
+	m_dvbh.idx = bgfx::kInvalidHandle;
+	m_dibh.idx = bgfx::kInvalidHandle;
+	m_startVertex = 0;
+	m_startIndex = 0;
 	m_numVertices = 0;
 	m_vertices = NULL;
 	m_numIndices = 0;
@@ -375,12 +381,75 @@ void Group::reset()
 	m_prims.clear();
 }
 
+struct MeshPool
+{
+	bgfx::VertexLayout m_layout;
+	bgfx::DynamicVertexBufferHandle m_dvbh;
+	bgfx::DynamicIndexBufferHandle  m_dibh;
+	uint32_t m_maxVertices;
+	uint32_t m_maxIndices;
+	uint32_t m_numVertices;
+	uint32_t m_numIndices;
+};
+
+static void createGroupVertexBuffer(Group& _group, const bgfx::Memory* _mem, const bgfx::VertexLayout& _layout, MeshPool* _pool)
+{
+	if (NULL != _pool
+	&&  _pool->m_layout.m_hash == _layout.m_hash
+	&&  _pool->m_numVertices + _group.m_numVertices <= _pool->m_maxVertices)
+	{
+		_group.m_dvbh        = _pool->m_dvbh;
+		_group.m_startVertex = _pool->m_numVertices;
+		bgfx::update(_pool->m_dvbh, _pool->m_numVertices, _mem);
+		_pool->m_numVertices += _group.m_numVertices;
+		return;
+	}
+
+	_group.m_vbh = bgfx::createVertexBuffer(_mem, _layout);
+}
+
+static void createGroupIndexBuffer(Group& _group, const bgfx::Memory* _mem, MeshPool* _pool)
+{
+	if (NULL != _pool
+	&&  _pool->m_numIndices + _group.m_numIndices <= _pool->m_maxIndices)
+	{
+		_group.m_dibh       = _pool->m_dibh;
+		_group.m_startIndex = _pool->m_numIndices;
+		bgfx::update(_pool->m_dibh, _pool->m_numIndices, _mem);
+		_pool->m_numIndices += _group.m_numIndices;
+		return;
+	}
+
+	_group.m_ibh = bgfx::createIndexBuffer(_mem);
+}
+
+static void setGroupBuffers(const Group& _group)
+{
+	if (bgfx::isValid(_group.m_dibh) )
+	{
+		bgfx::setIndexBuffer(_group.m_dibh, _group.m_startIndex, _group.m_numIndices);
+	}
+	else
+	{
+		bgfx::setIndexBuffer(_group.m_ibh);
+	}
+
+	if (bgfx::isValid(_group.m_dvbh) )
+	{
+		bgfx::setVertexBuffer(0, _group.m_dvbh, _group.m_startVertex, _group.m_numVertices);
+	}
+	else
+	{
+		bgfx::setVertexBuffer(0, _group.m_vbh);
+	}
+}
+
 namespace bgfx
 {
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err);
 }
 
-void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
+void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy, MeshPool* _pool)
 {
 	constexpr uint32_t kChunkVertexBuffer           = BX_MAKEFOURCC('V', 'B', ' ', 0x1);
 	constexpr uint32_t kChunkVertexBufferCompressed = BX_MAKEFOURCC('V', 'B', 'C', 0x0);
@@ -422,7 +491,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 					bx::memCopy(group.m_vertices, mem->data, mem->size);
 				}
 
-				group.m_vbh = bgfx::createVertexBuffer(mem, m_layout);
+				createGroupVertexBuffer(group, mem, m_layout, _pool);
 			}
 				break;
 
@@ -456,7 +525,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 					bx::memCopy(group.m_vertices, mem->data, mem->size);
 				}
 
-				group.m_vbh = bgfx::createVertexBuffer(mem, m_layout);
+				createGroupVertexBuffer(group, mem, m_layout, _pool);
 			}
 				break;
 
@@ -473,7 +542,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 					bx::memCopy(group.m_indices, mem->data, mem->size);
 				}
 
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+				createGroupIndexBuffer(group, mem, _pool);
 			}
 				break;
 
@@ -500,7 +569,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 					bx::memCopy(group.m_indices, mem->data, mem->size);
 				}
 
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+				createGroupIndexBuffer(group, mem, _pool);
 			}
 				break;
 
@@ -555,7 +624,11 @@ void Mesh::unload()
 	for (GroupArray::const_iterator it = m_groups.begin(), itEnd = m_groups.end(); it != itEnd; ++it)
 	{
 		const Group& group = *it;
-		bgfx::destroy(group.m_vbh);
+
+		if (bgfx::isValid(group.m_vbh) )
+		{
+			bgfx::destroy(group.m_vbh);
+		}
 
 		if (bgfx::isValid(group.m_ibh) )
 		{
@@ -596,8 +669,7 @@ void Mesh::submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _
 	{
 		const Group& group = *it;
 
-		bgfx::setIndexBuffer(group.m_ibh);
-		bgfx::setVertexBuffer(0, group.m_vbh);
+		setGroupBuffers(group);
 		bgfx::submit(
 			  _id
 			, _program
@@ -636,8 +708,7 @@ void Mesh::submit(const MeshState*const* _state, uint8_t _numPasses, const float
 		{
 			const Group& group = *it;
 
-			bgfx::setIndexBuffer(group.m_ibh);
-			bgfx::setVertexBuffer(0, group.m_vbh);
+			setGroupBuffers(group);
 			bgfx::submit(
 				  state.m_viewId
 				, state.m_program
@@ -657,19 +728,24 @@ void Mesh::submit(const MeshState*const* _state, uint8_t _numPasses, const float
 	bgfx::discard();
 }
 
-Mesh* meshLoad(bx::ReaderSeekerI* _reader, bool _ramcopy)
+Mesh* meshLoad(bx::ReaderSeekerI* _reader, bool _ramcopy, MeshPool* _pool)
 {
 	Mesh* mesh = new Mesh;
-	mesh->load(_reader, _ramcopy);
+	mesh->load(_reader, _ramcopy, _pool);
 	return mesh;
 }
 
 Mesh* meshLoad(const bx::FilePath& _filePath, bool _ramcopy)
+{
+	return meshLoad(_filePath, NULL, _ramcopy);
+}
+
+Mesh* meshLoad(const bx::FilePath& _filePath, MeshPool* _pool, bool _ramcopy)
 {
 	bx::FileReaderI* reader = entry::getFileReader();
 	if (bx::open(reader, _filePath) )
 	{
-		Mesh* mesh = meshLoad(reader, _ramcopy);
+		Mesh* mesh = meshLoad(reader, _ramcopy, _pool);
 		bx::close(reader);
 		return mesh;
 	}
@@ -704,6 +780,205 @@ void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPa
 	_mesh->submit(_state, _numPasses, _mtx, _numMatrices);
 }
 
+MeshPool* meshPoolCreate(const bgfx::VertexLayout& _layout, uint32_t _maxVertices, uint32_t _maxIndices)
+{
+	MeshPool* pool = new MeshPool;
+	pool->m_layout      = _layout;
+	pool->m_dvbh        = bgfx::createDynamicVertexBuffer(_maxVertices, _layout);
+	pool->m_dibh        = bgfx::createDynamicIndexBuffer(_maxIndices);
+	pool->m_maxVertices = _maxVertices;
+	pool->m_maxIndices  = _maxIndices;
+	pool->m_numVertices = 0;
+	pool->m_numIndices  = 0;
+	return pool;
+}
+
+void meshPoolDestroy(MeshPool* _pool)
+{
+	bgfx::destroy(_pool->m_dvbh);
+	bgfx::destroy(_pool->m_dibh);
+	delete _pool;
+}
+
+uint32_t meshSubmitCulled(const MeshInstance* _instances, uint32_t _num, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _viewProj, uint64_t _state)
+{
+	if (BGFX_STATE_MASK == _state)
+	{
+		_state = 0
+			| BGFX_STATE_WRITE_RGB
+			| BGFX_STATE_WRITE_A
+			| BGFX_STATE_WRITE_Z
+			| BGFX_STATE_DEPTH_TEST_LESS
+			| BGFX_STATE_CULL_CCW
+			| BGFX_STATE_MSAA
+			;
+	}
+
+	uint32_t numGroups = 0;
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		numGroups += uint32_t(_instances[ii].m_mesh->m_groups.size() );
+	}
+
+	if (0 == numGroups)
+	{
+		return 0;
+	}
+
+	// Bounding spheres are stored as structure of arrays, padded to multiple of 4.
+	const uint32_t numAligned = bx::alignUp(numGroups, 4);
+
+	bx::AllocatorI* allocator = entry::getAllocator();
+	uint8_t* data = (uint8_t*)bx::alignedAlloc(
+		  allocator
+		, numAligned*(sizeof(const Group*) + 4*sizeof(float) + 5*sizeof(uint32_t) ) + _num*sizeof(uint32_t)
+		, 16
+		);
+
+	const Group** groups = (const Group**)data;
+	float* posX = (float*)&groups[numAligned];
+	float* posY = &posX[numAligned];
+	float* posZ = &posY[numAligned];
+	float* radius = &posZ[numAligned];
+	uint32_t* instance   = (uint32_t*)&radius[numAligned];
+	uint32_t* keys       = &instance[numAligned];
+	uint32_t* tempKeys   = &keys[numAligned];
+	uint32_t* values     = &tempKeys[numAligned];
+	uint32_t* tempValues = &values[numAligned];
+	uint32_t* cache      = &tempValues[numAligned];
+
+	// Transform group bounding spheres to world space.
+	uint32_t idx = 0;
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		const MeshInstance& inst = _instances[ii];
+		const float* mtx = inst.m_mtx;
+
+		const float scale = bx::sqrt(bx::max(
+			  bx::lengthSq(bx::Vec3(mtx[0], mtx[1], mtx[ 2]) )
+			, bx::lengthSq(bx::Vec3(mtx[4], mtx[5], mtx[ 6]) )
+			, bx::lengthSq(bx::Vec3(mtx[8], mtx[9], mtx[10]) )
+			) );
+
+		for (GroupArray::const_iterator it = inst.m_mesh->m_groups.begin(), itEnd = inst.m_mesh->m_groups.end(); it != itEnd; ++it, ++idx)
+		{
+			const Group& group = *it;
+			const bx::Vec3 center = bx::mul(group.m_sphere.center, mtx);
+
+			groups[idx]   = &group;
+			instance[idx] = ii;
+			posX[idx]     = center.x;
+			posY[idx]     = center.y;
+			posZ[idx]     = center.z;
+			radius[idx]   = group.m_sphere.radius*scale;
+		}
+	}
+
+	// Padding is never visible.
+	for (; idx < numAligned; ++idx)
+	{
+		posX[idx]   = 0.0f;
+		posY[idx]   = 0.0f;
+		posZ[idx]   = 0.0f;
+		radius[idx] = -bx::kFloatLargest;
+	}
+
+	// Frustum planes in world space, point is inside when dot(normal, pos) + dist >= 0. Near
+	// plane uses -w <= z, which is conservative for both depth ranges.
+	float planes[6][4];
+	for (uint32_t ii = 0; ii < 6; ++ii)
+	{
+		const uint32_t axis = ii/2;
+		const float    sign = 0 == (ii & 1) ? 1.0f : -1.0f;
+
+		float* plane = planes[ii];
+		plane[0] = _viewProj[ 3] + sign*_viewProj[axis   ];
+		plane[1] = _viewProj[ 7] + sign*_viewProj[axis+ 4];
+		plane[2] = _viewProj[11] + sign*_viewProj[axis+ 8];
+		plane[3] = _viewProj[15] + sign*_viewProj[axis+12];
+
+		const float invLen = 1.0f/bx::length(bx::Vec3(plane[0], plane[1], plane[2]) );
+		plane[0] *= invLen;
+		plane[1] *= invLen;
+		plane[2] *= invLen;
+		plane[3] *= invLen;
+	}
+
+	// Cull 4 spheres at a time, sort key groups draws by vertex and index buffer.
+	uint32_t numVisible = 0;
+	for (uint32_t ii = 0; ii < numAligned; ii += 4)
+	{
+		const bx::simd128_t px = bx::simd_ld(&posX[ii]);
+		const bx::simd128_t py = bx::simd_ld(&posY[ii]);
+		const bx::simd128_t pz = bx::simd_ld(&posZ[ii]);
+		const bx::simd128_t nr = bx::simd_sub(bx::simd_zero(), bx::simd_ld(&radius[ii]) );
+
+		bx::simd128_t visible = bx::simd_isplat(UINT32_MAX);
+
+		for (uint32_t jj = 0; jj < 6; ++jj)
+		{
+			const float* plane = planes[jj];
+			const bx::simd128_t dist = bx::simd_add(
+				  bx::simd_add(
+					  bx::simd_mul(px, bx::simd_splat(plane[0]) )
+					, bx::simd_mul(py, bx::simd_splat(plane[1]) )
+					)
+				, bx::simd_add(
+					  bx::simd_mul(pz, bx::simd_splat(plane[2]) )
+					, bx::simd_splat(plane[3])
+					)
+				);
+			visible = bx::simd_and(visible, bx::simd_cmpgt(dist, nr) );
+		}
+
+		for (uint32_t mask = bx::simd_signbitsmask(visible); 0 != mask; mask &= mask - 1)
+		{
+			const uint32_t lane  = bx::uint32_cnttz(mask);
+			const Group&   group = *groups[ii + lane];
+
+			const uint32_t vb = bgfx::isValid(group.m_dvbh) ? 0x8000u | group.m_dvbh.idx : group.m_vbh.idx;
+			const uint32_t ib = bgfx::isValid(group.m_dibh) ? 0x8000u | group.m_dibh.idx : group.m_ibh.idx;
+
+			keys[numVisible]   = (vb << 16) | (ib & 0xffff);
+			values[numVisible] = ii + lane;
+			++numVisible;
+		}
+	}
+
+	bx::radixSort(keys, tempKeys, values, tempValues, numVisible);
+
+	// Transform is cached once per instance, and reused by all its groups.
+	bx::memSet(cache, 0xff, _num*sizeof(uint32_t) );
+
+	for (uint32_t ii = 0; ii < numVisible; ++ii)
+	{
+		const uint32_t draw = values[ii];
+		const uint32_t inst = instance[draw];
+
+		if (UINT32_MAX == cache[inst])
+		{
+			cache[inst] = bgfx::setTransform(_instances[inst].m_mtx);
+		}
+		else
+		{
+			bgfx::setTransform(cache[inst]);
+		}
+
+		bgfx::setState(_state);
+		setGroupBuffers(*groups[draw]);
+		bgfx::submit(
+			  _id
+			, _program
+			, 0
+			, BGFX_DISCARD_ALL
+			);
+	}
+
+	bx::alignedFree(allocator, data, 16);
+
+	return numVisible;
+}
+
 struct RendererTypeRemap
 {
 	bx::StringView           name;
@@ -106,6 +106,10 @@ struct Group
 
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle m_ibh;
+	bgfx::DynamicVertexBufferHandle m_dvbh; //!< Valid when vertices are sub-allocated from MeshPool.
+	bgfx::DynamicIndexBufferHandle m_dibh;  //!< Valid when indices are sub-allocated from MeshPool.
+	uint32_t m_startVertex;
+	uint32_t m_startIndex;
 	uint16_t m_numVertices;
 	uint8_t* m_vertices;
 	uint32_t m_numIndices;
@@ -117,9 +121,11 @@ struct Group
 };
 typedef stl::vector<Group> GroupArray;
 
+struct MeshPool;
+
 struct Mesh
 {
-	void load(bx::ReaderSeekerI* _reader, bool _ramcopy);
+	void load(bx::ReaderSeekerI* _reader, bool _ramcopy, MeshPool* _pool = NULL);
 	void unload();
 	void submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state) const;
 	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices) const;
@@ -131,6 +137,14 @@ struct Mesh
 ///
 Mesh* meshLoad(const bx::FilePath& _filePath, bool _ramcopy = false);
 
+/// Load mesh and sub-allocate its vertices and indices from shared pool buffers. Groups
+/// that don't fit into pool, or have different vertex layout, get their own buffers.
+///
+/// @attention Pooled groups have invalid `m_vbh`/`m_ibh`, and pool space is released only
+///   when pool is destroyed.
+///
+Mesh* meshLoad(const bx::FilePath& _filePath, MeshPool* _pool, bool _ramcopy = false);
+
 ///
 void meshUnload(Mesh* _mesh);
 
@@ -146,6 +160,25 @@ void meshSubmit(const Mesh* _mesh, bgfx::ViewId _id, bgfx::ProgramHandle _progra
 ///
 void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1);
 
+/// Create shared vertex and index buffers for meshes with vertex layout `_layout`.
+MeshPool* meshPoolCreate(const bgfx::VertexLayout& _layout, uint32_t _maxVertices, uint32_t _maxIndices);
+
+///
+void meshPoolDestroy(MeshPool* _pool);
+
+///
+struct MeshInstance
+{
+	const Mesh* m_mesh;
+	float       m_mtx[16];
+};
+
+/// Frustum cull groups of all instances against `_viewProj` using group bounding spheres,
+/// and submit visible groups sorted by vertex and index buffer, so that draws from the same
+/// pool don't rebind buffers. Returns number of submitted draws.
+///
+uint32_t meshSubmitCulled(const MeshInstance* _instances, uint32_t _num, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _viewProj, uint64_t _state = BGFX_STATE_MASK);
+
 /// bgfx::RendererType::Enum to name.
 bx::StringView getName(bgfx::RendererType::Enum _type);
 
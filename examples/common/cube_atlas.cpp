@@ -255,11 +255,13 @@ Atlas::Atlas(uint16_t _textureSize, uint16_t _maxRegionsCount)
 	, m_textureSize(_textureSize)
 	, m_regionCount(0)
 	, m_maxRegionCount(_maxRegionsCount)
+	, m_updateDepth(0)
 {
 	BX_ASSERT(_textureSize >= 64 && _textureSize <= 4096, "Invalid _textureSize %d.", _textureSize);
 	BX_ASSERT(_maxRegionsCount >= 64 && _maxRegionsCount <= 32000, "Invalid _maxRegionsCount %d.", _maxRegionsCount);
 
 	m_texelSize = float(UINT16_MAX) / float(m_textureSize);
+	resetDirty();
 
 	m_layers = new PackedLayer[6];
 	for (int ii = 0; ii < 6; ++ii)
@@ -284,10 +286,12 @@ Atlas::Atlas(uint16_t _textureSize, const uint8_t* _textureBuffer, uint16_t _reg
 	, m_textureSize(_textureSize)
 	, m_regionCount(_regionCount)
 	, m_maxRegionCount(_regionCount < _maxRegionsCount ? _regionCount : _maxRegionsCount)
+	, m_updateDepth(0)
 {
 	BX_ASSERT(_regionCount <= 64 && _maxRegionsCount <= 4096, "_regionCount %d, _maxRegionsCount %d", _regionCount, _maxRegionsCount);
 
 	m_texelSize = float(UINT16_MAX) / float(m_textureSize);
+	resetDirty();
 
 	m_regions = new AtlasRegion[_regionCount];
 	m_textureBuffer = new uint8_t[getTextureBufferSize()];
@@ -382,46 +386,105 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 
 void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer)
 {
-	uint32_t size = _region.width * _region.height * 4;
-	if (0 < size)
+	if (0 == _region.width
+	||  0 == _region.height)
 	{
-		const bgfx::Memory* mem = bgfx::alloc(size);
-		bx::memSet(mem->data, 0, mem->size);
-		if (_region.getType() == AtlasRegion::TYPE_BGRA8)
+		return;
+	}
+
+	const uint32_t face = _region.getFaceIndex();
+	uint8_t* outLineBuffer = m_textureBuffer + face * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4);
+	const uint8_t* inLineBuffer = _bitmapBuffer;
+
+	if (_region.getType() == AtlasRegion::TYPE_BGRA8)
+	{
+		for (int yy = 0; yy < _region.height; ++yy)
 		{
-			const uint8_t* inLineBuffer = _bitmapBuffer;
-			uint8_t* outLineBuffer = m_textureBuffer + _region.getFaceIndex() * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4);
+			bx::memCopy(outLineBuffer, inLineBuffer, _region.width * 4);
+			inLineBuffer += _region.width * 4;
+			outLineBuffer += m_textureSize * 4;
+		}
+	}
+	else
+	{
+		uint32_t layer = _region.getComponentIndex();
 
-			for (int yy = 0; yy < _region.height; ++yy)
+		for (int yy = 0; yy < _region.height; ++yy)
+		{
+			for (int xx = 0; xx < _region.width; ++xx)
 			{
-				bx::memCopy(outLineBuffer, inLineBuffer, _region.width * 4);
-				inLineBuffer += _region.width * 4;
-				outLineBuffer += m_textureSize * 4;
+				outLineBuffer[(xx * 4) + layer] = inLineBuffer[xx];
 			}
 
-			bx::memCopy(mem->data, _bitmapBuffer, mem->size);
+			inLineBuffer += _region.width;
+			outLineBuffer += m_textureSize * 4;
 		}
-		else
+	}
+
+	uint16_t* dirty = m_dirty[face];
+	dirty[0] = bx::min<uint16_t>(dirty[0], _region.x);
+	dirty[1] = bx::min<uint16_t>(dirty[1], _region.y);
+	dirty[2] = bx::max<uint16_t>(dirty[2], uint16_t(_region.x + _region.width) );
+	dirty[3] = bx::max<uint16_t>(dirty[3], uint16_t(_region.y + _region.height) );
+
+	if (0 == m_updateDepth)
+	{
+		flushDirty();
+	}
+}
+
+void Atlas::beginUpdate()
+{
+	++m_updateDepth;
+}
+
+void Atlas::endUpdate()
+{
+	BX_ASSERT(0 < m_updateDepth, "endUpdate called without matching beginUpdate.");
+
+	if (0 == --m_updateDepth)
+	{
+		flushDirty();
+	}
+}
+
+void Atlas::resetDirty()
+{
+	for (uint32_t ii = 0; ii < 6; ++ii)
+	{
+		m_dirty[ii][0] = UINT16_MAX;
+		m_dirty[ii][1] = UINT16_MAX;
+		m_dirty[ii][2] = 0;
+		m_dirty[ii][3] = 0;
+	}
+}
+
+void Atlas::flushDirty()
+{
+	for (uint32_t ii = 0; ii < 6; ++ii)
+	{
+		const uint16_t* dirty = m_dirty[ii];
+
+		if (dirty[0] < dirty[2]
+		&&  dirty[1] < dirty[3])
 		{
-			uint32_t layer = _region.getComponentIndex();
-			const uint8_t* inLineBuffer = _bitmapBuffer;
-			uint8_t* outLineBuffer = (m_textureBuffer + _region.getFaceIndex() * (m_textureSize * m_textureSize * 4) + ( ( (_region.y * m_textureSize) + _region.x) * 4) );
+			const uint16_t width  = dirty[2] - dirty[0];
+			const uint16_t height = dirty[3] - dirty[1];
 
-			for (int yy = 0; yy < _region.height; ++yy)
+			const bgfx::Memory* mem = bgfx::alloc(width * height * 4);
+			const uint8_t* inLineBuffer = m_textureBuffer + ii * (m_textureSize * m_textureSize * 4) + ( ( (dirty[1] * m_textureSize) + dirty[0]) * 4);
+
+			for (uint32_t yy = 0; yy < height; ++yy)
 			{
-				for (int xx = 0; xx < _region.width; ++xx)
-				{
-					outLineBuffer[(xx * 4) + layer] = inLineBuffer[xx];
-				}
-
-				bx::memCopy(mem->data + yy * _region.width * 4, outLineBuffer, _region.width * 4);
-				inLineBuffer += _region.width;
-				outLineBuffer += m_textureSize * 4;
+				bx::memCopy(mem->data + yy * width * 4, inLineBuffer, width * 4);
+				inLineBuffer += m_textureSize * 4;
 			}
-		}
 
-		bgfx::updateTextureCube(m_textureHandle, 0, (uint8_t)_region.getFaceIndex(), 0, _region.x, _region.y, _region.width, _region.height, mem);
+			bgfx::updateTextureCube(m_textureHandle, 0, uint8_t(ii), 0, dirty[0], dirty[1], width, height, mem);
+		}
 	}
+
+	resetDirty();
 }
 
 void Atlas::packFaceLayerUV(uint32_t _idx, uint8_t* _vertexBuffer, uint32_t _offset, uint32_t _stride) const
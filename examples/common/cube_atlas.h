@@ -73,6 +73,13 @@ public:
 	/// update a preallocated region
 	void updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer);
 
+	/// defer texture updates until matching endUpdate, all regions added or
+	/// updated in between are uploaded with one update per dirty cube face
+	void beginUpdate();
+
+	/// upload regions modified since beginUpdate
+	void endUpdate();
+
 	/// Pack the UV coordinates of the four corners of a region to a vertex buffer using the supplied vertex format.
 	/// v0 -- v3
 	/// |     |     encoded in that order:  v0,v1,v2,v3
@@ -135,6 +142,9 @@ public:
 	}
 
 private:
+	void resetDirty();
+	void flushDirty();
+
 	struct PackedLayer;
 	PackedLayer* m_layers;
 	AtlasRegion* m_regions;
@@ -149,6 +159,9 @@ private:
 
 	uint16_t m_regionCount;
 	uint16_t m_maxRegionCount;
+
+	uint16_t m_dirty[6][4];
+	uint32_t m_updateDepth;
 };
 
 #endif // CUBE_ATLAS_H_HEADER_GUARD
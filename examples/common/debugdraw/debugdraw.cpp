@@ -20,6 +20,10 @@
 #	define DEBUG_DRAW_CONFIG_MAX_GEOMETRY 256
 #endif // DEBUG_DRAW_CONFIG_MAX_GEOMETRY
 
+#ifndef DEBUG_DRAW_CONFIG_INSTANCING
+#	define DEBUG_DRAW_CONFIG_INSTANCING 1
+#endif // DEBUG_DRAW_CONFIG_INSTANCING
+
 struct DebugVertex
 {
 	float m_x;
@@ -73,6 +77,7 @@ struct DebugShapeVertex
 	float m_y;
 	float m_z;
 	uint8_t m_indices[4];
+	uint32_t m_abgr;
 
 	static void init()
 	{
@@ -80,6 +85,7 @@ struct DebugShapeVertex
 			.begin()
 			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
 			.add(bgfx::Attrib::Indices,  4, bgfx::AttribType::Uint8)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
 			.end();
 	}
 
@@ -107,12 +113,19 @@ struct DebugMeshVertex
 
 bgfx::VertexLayout DebugMeshVertex::ms_layout;
 
+/// Per instance data for instanced shapes, model matrix and color.
+struct DebugShapeInstance
+{
+	float m_mtx[16];
+	float m_rgba[4];
+};
+
 static DebugShapeVertex s_quadVertices[4] =
 {
-	{-1.0f, 0.0f,  1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f, 0.0f,  1.0f, { 0, 0, 0, 0 } },
-	{-1.0f, 0.0f, -1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f, 0.0f, -1.0f, { 0, 0, 0, 0 } },
+	{-1.0f, 0.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f, 0.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{-1.0f, 0.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f, 0.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
 
 };
 
@@ -124,14 +137,14 @@ static const uint16_t s_quadIndices[6] =
 
 static DebugShapeVertex s_cubeVertices[8] =
 {
-	{-1.0f,  1.0f,  1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f,  1.0f,  1.0f, { 0, 0, 0, 0 } },
-	{-1.0f, -1.0f,  1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f, -1.0f,  1.0f, { 0, 0, 0, 0 } },
-	{-1.0f,  1.0f, -1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f,  1.0f, -1.0f, { 0, 0, 0, 0 } },
-	{-1.0f, -1.0f, -1.0f, { 0, 0, 0, 0 } },
-	{ 1.0f, -1.0f, -1.0f, { 0, 0, 0, 0 } },
+	{-1.0f,  1.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f,  1.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{-1.0f, -1.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f, -1.0f,  1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{-1.0f,  1.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f,  1.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{-1.0f, -1.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
+	{ 1.0f, -1.0f, -1.0f, { 0, 0, 0, 0 }, UINT32_MAX },
 };
 
 static const uint16_t s_cubeIndices[36] =
@@ -318,6 +331,10 @@ bx::Vec3 getPoint(Axis::Enum _axis, float _x, float _y)
 #include "fs_debugdraw_fill_lit.bin.h"
 #include "vs_debugdraw_fill_texture.bin.h"
 #include "fs_debugdraw_fill_texture.bin.h"
+#if DEBUG_DRAW_CONFIG_INSTANCING
+#	include "vs_debugdraw_fill_instanced.bin.h"
+#	include "fs_debugdraw_fill_instanced.bin.h"
+#endif // DEBUG_DRAW_CONFIG_INSTANCING
 
 static const bgfx::EmbeddedShader s_embeddedShaders[] =
 {
@@ -333,6 +350,10 @@ static const bgfx::EmbeddedShader s_embeddedShaders[] =
 	BGFX_EMBEDDED_SHADER(fs_debugdraw_fill_lit),
 	BGFX_EMBEDDED_SHADER(vs_debugdraw_fill_texture),
 	BGFX_EMBEDDED_SHADER(fs_debugdraw_fill_texture),
+#if DEBUG_DRAW_CONFIG_INSTANCING
+	BGFX_EMBEDDED_SHADER(vs_debugdraw_fill_instanced),
+	BGFX_EMBEDDED_SHADER(fs_debugdraw_fill_instanced),
+#endif // DEBUG_DRAW_CONFIG_INSTANCING
 
 	BGFX_EMBEDDED_SHADER_END()
 };
@@ -508,6 +529,7 @@ struct Program
 		FillLit,
 		FillLitMesh,
 		FillTexture,
+		FillInstanced,
 
 		Count
 	};
@@ -621,6 +643,24 @@ struct DebugDrawShared
 			, true
 			);
 
+#if DEBUG_DRAW_CONFIG_INSTANCING
+		m_program[Program::FillInstanced] = bgfx::createProgram(
+			  bgfx::createEmbeddedShader(s_embeddedShaders, type, "vs_debugdraw_fill_instanced")
+			, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_debugdraw_fill_instanced")
+			, true
+			);
+#else
+		m_program[Program::FillInstanced] = BGFX_INVALID_HANDLE;
+#endif // DEBUG_DRAW_CONFIG_INSTANCING
+
+		// Wireframe shapes with single transform are batched per mesh and
+		// state, and drawn with single instanced submit when renderer
+		// supports instancing.
+		m_instancing = true
+			&& 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING)
+			&& isValid(m_program[Program::FillInstanced])
+			;
+
 		u_params   = bgfx::createUniform("u_params",   bgfx::UniformType::Vec4, 4);
 		s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Sampler);
 		m_texture  = bgfx::createTexture2D(SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, false, 1, bgfx::TextureFormat::BGRA8);
@@ -921,6 +961,12 @@ struct DebugDrawShared
 
 			bx::free(m_allocator, vertices[id]);
 			bx::free(m_allocator, indices[id]);
+
+			for (uint32_t ii = 0, num = m_mesh[id].m_numVertices; ii < num; ++ii)
+			{
+				DebugShapeVertex* vertex = (DebugShapeVertex*)&vb->data[(m_mesh[id].m_startVertex + ii) * stride];
+				vertex->m_abgr = UINT32_MAX;
+			}
 		}
 
 		bx::memCopy(&vb->data[m_mesh[DebugMesh::Quad].m_startVertex * stride]
@@ -953,7 +999,10 @@ struct DebugDrawShared
 		bgfx::destroy(m_vbh);
 		for (uint32_t ii = 0; ii < Program::Count; ++ii)
 		{
-			bgfx::destroy(m_program[ii]);
+			if (isValid(m_program[ii]) )
+			{
+				bgfx::destroy(m_program[ii]);
+			}
 		}
 		bgfx::destroy(u_params);
 		bgfx::destroy(s_texColor);
@@ -1011,6 +1060,8 @@ struct DebugDrawShared
 
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
+
+	bool m_instancing;
 };
 
 static DebugDrawShared s_dds;
@@ -1028,10 +1079,14 @@ struct DebugDrawEncoderImpl
 	{
 		m_defaultEncoder = _encoder;
 		m_state = State::Count;
+
+		bx::memSet(&m_batch, 0, sizeof(m_batch) );
 	}
 
 	void shutdown()
 	{
+		bx::free(s_dds.m_allocator, m_batch.m_data);
+		bx::memSet(&m_batch, 0, sizeof(m_batch) );
 	}
 
 	void begin(bgfx::ViewId _viewId, bool _depthTestLess, bgfx::Encoder* _encoder)
@@ -1072,6 +1127,7 @@ struct DebugDrawEncoderImpl
 	{
 		BX_ASSERT(0 == m_stack, "Invalid stack %d.", m_stack);
 
+		flushInstances();
 		flushQuad();
 		flush();
 
@@ -1516,11 +1572,28 @@ struct DebugDrawEncoderImpl
 		}
 	}
 
-	void setUParams(const Attrib& _attrib, bool _wireframe)
+	static uint64_t getShapeState(const Attrib& _attrib, bool _wireframe)
 	{
-		const float flip = 0 == (_attrib.m_state & BGFX_STATE_CULL_CCW) ? 1.0f : -1.0f;
 		const uint8_t alpha = _attrib.m_abgr >> 24;
 
+		return 0
+			| _attrib.m_state
+			| (_wireframe ? BGFX_STATE_PT_LINES | BGFX_STATE_LINEAA | BGFX_STATE_BLEND_ALPHA
+			: (alpha < 0xff) ? BGFX_STATE_BLEND_ALPHA : 0)
+			;
+	}
+
+	void setUParams(const Attrib& _attrib, bool _wireframe)
+	{
+		setUParams(_attrib.m_state, _attrib.m_abgr);
+		m_encoder->setState(getShapeState(_attrib, _wireframe) );
+	}
+
+	void setUParams(uint64_t _state, uint32_t _abgr)
+	{
+		const float flip = 0 == (_state & BGFX_STATE_CULL_CCW) ? 1.0f : -1.0f;
+		const uint8_t alpha = _abgr >> 24;
+
 		float params[4][4] =
 		{
 			{ // lightDir
@@ -1542,25 +1615,21 @@ struct DebugDrawEncoderImpl
 				0.0f, // unused
 			},
 			{ // matColor
-				( (_attrib.m_abgr)       & 0xff) / 255.0f,
-				( (_attrib.m_abgr >> 8)  & 0xff) / 255.0f,
-				( (_attrib.m_abgr >> 16) & 0xff) / 255.0f,
+				( (_abgr)       & 0xff) / 255.0f,
+				( (_abgr >> 8)  & 0xff) / 255.0f,
+				( (_abgr >> 16) & 0xff) / 255.0f,
 				(alpha) / 255.0f,
 			},
 		};
 
 		bx::store(params[0], bx::normalize(bx::load<bx::Vec3>(params[0]) ) );
 		m_encoder->setUniform(s_dds.u_params, params, 4);
-
-		m_encoder->setState(0
-			| _attrib.m_state
-			| (_wireframe ? BGFX_STATE_PT_LINES | BGFX_STATE_LINEAA | BGFX_STATE_BLEND_ALPHA
-			: (alpha < 0xff) ? BGFX_STATE_BLEND_ALPHA : 0)
-			);
 	}
 
 	void draw(GeometryHandle _handle)
 	{
+		flushInstances();
+
 		const Geometry::Geometry& geometry = s_dds.m_geometry.m_geometry[_handle.idx];
 		m_encoder->setVertexBuffer(0, geometry.m_vbh);
 
@@ -2115,6 +2184,16 @@ struct DebugDrawEncoderImpl
 
 	void draw(DebugMesh::Enum _mesh, const float* _mtx, uint16_t _num, bool _wireframe)
 	{
+		if (s_dds.m_instancing
+		&&  _wireframe
+		&&  1 == _num)
+		{
+			drawInstanced(_mesh, _mtx);
+			return;
+		}
+
+		flushInstances();
+
 		pushTransform(_mtx, _num, false /* flush */);
 
 		const DebugMesh& mesh = s_dds.m_mesh[_mesh];
@@ -2139,6 +2218,97 @@ struct DebugDrawEncoderImpl
 		popTransform(false /* flush */);
 	}
 
+	void drawInstanced(DebugMesh::Enum _mesh, const float* _mtx)
+	{
+		const Attrib& attrib = m_attrib[m_stack];
+		const uint64_t state = getShapeState(attrib, true);
+
+		InstanceBatch& batch = m_batch;
+
+		// Only consecutive shapes with the same mesh and state are batched, so
+		// that draw submission order is preserved.
+		if (0 != batch.m_num
+		&& (state != batch.m_state || _mesh != batch.m_mesh) )
+		{
+			flushInstances();
+		}
+
+		if (batch.m_num == batch.m_max)
+		{
+			batch.m_max  = bx::max<uint32_t>(batch.m_max*2, 64);
+			batch.m_data = (DebugShapeInstance*)bx::realloc(
+				  s_dds.m_allocator
+				, batch.m_data
+				, batch.m_max*sizeof(DebugShapeInstance)
+				);
+		}
+
+		batch.m_state = state;
+		batch.m_mesh  = _mesh;
+		DebugShapeInstance& instance = batch.m_data[batch.m_num++];
+
+		const MatrixStack& stack = m_mtxStack[m_mtxStackCurrent];
+
+		if (NULL == stack.data)
+		{
+			bx::memCopy(instance.m_mtx, _mtx, 64);
+		}
+		else
+		{
+			bx::mtxMul(instance.m_mtx, _mtx, stack.data);
+		}
+
+		instance.m_rgba[0] = ( (attrib.m_abgr)       & 0xff) / 255.0f;
+		instance.m_rgba[1] = ( (attrib.m_abgr >> 8)  & 0xff) / 255.0f;
+		instance.m_rgba[2] = ( (attrib.m_abgr >> 16) & 0xff) / 255.0f;
+		instance.m_rgba[3] = ( (attrib.m_abgr >> 24) & 0xff) / 255.0f;
+	}
+
+	void flushInstances()
+	{
+		InstanceBatch& batch = m_batch;
+
+		if (0 == batch.m_num)
+		{
+			return;
+		}
+
+		const DebugMesh& mesh = s_dds.m_mesh[batch.m_mesh];
+		const uint16_t stride = uint16_t(sizeof(DebugShapeInstance) );
+
+		for (uint32_t offset = 0; offset < batch.m_num;)
+		{
+			const uint32_t num = bgfx::getAvailInstanceDataBuffer(batch.m_num - offset, stride);
+
+			if (0 == num)
+			{
+				BX_WARN(false, "Out of instance data buffer, dropping %d shapes.", batch.m_num - offset);
+				break;
+			}
+
+			bgfx::InstanceDataBuffer idb;
+			bgfx::allocInstanceDataBuffer(&idb, num, stride);
+			bx::memCopy(idb.data, &batch.m_data[offset], num*stride);
+
+			if (0 != mesh.m_numIndices[1])
+			{
+				m_encoder->setIndexBuffer(s_dds.m_ibh
+					, mesh.m_startIndex[1]
+					, mesh.m_numIndices[1]
+					);
+			}
+
+			m_encoder->setState(batch.m_state);
+			m_encoder->setVertexBuffer(0, s_dds.m_vbh, mesh.m_startVertex, mesh.m_numVertices);
+			m_encoder->setInstanceDataBuffer(&idb);
+			m_encoder->submit(m_viewId, s_dds.m_program[Program::FillInstanced]);
+
+			offset += num;
+		}
+
+		batch.m_num = 0;
+	}
+
 	void softFlush()
 	{
 		if (m_pos == uint16_t(BX_COUNTOF(m_cache) ) )
@@ -2149,6 +2319,8 @@ struct DebugDrawEncoderImpl
 
 	void flush()
 	{
+		flushInstances();
+
 		if (0 != m_pos)
 		{
 			if (checkAvailTransientBuffers(m_pos, DebugVertex::ms_layout, m_indexPos) )
@@ -2186,6 +2358,8 @@ struct DebugDrawEncoderImpl
 
 	void flushQuad()
 	{
+		flushInstances();
+
 		if (0 != m_posQuad)
 		{
 			const uint32_t numIndices = m_posQuad/4*6;
@@ -2268,6 +2442,17 @@ struct DebugDrawEncoderImpl
 
 	MatrixStack m_mtxStack[32];
 
+	struct InstanceBatch
+	{
+		DebugShapeInstance* m_data;
+		uint64_t m_state;
+		DebugMesh::Enum m_mesh;
+		uint32_t m_num;
+		uint32_t m_max;
+	};
+
+	InstanceBatch m_batch;
+
 	bgfx::ViewId m_viewId;
 	uint8_t m_stack;
 	bool    m_depthTestLess;
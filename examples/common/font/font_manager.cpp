@@ -23,6 +23,7 @@ namespace stl = tinystl;
 
 #include "font_manager.h"
 #include "../cube_atlas.h"
+#include "../workerpool.h"
 
 
 class TrueTypeFont
@@ -49,6 +50,12 @@ public:
 	/// @ remark buffer min size: glyphInfo.m_width * glyphInfo * height * sizeof(char)
 	bool bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer);
 
+	/// raster a glyph with strategy selected by font type
+	bool bakeGlyph(uint32_t _fontType, CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer);
+
+	/// return the buffer size required to raster a glyph
+	uint32_t getGlyphBufferSize(uint32_t _fontType, CodePoint _codePoint);
+
 private:
 	friend class FontManager;
 
@@ -200,6 +207,46 @@ bool TrueTypeFont::bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo
 	return true;
 }
 
+bool TrueTypeFont::bakeGlyph(uint32_t _fontType, CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
+{
+	switch (_fontType)
+	{
+	case FONT_TYPE_ALPHA:
+		return bakeGlyphAlpha(_codePoint, _glyphInfo, _outBuffer);
+
+	case FONT_TYPE_DISTANCE:
+	case FONT_TYPE_DISTANCE_SUBPIXEL:
+	case FONT_TYPE_DISTANCE_OUTLINE:
+	case FONT_TYPE_DISTANCE_OUTLINE_IMAGE:
+	case FONT_TYPE_DISTANCE_DROP_SHADOW:
+	case FONT_TYPE_DISTANCE_DROP_SHADOW_IMAGE:
+	case FONT_TYPE_DISTANCE_OUTLINE_DROP_SHADOW_IMAGE:
+		return bakeGlyphDistance(_codePoint, _glyphInfo, _outBuffer);
+
+	default:
+		BX_ASSERT(false, "TextureType not supported yet");
+	}
+
+	return false;
+}
+
+uint32_t TrueTypeFont::getGlyphBufferSize(uint32_t _fontType, CodePoint _codePoint)
+{
+	int32_t x0, y0, x1, y1;
+	stbtt_GetCodepointBitmapBox(&m_font, _codePoint, m_scale, m_scale, &x0, &y0, &x1, &y1);
+
+	uint32_t ww = uint32_t(x1-x0);
+	uint32_t hh = uint32_t(y1-y0);
+
+	if (FONT_TYPE_ALPHA != _fontType)
+	{
+		ww += m_widthPadding  * 2;
+		hh += m_heightPadding * 2;
+	}
+
+	return ww * hh;
+}
+
 typedef stl::unordered_map<CodePoint, GlyphInfo> GlyphHashMap;
 
 // cache font data
@@ -213,6 +260,8 @@ struct FontManager::CachedFont
 
 	FontInfo fontInfo;
 	GlyphHashMap cachedGlyphs;
+	// returned while glyph is pending in asynchronous mode
+	GlyphInfo placeholderGlyph;
 	TrueTypeFont* trueTypeFont;
 	// an handle to a master font in case of sub distance field font
 	FontHandle masterFontHandle;
@@ -221,6 +270,15 @@ struct FontManager::CachedFont
 
 #define MAX_FONT_BUFFER_SIZE (512 * 512 * 4)
 
+struct FontManager::GlyphRequest
+{
+	FontHandle handle;
+	CodePoint codePoint;
+	GlyphInfo glyphInfo;
+	uint32_t offset;
+	bool baked;
+};
+
 FontManager::FontManager(Atlas* _atlas)
 	: m_ownAtlas(false)
 	, m_atlas(_atlas)
@@ -241,6 +299,13 @@ void FontManager::init()
 	m_cachedFonts = new CachedFont[MAX_OPENED_FONT];
 	m_buffer = new uint8_t[MAX_FONT_BUFFER_SIZE];
 
+	m_workerPool  = NULL;
+	m_requests    = new GlyphRequest[MAX_GLYPHS_PER_UPDATE];
+	m_numRequests = 0;
+	m_scratch     = NULL;
+	m_scratchSize = 0;
+	m_async       = false;
+
 	const uint32_t W = 3;
 	// Create filler rectangle
 	uint8_t buffer[W * W * 4];
@@ -263,6 +328,10 @@ FontManager::~FontManager()
 
 	delete [] m_buffer;
 
+	delete m_workerPool;
+	delete [] m_requests;
+	delete [] m_scratch;
+
 	if (m_ownAtlas)
 	{
 		delete m_atlas;
@@ -314,6 +383,11 @@ FontHandle FontManager::createFontByPixelSize(TrueTypeHandle _ttfHandle, uint32_
 	font.cachedGlyphs.clear();
 	font.masterFontHandle.idx = bx::kInvalidHandle;
 
+	bx::memSet(&font.placeholderGlyph, 0, sizeof(GlyphInfo) );
+	font.placeholderGlyph.advance_x   = bx::round(_pixelSize * 0.5f);
+	font.placeholderGlyph.bitmapScale = 1.0f;
+	font.placeholderGlyph.regionIndex = m_blackGlyph.regionIndex;
+
 	FontHandle handle = { fontIdx };
 	return handle;
 }
@@ -343,6 +417,9 @@ FontHandle FontManager::createScaledFontToPixelSize(FontHandle _baseFontHandle,
 	font.trueTypeFont = NULL;
 	font.masterFontHandle = _baseFontHandle;
 
+	font.placeholderGlyph = baseFont.placeholderGlyph;
+	font.placeholderGlyph.advance_x = bx::round(_pixelSize * 0.5f);
+
 	FontHandle handle = { fontIdx };
 	return handle;
 }
@@ -361,6 +438,18 @@ void FontManager::destroyFont(FontHandle _handle)
 
 	font.cachedGlyphs.clear();
 	m_fontHandles.free(_handle.idx);
+
+	for (uint32_t ii = 0; ii < m_numRequests;)
+	{
+		if (m_requests[ii].handle.idx == _handle.idx)
+		{
+			m_requests[ii] = m_requests[--m_numRequests];
+		}
+		else
+		{
+			++ii;
+		}
+	}
 }
 
 bool FontManager::preloadGlyph(FontHandle _handle, const wchar_t* _string)
@@ -373,16 +462,23 @@ bool FontManager::preloadGlyph(FontHandle _handle, const wchar_t* _string)
 		return false;
 	}
 
+	bool result = true;
+
+	m_atlas->beginUpdate();
+
 	for (uint32_t ii = 0, end = (uint32_t)wcslen(_string); ii < end; ++ii)
 	{
 		CodePoint codePoint = _string[ii];
 		if (!preloadGlyph(_handle, codePoint) )
 		{
-			return false;
+			result = false;
+			break;
 		}
 	}
 
-	return true;
+	m_atlas->endUpdate();
+
+	return result;
 }
 
 bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
@@ -401,45 +497,13 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 	{
 		GlyphInfo glyphInfo;
 
-		switch (font.fontInfo.fontType)
-		{
-		case FONT_TYPE_ALPHA:
-			font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		case FONT_TYPE_DISTANCE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		case FONT_TYPE_DISTANCE_SUBPIXEL:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		case FONT_TYPE_DISTANCE_OUTLINE:
-		case FONT_TYPE_DISTANCE_OUTLINE_IMAGE:
-		case FONT_TYPE_DISTANCE_DROP_SHADOW:
-		case FONT_TYPE_DISTANCE_DROP_SHADOW_IMAGE:
-		case FONT_TYPE_DISTANCE_OUTLINE_DROP_SHADOW_IMAGE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		default:
-			BX_ASSERT(false, "TextureType not supported yet");
-		}
-
-		if (!addBitmap(glyphInfo, m_buffer) )
+		if (!font.trueTypeFont->bakeGlyph(font.fontInfo.fontType, _codePoint, glyphInfo, m_buffer)
+		||  !addBitmap(glyphInfo, m_buffer) )
 		{
 			return false;
 		}
 
-		glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
-		glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
-		glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
-		glyphInfo.offset_y = (glyphInfo.offset_y * fontInfo.scale);
-		glyphInfo.height = (glyphInfo.height * fontInfo.scale);
-		glyphInfo.width = (glyphInfo.width * fontInfo.scale);
-
-		font.cachedGlyphs[_codePoint] = glyphInfo;
+		addGlyph(_handle, _codePoint, glyphInfo);
 		return true;
 	}
 
@@ -534,11 +598,18 @@ float FontManager::getKerning(FontHandle _handle, CodePoint _prevCodePoint, Code
 
 const GlyphInfo* FontManager::getGlyphInfo(FontHandle _handle, CodePoint _codePoint)
 {
-	const GlyphHashMap& cachedGlyphs = m_cachedFonts[_handle.idx].cachedGlyphs;
+	const CachedFont& font = m_cachedFonts[_handle.idx];
+	const GlyphHashMap& cachedGlyphs = font.cachedGlyphs;
 	GlyphHashMap::const_iterator it = cachedGlyphs.find(_codePoint);
 
 	if (it == cachedGlyphs.end() )
 	{
+		if (m_async
+		&&  requestGlyph(_handle, _codePoint) )
+		{
+			return &font.placeholderGlyph;
+		}
+
 		if (!preloadGlyph(_handle, _codePoint) )
 		{
 			return NULL;
@@ -561,3 +632,171 @@ bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data)
 		);
 	return true;
 }
+
+void FontManager::addGlyph(FontHandle _handle, CodePoint _codePoint, const GlyphInfo& _glyphInfo)
+{
+	CachedFont& font = m_cachedFonts[_handle.idx];
+	const FontInfo& fontInfo = font.fontInfo;
+
+	GlyphInfo glyphInfo = _glyphInfo;
+	glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
+	glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
+	glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
+	glyphInfo.offset_y = (glyphInfo.offset_y * fontInfo.scale);
+	glyphInfo.height = (glyphInfo.height * fontInfo.scale);
+	glyphInfo.width = (glyphInfo.width * fontInfo.scale);
+
+	font.cachedGlyphs[_codePoint] = glyphInfo;
+}
+
+bool FontManager::requestGlyph(FontHandle _handle, CodePoint _codePoint)
+{
+	const CachedFont& font = m_cachedFonts[_handle.idx];
+
+	if (NULL == font.trueTypeFont)
+	{
+		// Scaled font glyphs are derived from master font glyph, only master
+		// font glyph needs to be baked.
+		if (!isValid(font.masterFontHandle) )
+		{
+			return false;
+		}
+
+		const CachedFont& masterFont = m_cachedFonts[font.masterFontHandle.idx];
+		if (masterFont.cachedGlyphs.end() != masterFont.cachedGlyphs.find(_codePoint) )
+		{
+			return false;
+		}
+
+		return requestGlyph(font.masterFontHandle, _codePoint);
+	}
+
+	for (uint32_t ii = 0; ii < m_numRequests; ++ii)
+	{
+		const GlyphRequest& request = m_requests[ii];
+		if (request.handle.idx == _handle.idx
+		&&  request.codePoint  == _codePoint)
+		{
+			return true;
+		}
+	}
+
+	// When queue is full glyph is not recorded, it will be requested again
+	// next time text is rebuilt.
+	if (m_numRequests < MAX_GLYPHS_PER_UPDATE)
+	{
+		GlyphRequest& request = m_requests[m_numRequests++];
+		request.handle    = _handle;
+		request.codePoint = _codePoint;
+		request.offset    = 0;
+		request.baked     = false;
+	}
+
+	return true;
+}
+
+void FontManager::bakeGlyphTask(void* _userData, uint32_t _idx, uint32_t /*_num*/)
+{
+	FontManager* fontManager = (FontManager*)_userData;
+	GlyphRequest& request = fontManager->m_requests[_idx];
+	const CachedFont& font = fontManager->m_cachedFonts[request.handle.idx];
+
+	request.baked = font.trueTypeFont->bakeGlyph(
+		  font.fontInfo.fontType
+		, request.codePoint
+		, request.glyphInfo
+		, &fontManager->m_scratch[request.offset]
+		);
+}
+
+void FontManager::setAsync(bool _async, uint32_t _numThreads)
+{
+	m_async = _async;
+
+	if (_async
+	&&  0 < _numThreads)
+	{
+		if (NULL == m_workerPool)
+		{
+			m_workerPool = new WorkerPool;
+		}
+
+		m_workerPool->init(_numThreads, "FontManager");
+	}
+	else if (NULL != m_workerPool)
+	{
+		delete m_workerPool;
+		m_workerPool = NULL;
+	}
+
+	if (!_async)
+	{
+		update();
+	}
+}
+
+uint32_t FontManager::update()
+{
+	if (0 == m_numRequests)
+	{
+		return 0;
+	}
+
+	// Glyph sizes are known upfront, each request gets its own slice of
+	// scratch buffer so glyphs can be baked in parallel.
+	uint32_t size = 0;
+	for (uint32_t ii = 0; ii < m_numRequests; ++ii)
+	{
+		GlyphRequest& request = m_requests[ii];
+		const CachedFont& font = m_cachedFonts[request.handle.idx];
+
+		request.offset = size;
+		size += font.trueTypeFont->getGlyphBufferSize(font.fontInfo.fontType, request.codePoint);
+	}
+
+	if (size > m_scratchSize)
+	{
+		delete [] m_scratch;
+		m_scratchSize = bx::max(size, m_scratchSize*2);
+		m_scratch     = new uint8_t[m_scratchSize];
+	}
+
+	if (NULL != m_workerPool)
+	{
+		m_workerPool->run(bakeGlyphTask, this, m_numRequests);
+	}
+	else
+	{
+		for (uint32_t ii = 0; ii < m_numRequests; ++ii)
+		{
+			bakeGlyphTask(this, ii, m_numRequests);
+		}
+	}
+
+	uint32_t numAdded = 0;
+
+	m_atlas->beginUpdate();
+
+	for (uint32_t ii = 0; ii < m_numRequests; ++ii)
+	{
+		GlyphRequest& request = m_requests[ii];
+
+		if (request.baked
+		&&  addBitmap(request.glyphInfo, &m_scratch[request.offset]) )
+		{
+			addGlyph(request.handle, request.codePoint, request.glyphInfo);
+			++numAdded;
+		}
+	}
+
+	m_atlas->endUpdate();
+
+	m_numRequests = 0;
+
+	return numAdded;
+}
+
+bool FontManager::hasPendingGlyphs() const
+{
+	return 0 < m_numRequests;
+}
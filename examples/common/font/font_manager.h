@@ -11,10 +11,14 @@
 #include <bgfx/bgfx.h>
 
 class Atlas;
+class WorkerPool;
 
 #define MAX_OPENED_FILES 64
 #define MAX_OPENED_FONT  64
 
+/// Maximum number of queued glyphs baked by single FontManager::update call.
+#define MAX_GLYPHS_PER_UPDATE 256
+
 #define FONT_TYPE_ALPHA             UINT32_C(0x00000100) // L8
 // #define FONT_TYPE_LCD               UINT32_C(0x00000200) // BGRA8
 // #define FONT_TYPE_RGBA              UINT32_C(0x00000300) // BGRA8
@@ -193,6 +197,20 @@ public:
 		return m_blackGlyph;
 	}
 
+	/// Enable asynchronous glyph baking. When enabled getGlyphInfo doesn't
+	/// bake missing glyphs, it queues them and returns empty placeholder
+	/// glyph. Queued glyphs are baked on `_numThreads` worker threads by
+	/// update.
+	void setAsync(bool _async, uint32_t _numThreads = 0);
+
+	/// Bake queued glyphs and upload them to the atlas. Call once per frame.
+	/// Returns number of glyphs added, text buffers created with placeholder
+	/// glyphs should be rebuilt when it's not zero.
+	uint32_t update();
+
+	/// Returns true if there are glyphs waiting to be baked.
+	bool hasPendingGlyphs() const;
+
 private:
 	struct CachedFont;
 	struct CachedFile
@@ -201,8 +219,13 @@ private:
 		uint32_t bufferSize;
 	};
 
+	struct GlyphRequest;
+
 	void init();
 	bool addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data);
+	void addGlyph(FontHandle _handle, CodePoint _codePoint, const GlyphInfo& _glyphInfo);
+	bool requestGlyph(FontHandle _handle, CodePoint _codePoint);
+	static void bakeGlyphTask(void* _userData, uint32_t _idx, uint32_t _num);
 
 	bool m_ownAtlas;
 	Atlas* m_atlas;
@@ -217,6 +240,13 @@ private:
 
 	//temporary buffer to raster glyph
 	uint8_t* m_buffer;
+
+	WorkerPool* m_workerPool;
+	GlyphRequest* m_requests;
+	uint32_t m_numRequests;
+	uint8_t* m_scratch;
+	uint32_t m_scratchSize;
+	bool m_async;
 };
 
 #endif // FONT_MANAGER_H_HEADER_GUARD
@@ -94,6 +94,15 @@ namespace
 		GLNVGblend blendFunc;
 	};
 
+	struct GLNVGbatch
+	{
+		uint64_t state;
+		int image;
+		int uniformOffset;
+		uint32_t startIndex;
+		uint32_t numIndices;
+	};
+
 	struct GLNVGpath
 	{
 		int fillOffset;
@@ -145,6 +154,7 @@ namespace
 		bgfx::TextureHandle texMissing;
 
 		bgfx::TransientVertexBuffer tvb;
+		bgfx::TransientIndexBuffer  tib;
 		bgfx::ViewId viewId;
 
 		struct GLNVGtexture* textures;
@@ -166,6 +176,7 @@ namespace
 		struct NVGvertex* verts;
 		int cverts;
 		int nverts;
+		int maxverts;
 		unsigned char* uniforms;
 		int cuniforms;
 		int nuniforms;
@@ -554,27 +565,126 @@ namespace
 		bgfx::setViewRect(gl->viewId, 0, 0, width * devicePixelRatio, height * devicePixelRatio);
 	}
 
-	static void fan(uint32_t _start, uint32_t _count)
+	static uint32_t glnvg__triIndexCount(int _count)
+	{
+		return 2 < _count ? uint32_t(_count-2)*3 : 0;
+	}
+
+	// Index buffer is 32-bit when flush has more vertices than 16-bit index can address.
+	static void glnvg__index(struct GLNVGcontext* gl, uint32_t _pos, int _index)
+	{
+		if (gl->tib.isIndex16)
+		{
+			( (uint16_t*)gl->tib.data)[_pos] = uint16_t(_index);
+		}
+		else
+		{
+			( (uint32_t*)gl->tib.data)[_pos] = uint32_t(_index);
+		}
+	}
+
+	static uint32_t glnvg__fan(struct GLNVGcontext* gl, uint32_t _pos, int _start, int _count)
+	{
+		for (int ii = 0, num = _count-2; ii < num; ++ii)
+		{
+			glnvg__index(gl, _pos+0, _start);
+			glnvg__index(gl, _pos+1, _start + ii + 1);
+			glnvg__index(gl, _pos+2, _start + ii + 2);
+			_pos += 3;
+		}
+
+		return _pos;
+	}
+
+	static uint32_t glnvg__strip(struct GLNVGcontext* gl, uint32_t _pos, int _start, int _count)
+	{
+		for (int ii = 0, num = _count-2; ii < num; ++ii)
+		{
+			// Keep strip winding, odd triangles have first two vertices swapped.
+			const int odd = ii & 1;
+			glnvg__index(gl, _pos+0, _start + ii + odd);
+			glnvg__index(gl, _pos+1, _start + ii + 1 - odd);
+			glnvg__index(gl, _pos+2, _start + ii + 2);
+			_pos += 3;
+		}
+
+		return _pos;
+	}
+
+	static uint32_t glnvg__list(struct GLNVGcontext* gl, uint32_t _pos, int _start, int _count)
+	{
+		for (int ii = 0, num = _count/3*3; ii < num; ++ii)
+		{
+			glnvg__index(gl, _pos + ii, _start + ii);
+		}
+
+		return _pos + _count/3*3;
+	}
+
+	static uint32_t glnvg__callIndexCount(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	{
+		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
+		uint32_t count = 0;
+
+		switch (call->type)
+		{
+		case GLNVG_FILL:
+		case GLNVG_CONVEXFILL:
+			for (int i = 0; i < call->pathCount; i++)
+			{
+				count += glnvg__triIndexCount(paths[i].fillCount);
+				count += gl->edgeAntiAlias ? glnvg__triIndexCount(paths[i].strokeCount) : 0;
+			}
+			count += GLNVG_FILL == call->type ? 6 : 0;
+			break;
+
+		case GLNVG_STROKE:
+			for (int i = 0; i < call->pathCount; i++)
+			{
+				count += glnvg__triIndexCount(paths[i].strokeCount);
+			}
+			break;
+
+		case GLNVG_TRIANGLES:
+			count += call->vertexCount/3*3;
+			break;
+		}
+
+		return count;
+	}
+
+	static void glnvg__submit(struct GLNVGcontext* gl, uint32_t startIndex, uint32_t numIndices)
 	{
-		uint32_t numTris = _count-2;
-		BX_ASSERT(_count >= 3, "less than one triangle");
-		BX_ASSERT(_start + ((numTris - 1) * 3) + 2 <= UINT16_MAX, "index overflow");
-		bgfx::TransientIndexBuffer tib;
-		bgfx::allocTransientIndexBuffer(&tib, numTris*3);
-		BX_ASSERT(tib.size == numTris*3*(tib.isIndex16 ? 2 : 4), "did not get enough room for indices");
+		bgfx::setVertexBuffer(0, &gl->tvb);
+		bgfx::setIndexBuffer(&gl->tib, startIndex, numIndices);
+		bgfx::setTexture(0, gl->s_tex, gl->th);
+		bgfx::submit(gl->viewId, gl->prog);
+	}
 
-		uint16_t* data = (uint16_t*)tib.data;
-		for (uint32_t ii = 0; ii < numTris; ++ii)
+	static void glnvg__submitBatch(struct GLNVGcontext* gl, struct GLNVGbatch* batch)
+	{
+		if (0 != batch->numIndices)
 		{
-			data[ii*3+0] = uint16_t(_start);
-			data[ii*3+1] = uint16_t(_start + ii + 1);
-			data[ii*3+2] = uint16_t(_start + ii + 2);
+			nvgRenderSetUniforms(gl, batch->uniformOffset, batch->image);
+			bgfx::setState(batch->state);
+			glnvg__submit(gl, batch->startIndex, batch->numIndices);
+			batch->numIndices = 0;
 		}
+	}
 
-		bgfx::setIndexBuffer(&tib);
+	static bool glnvg__canMerge(struct GLNVGcontext* gl, const struct GLNVGbatch* batch, const struct GLNVGcall* call, uint64_t state)
+	{
+		return batch->state == state
+			&& batch->image == call->image
+			&& 0 == bx::memCmp(
+				  nvg__fragUniformPtr(gl, batch->uniformOffset)
+				, nvg__fragUniformPtr(gl, call->uniformOffset)
+				, sizeof(struct GLNVGfragUniforms)
+				)
+			;
 	}
 
-	static void glnvg__fill(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	static uint32_t glnvg__fill(struct GLNVGcontext* gl, struct GLNVGcall* call, uint32_t indices)
 	{
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int i, npaths = call->pathCount;
@@ -582,29 +692,30 @@ namespace
 		// set bindpoint for solid loc
 		nvgRenderSetUniforms(gl, call->uniformOffset, 0);
 
+		// Stencil all paths with single draw.
+		uint32_t start = indices;
 		for (i = 0; i < npaths; i++)
 		{
-			if (2 < paths[i].fillCount)
-			{
-				bgfx::setState(0);
-				bgfx::setStencil(0
-					| BGFX_STENCIL_TEST_ALWAYS
-					| BGFX_STENCIL_FUNC_RMASK(0xff)
-					| BGFX_STENCIL_OP_FAIL_S_KEEP
-					| BGFX_STENCIL_OP_FAIL_Z_KEEP
-					| BGFX_STENCIL_OP_PASS_Z_INCR
-					, 0
-					| BGFX_STENCIL_TEST_ALWAYS
-					| BGFX_STENCIL_FUNC_RMASK(0xff)
-					| BGFX_STENCIL_OP_FAIL_S_KEEP
-					| BGFX_STENCIL_OP_FAIL_Z_KEEP
-					| BGFX_STENCIL_OP_PASS_Z_DECR
-					);
-				bgfx::setVertexBuffer(0, &gl->tvb);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				fan(paths[i].fillOffset, paths[i].fillCount);
-				bgfx::submit(gl->viewId, gl->prog);
-			}
+			indices = glnvg__fan(gl, indices, paths[i].fillOffset, paths[i].fillCount);
+		}
+
+		if (start != indices)
+		{
+			bgfx::setState(0);
+			bgfx::setStencil(0
+				| BGFX_STENCIL_TEST_ALWAYS
+				| BGFX_STENCIL_FUNC_RMASK(0xff)
+				| BGFX_STENCIL_OP_FAIL_S_KEEP
+				| BGFX_STENCIL_OP_FAIL_Z_KEEP
+				| BGFX_STENCIL_OP_PASS_Z_INCR
+				, 0
+				| BGFX_STENCIL_TEST_ALWAYS
+				| BGFX_STENCIL_FUNC_RMASK(0xff)
+				| BGFX_STENCIL_OP_FAIL_S_KEEP
+				| BGFX_STENCIL_OP_FAIL_Z_KEEP
+				| BGFX_STENCIL_OP_PASS_Z_DECR
+				);
+			glnvg__submit(gl, start, indices - start);
 		}
 
 		// Draw aliased off-pixels
@@ -613,11 +724,15 @@ namespace
 		if (gl->edgeAntiAlias)
 		{
 			// Draw fringes
+			start = indices;
 			for (i = 0; i < npaths; i++)
 			{
-				bgfx::setState(gl->state
-					| BGFX_STATE_PT_TRISTRIP
-					);
+				indices = glnvg__strip(gl, indices, paths[i].strokeOffset, paths[i].strokeCount);
+			}
+
+			if (start != indices)
+			{
+				bgfx::setState(gl->state);
 				bgfx::setStencil(0
 					| BGFX_STENCIL_TEST_EQUAL
 					| BGFX_STENCIL_FUNC_RMASK(0xff)
@@ -625,16 +740,15 @@ namespace
 					| BGFX_STENCIL_OP_FAIL_Z_KEEP
 					| BGFX_STENCIL_OP_PASS_Z_KEEP
 					);
-				bgfx::setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				bgfx::submit(gl->viewId, gl->prog);
+				glnvg__submit(gl, start, indices - start);
 			}
 		}
 
 		// Draw fill
+		start   = indices;
+		indices = glnvg__list(gl, indices, call->vertexOffset, call->vertexCount);
+
 		bgfx::setState(gl->state);
-		bgfx::setVertexBuffer(0, &gl->tvb, call->vertexOffset, call->vertexCount);
-		bgfx::setTexture(0, gl->s_tex, gl->th);
 		bgfx::setStencil(0
 				| BGFX_STENCIL_TEST_NOTEQUAL
 				| BGFX_STENCIL_FUNC_RMASK(0xff)
@@ -642,71 +756,49 @@ namespace
 				| BGFX_STENCIL_OP_FAIL_Z_ZERO
 				| BGFX_STENCIL_OP_PASS_Z_ZERO
 				);
-		bgfx::submit(gl->viewId, gl->prog);
+		glnvg__submit(gl, start, indices - start);
+
+		return indices;
 	}
 
-	static void glnvg__convexFill(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	static uint32_t glnvg__convexFill(struct GLNVGcontext* gl, struct GLNVGcall* call, uint32_t indices)
 	{
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int i, npaths = call->pathCount;
 
-		nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
-
+		// Fill and fringes are both triangle lists, so they share the draw.
 		for (i = 0; i < npaths; i++)
 		{
-			if (paths[i].fillCount == 0) continue;
-			bgfx::setState(gl->state);
-			bgfx::setVertexBuffer(0, &gl->tvb);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			fan(paths[i].fillOffset, paths[i].fillCount);
-			bgfx::submit(gl->viewId, gl->prog);
+			indices = glnvg__fan(gl, indices, paths[i].fillOffset, paths[i].fillCount);
 		}
 
 		if (gl->edgeAntiAlias)
 		{
-			// Draw fringes
 			for (i = 0; i < npaths; i++)
 			{
-				bgfx::setState(gl->state
-					| BGFX_STATE_PT_TRISTRIP
-					);
-				bgfx::setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-				bgfx::setTexture(0, gl->s_tex, gl->th);
-				bgfx::submit(gl->viewId, gl->prog);
+				indices = glnvg__strip(gl, indices, paths[i].strokeOffset, paths[i].strokeCount);
 			}
 		}
+
+		return indices;
 	}
 
-	static void glnvg__stroke(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	static uint32_t glnvg__stroke(struct GLNVGcontext* gl, struct GLNVGcall* call, uint32_t indices)
 	{
 		struct GLNVGpath* paths = &gl->paths[call->pathOffset];
 		int npaths = call->pathCount, i;
 
-		nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
-
-		// Draw Strokes
 		for (i = 0; i < npaths; i++)
 		{
-			bgfx::setState(gl->state
-				| BGFX_STATE_PT_TRISTRIP
-				);
-			bgfx::setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			bgfx::submit(gl->viewId, gl->prog);
+			indices = glnvg__strip(gl, indices, paths[i].strokeOffset, paths[i].strokeCount);
 		}
+
+		return indices;
 	}
 
-	static void glnvg__triangles(struct GLNVGcontext* gl, struct GLNVGcall* call)
+	static uint32_t glnvg__triangles(struct GLNVGcontext* gl, struct GLNVGcall* call, uint32_t indices)
 	{
-		if (3 <= call->vertexCount)
-		{
-			nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
-
-			bgfx::setState(gl->state);
-			bgfx::setVertexBuffer(0, &gl->tvb, call->vertexOffset, call->vertexCount);
-			bgfx::setTexture(0, gl->s_tex, gl->th);
-			bgfx::submit(gl->viewId, gl->prog);
-		}
+		return glnvg__list(gl, indices, call->vertexOffset, call->vertexCount);
 	}
 
 	static const uint64_t s_blend[] =
@@ -778,8 +870,41 @@ namespace
 
 			bx::memCopy(gl->tvb.data, gl->verts, gl->nverts * sizeof(struct NVGvertex) );
 
+			uint32_t numIndices = 0;
+			for (uint32_t ii = 0, num = gl->ncalls; ii < num; ++ii)
+			{
+				numIndices += glnvg__callIndexCount(gl, &gl->calls[ii]);
+			}
+
+			if (0 == numIndices)
+			{
+				goto _cleanup;
+			}
+
+			// Indices are relative to first vertex of the flush, 16-bit indices
+			// can't address more than 64K vertices. Without BGFX_CAPS_INDEX32
+			// flush is split before it gets there, see glnvg__flushIfNeeded.
+			const bool index32 = gl->nverts > UINT16_MAX;
+			BX_ASSERT(!index32 || 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INDEX32)
+				, "32-bit indices are not supported, flush must not exceed %d vertices."
+				, UINT16_MAX
+				);
+
+			if (numIndices > bgfx::getAvailTransientIndexBuffer(numIndices, index32) )
+			{
+				BX_WARN(false, "Dropping frame due to transient index buffer overflow (requested %d indices).", numIndices);
+				goto _cleanup;
+			}
+
+			bgfx::allocTransientIndexBuffer(&gl->tib, numIndices, index32);
+
 			bgfx::setUniform(gl->u_viewSize, gl->view);
 
+			// Consecutive calls without stencil, that use same blend, image and
+			// paint are merged into single indexed draw.
+			uint32_t indices = 0;
+			GLNVGbatch batch = {};
+
 			for (uint32_t ii = 0, num = gl->ncalls; ii < num; ++ii)
 			{
 				struct GLNVGcall* call = &gl->calls[ii];
@@ -788,25 +913,47 @@ namespace
 					| BGFX_STATE_WRITE_RGB
 					| BGFX_STATE_WRITE_A
 					;
-				switch (call->type)
+
+				if (GLNVG_FILL == call->type)
 				{
-				case GLNVG_FILL:
-					glnvg__fill(gl, call);
-					break;
+					glnvg__submitBatch(gl, &batch);
+					indices = glnvg__fill(gl, call, indices);
+					continue;
+				}
 
+				if (0 != batch.numIndices
+				&&  !glnvg__canMerge(gl, &batch, call, gl->state) )
+				{
+					glnvg__submitBatch(gl, &batch);
+				}
+
+				if (0 == batch.numIndices)
+				{
+					batch.state         = gl->state;
+					batch.image         = call->image;
+					batch.uniformOffset = call->uniformOffset;
+					batch.startIndex    = indices;
+				}
+
+				switch (call->type)
+				{
 				case GLNVG_CONVEXFILL:
-					glnvg__convexFill(gl, call);
+					indices = glnvg__convexFill(gl, call, indices);
 					break;
 
 				case GLNVG_STROKE:
-					glnvg__stroke(gl, call);
+					indices = glnvg__stroke(gl, call, indices);
 					break;
 
 				case GLNVG_TRIANGLES:
-					glnvg__triangles(gl, call);
+					indices = glnvg__triangles(gl, call, indices);
 					break;
 				}
+
+				batch.numIndices = indices - batch.startIndex;
 			}
+
+			glnvg__submitBatch(gl, &batch);
 		}
 
 _cleanup:
@@ -865,12 +1012,12 @@ _cleanup:
 		// Before calling this function, make sure that glnvg__flushIfNeeded()
 		// is called, before allocating the NVGCall.
 		int ret = 0;
-		BX_ASSERT(gl->nverts + n <= UINT16_MAX, "index overflow is imminent, please flush.");
+		BX_ASSERT(gl->nverts + n <= gl->maxverts, "index overflow is imminent, please flush.");
 		if (gl->nverts+n > gl->cverts)
 		{
 			NVGvertex* verts;
 			int cverts = glnvg__maxi(gl->nverts + n, 4096) + gl->cverts/2; // 1.5x Overallocate
-			cverts = glnvg__mini(cverts, UINT16_MAX);
+			cverts = glnvg__mini(cverts, gl->maxverts);
 			verts = (NVGvertex*)bx::realloc(gl->allocator, gl->verts, sizeof(NVGvertex) * cverts);
 			if (verts == NULL) return -1;
 			gl->verts = verts;
@@ -903,7 +1050,7 @@ _cleanup:
 	}
 
 	static void glnvg__flushIfNeeded(struct GLNVGcontext *gl, int nverts) {
-		if (gl->nverts + nverts > UINT16_MAX) {
+		if (gl->nverts + nverts > gl->maxverts) {
 			nvgRenderFlush(gl);
 		}
 	}
@@ -1145,6 +1292,14 @@ NVGcontext* nvgCreate(int32_t _edgeaa, bgfx::ViewId _viewId, bx::AllocatorI* _al
 	gl->edgeAntiAlias = _edgeaa;
 	gl->viewId        = _viewId;
 
+	// Calls are merged into one draw per flush only as long as flush vertices can be
+	// indexed. With 32-bit indices flush is limited by transient vertex buffer size,
+	// otherwise it's split at 16-bit index range.
+	gl->maxverts = 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INDEX32)
+		? int(bx::min<uint32_t>(bgfx::getCaps()->limits.transientVbSize / uint32_t(sizeof(NVGvertex) ), INT32_MAX) )
+		: UINT16_MAX
+		;
+
 	ctx = nvgCreateInternal(&params);
 	if (ctx == NULL) goto error;
 
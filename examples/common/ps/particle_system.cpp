@@ -12,6 +12,10 @@
 
 #include <bx/easing.h>
 #include <bx/handlealloc.h>
+#include <bx/simd_t.h>
+#include <bx/sort.h>
+
+#include "../workerpool.h"
 
 #include "vs_particle.bin.h"
 #include "fs_particle.bin.h"
@@ -96,26 +100,37 @@ void EmitterUniforms::reset()
 
 namespace ps
 {
-	struct Particle
+	/// Particle data is stored as structure of arrays, one stream per particle
+	/// attribute. Streams are padded to multiple of 4 so they can be processed
+	/// 4 particles at the time.
+	struct ParticleStream
 	{
-		bx::Vec3 start;
-		bx::Vec3 end[2];
-		float blendStart;
-		float blendEnd;
-		float scaleStart;
-		float scaleEnd;
-
-		uint32_t rgba[5];
-
-		float life;
-		float lifeSpan;
+		enum Enum
+		{
+			Life,
+			LifeInv,
+			StartX,
+			StartY,
+			StartZ,
+			End0X,
+			End0Y,
+			End0Z,
+			End1X,
+			End1Y,
+			End1Z,
+			BlendStart,
+			BlendEnd,
+			ScaleStart,
+			ScaleEnd,
+
+			Count
+		};
 	};
 
-	struct ParticleSort
+	inline bx::simd128_t simdLerp(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _t)
 	{
-		float    dist;
-		uint32_t idx;
-	};
+		return bx::simd_add(_a, bx::simd_mul(bx::simd_sub(_b, _a), _t) );
+	}
 
 	inline uint32_t toAbgr(const float* _rgba)
 	{
@@ -197,21 +212,29 @@ namespace ps
 
 		void update(float _dt)
 		{
-			uint32_t num = m_num;
-			for (uint32_t ii = 0; ii < num; ++ii)
+			float*       life    = m_stream[ParticleStream::Life];
+			const float* lifeInv = m_stream[ParticleStream::LifeInv];
+
+			const bx::simd128_t dt = bx::simd_splat(_dt);
+
+			for (uint32_t ii = 0, num = m_num; ii < num; ii += 4)
 			{
-				Particle& particle = m_particles[ii];
-				particle.life += _dt * 1.0f/particle.lifeSpan;
+				const bx::simd128_t tt  = bx::simd_ld(&life[ii]);
+				const bx::simd128_t inv = bx::simd_ld(&lifeInv[ii]);
+				bx::simd_st(&life[ii], bx::simd_add(tt, bx::simd_mul(dt, inv) ) );
+			}
 
-				if (particle.life > 1.0f)
+			uint32_t num = m_num;
+			for (uint32_t ii = 0; ii < num;)
+			{
+				if (life[ii] > 1.0f)
 				{
-					if (ii != num-1)
-					{
-						bx::memCopy(&particle, &m_particles[num-1], sizeof(Particle) );
-						--ii;
-					}
-
 					--num;
+					copy(ii, num);
+				}
+				else
+				{
+					++ii;
 				}
 			}
 
@@ -223,6 +246,19 @@ namespace ps
 			}
 		}
 
+		void copy(uint32_t _dst, uint32_t _src)
+		{
+			if (_dst != _src)
+			{
+				for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+				{
+					m_stream[ii][_dst] = m_stream[ii][_src];
+				}
+
+				bx::memCopy(&m_rgba[_dst*5], &m_rgba[_src*5], 5*sizeof(uint32_t) );
+			}
+		}
+
 		void spawn(float _dt)
 		{
 			float mtx[16];
@@ -245,8 +281,7 @@ namespace ps
 				; ++ii
 				)
 			{
-				Particle& particle = m_particles[m_num];
-				m_num++;
+				const uint32_t idx = m_num++;
 
 				bx::Vec3 pos(bx::InitNone);
 				switch (m_shape)
@@ -301,121 +336,263 @@ namespace ps
 				const bx::Vec3 tmp1 = bx::mul(dir, endOffset);
 				const bx::Vec3 end  = bx::add(tmp1, start);
 
-				particle.life = time;
-				particle.lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				const float lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::Life   ][idx] = time;
+				m_stream[ParticleStream::LifeInv][idx] = 1.0f/lifeSpan;
 
-				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(particle.lifeSpan), 0.0f };
+				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(lifeSpan), 0.0f };
 
-				particle.start  = bx::mul(start, mtx);
-				particle.end[0] = bx::mul(end,   mtx);
-				particle.end[1] = bx::add(particle.end[0], gravity);
+				const bx::Vec3 start0 = bx::mul(start, mtx);
+				const bx::Vec3 end0   = bx::mul(end,   mtx);
+				const bx::Vec3 end1   = bx::add(end0,  gravity);
 
-				bx::memCopy(particle.rgba, m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
+				m_stream[ParticleStream::StartX][idx] = start0.x;
+				m_stream[ParticleStream::StartY][idx] = start0.y;
+				m_stream[ParticleStream::StartZ][idx] = start0.z;
+				m_stream[ParticleStream::End0X ][idx] = end0.x;
+				m_stream[ParticleStream::End0Y ][idx] = end0.y;
+				m_stream[ParticleStream::End0Z ][idx] = end0.z;
+				m_stream[ParticleStream::End1X ][idx] = end1.x;
+				m_stream[ParticleStream::End1Y ][idx] = end1.y;
+				m_stream[ParticleStream::End1Z ][idx] = end1.z;
 
-				particle.blendStart = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
-				particle.blendEnd   = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+				bx::memCopy(&m_rgba[idx*5], m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
 
-				particle.scaleStart = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
-				particle.scaleEnd   = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
+				m_stream[ParticleStream::BlendStart][idx] = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::BlendEnd  ][idx] = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+
+				m_stream[ParticleStream::ScaleStart][idx] = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::ScaleEnd  ][idx] = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
 
 				time += timePerParticle;
 			}
 		}
 
-		uint32_t render(const float _uv[4], const float* _mtxView, const bx::Vec3& _eye, uint32_t _first, uint32_t _max, ParticleSort* _outSort, PosColorTexCoord0Vertex* _outVertices)
+		void render(
+			  const float _uv[4]
+			, const float* _mtxView
+			, const bx::Vec3& _eye
+			, uint32_t _first
+			, uint32_t _num
+			, uint32_t* _outKeys
+			, uint32_t* _outValues
+			, PosColorTexCoord0Vertex* _outVertices
+			)
 		{
 			bx::EaseFn easeRgba  = bx::getEaseFunc(m_uniforms.m_easeRgba);
 			bx::EaseFn easePos   = bx::getEaseFunc(m_uniforms.m_easePos);
 			bx::EaseFn easeBlend = bx::getEaseFunc(m_uniforms.m_easeBlend);
 			bx::EaseFn easeScale = bx::getEaseFunc(m_uniforms.m_easeScale);
 
-			bx::Aabb aabb =
+			const float* life       = m_stream[ParticleStream::Life];
+			const float* startX     = m_stream[ParticleStream::StartX];
+			const float* startY     = m_stream[ParticleStream::StartY];
+			const float* startZ     = m_stream[ParticleStream::StartZ];
+			const float* end0X      = m_stream[ParticleStream::End0X];
+			const float* end0Y      = m_stream[ParticleStream::End0Y];
+			const float* end0Z      = m_stream[ParticleStream::End0Z];
+			const float* end1X      = m_stream[ParticleStream::End1X];
+			const float* end1Y      = m_stream[ParticleStream::End1Y];
+			const float* end1Z      = m_stream[ParticleStream::End1Z];
+			const float* blendStart = m_stream[ParticleStream::BlendStart];
+			const float* blendEnd   = m_stream[ParticleStream::BlendEnd];
+			const float* scaleStart = m_stream[ParticleStream::ScaleStart];
+			const float* scaleEnd   = m_stream[ParticleStream::ScaleEnd];
+
+			const bx::simd128_t eyeX = bx::simd_splat(_eye.x);
+			const bx::simd128_t eyeY = bx::simd_splat(_eye.y);
+			const bx::simd128_t eyeZ = bx::simd_splat(_eye.z);
+
+			const bx::simd128_t uX = bx::simd_splat(_mtxView[0]);
+			const bx::simd128_t uY = bx::simd_splat(_mtxView[4]);
+			const bx::simd128_t uZ = bx::simd_splat(_mtxView[8]);
+			const bx::simd128_t vX = bx::simd_splat(_mtxView[1]);
+			const bx::simd128_t vY = bx::simd_splat(_mtxView[5]);
+			const bx::simd128_t vZ = bx::simd_splat(_mtxView[9]);
+
+			// Quad corners are pos +/- udir +/- vdir, so their bounds are pos +/- extent*scale.
+			const bx::simd128_t extX = bx::simd_splat(bx::abs(_mtxView[0]) + bx::abs(_mtxView[1]) );
+			const bx::simd128_t extY = bx::simd_splat(bx::abs(_mtxView[4]) + bx::abs(_mtxView[5]) );
+			const bx::simd128_t extZ = bx::simd_splat(bx::abs(_mtxView[8]) + bx::abs(_mtxView[9]) );
+
+			const bx::simd128_t lane = bx::simd_ild(0, 1, 2, 3);
+			const bx::simd128_t inf  = bx::simd_splat( bx::kFloatInfinity);
+			const bx::simd128_t ninf = bx::simd_splat(-bx::kFloatInfinity);
+
+			bx::simd128_t minX = inf;
+			bx::simd128_t minY = inf;
+			bx::simd128_t minZ = inf;
+			bx::simd128_t maxX = ninf;
+			bx::simd128_t maxY = ninf;
+			bx::simd128_t maxZ = ninf;
+
+			for (uint32_t ii = 0; ii < _num; ii += 4)
 			{
-				{  bx::kFloatInfinity,  bx::kFloatInfinity,  bx::kFloatInfinity },
-				{ -bx::kFloatInfinity, -bx::kFloatInfinity, -bx::kFloatInfinity },
-			};
+				const uint32_t numLanes = bx::min<uint32_t>(_num - ii, 4);
 
-			for (uint32_t jj = 0, num = m_num, current = _first
-				; jj < num && current < _max
-				; ++jj, ++current
-				)
-			{
-				const Particle& particle = m_particles[jj];
-
-				const float ttPos   = easePos(particle.life);
-				const float ttScale = easeScale(particle.life);
-				const float ttBlend = bx::clamp(easeBlend(particle.life), 0.0f, 1.0f);
-				const float ttRgba  = bx::clamp(easeRgba(particle.life),  0.0f, 1.0f);
-
-				const bx::Vec3 p0  = bx::lerp(particle.start,  particle.end[0], ttPos);
-				const bx::Vec3 p1  = bx::lerp(particle.end[0], particle.end[1], ttPos);
-				const bx::Vec3 pos = bx::lerp(p0, p1, ttPos);
-
-				ParticleSort& sort = _outSort[current];
-				const bx::Vec3 tmp0 = bx::sub(_eye, pos);
-				sort.dist = bx::length(tmp0);
-				sort.idx  = current;
-
-				uint32_t idx = uint32_t(ttRgba*4);
-				float ttmod = bx::mod(ttRgba, 0.25f)/0.25f;
-				uint32_t rgbaStart = particle.rgba[idx];
-				uint32_t rgbaEnd   = particle.rgba[idx+1];
-
-				float rr = bx::lerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
-				float gg = bx::lerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
-				float bb = bx::lerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
-				float aa = bx::lerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
-
-				float blend = bx::lerp(particle.blendStart, particle.blendEnd, ttBlend);
-				float scale = bx::lerp(particle.scaleStart, particle.scaleEnd, ttScale);
-
-				uint32_t abgr = toAbgr(rr, gg, bb, aa);
-
-				const bx::Vec3 udir = { _mtxView[0]*scale, _mtxView[4]*scale, _mtxView[8]*scale };
-				const bx::Vec3 vdir = { _mtxView[1]*scale, _mtxView[5]*scale, _mtxView[9]*scale };
-
-				PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
-
-				const bx::Vec3 ul = bx::sub(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, ul);
-				aabbExpand(aabb, ul);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 ur = bx::sub(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, ur);
-				aabbExpand(aabb, ur);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 br = bx::add(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, br);
-				aabbExpand(aabb, br);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 bl = bx::add(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, bl);
-				aabbExpand(aabb, bl);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
+				BX_ALIGN_DECL(16, float) ttPos[4];
+				BX_ALIGN_DECL(16, float) ttBlend[4];
+				BX_ALIGN_DECL(16, float) ttScale[4];
+				float ttRgba[4];
+
+				for (uint32_t jj = 0; jj < 4; ++jj)
+				{
+					// Lanes past the last particle repeat it, their results are discarded.
+					const float tt = life[ii + bx::min(jj, numLanes-1)];
+					ttPos[jj]   = easePos(tt);
+					ttScale[jj] = easeScale(tt);
+					ttBlend[jj] = bx::clamp(easeBlend(tt), 0.0f, 1.0f);
+					ttRgba[jj]  = bx::clamp(easeRgba(tt),  0.0f, 1.0f);
+				}
+
+				const bx::simd128_t tPos = bx::simd_ld(ttPos);
+
+				const bx::simd128_t e0X = bx::simd_ld(&end0X[ii]);
+				const bx::simd128_t e0Y = bx::simd_ld(&end0Y[ii]);
+				const bx::simd128_t e0Z = bx::simd_ld(&end0Z[ii]);
+
+				const bx::simd128_t posX = simdLerp(
+					  simdLerp(bx::simd_ld(&startX[ii]), e0X, tPos)
+					, simdLerp(e0X, bx::simd_ld(&end1X[ii]), tPos)
+					, tPos
+					);
+				const bx::simd128_t posY = simdLerp(
+					  simdLerp(bx::simd_ld(&startY[ii]), e0Y, tPos)
+					, simdLerp(e0Y, bx::simd_ld(&end1Y[ii]), tPos)
+					, tPos
+					);
+				const bx::simd128_t posZ = simdLerp(
+					  simdLerp(bx::simd_ld(&startZ[ii]), e0Z, tPos)
+					, simdLerp(e0Z, bx::simd_ld(&end1Z[ii]), tPos)
+					, tPos
+					);
+
+				const bx::simd128_t dX = bx::simd_sub(eyeX, posX);
+				const bx::simd128_t dY = bx::simd_sub(eyeY, posY);
+				const bx::simd128_t dZ = bx::simd_sub(eyeZ, posZ);
+				const bx::simd128_t distSq = bx::simd_add(bx::simd_add(bx::simd_mul(dX, dX), bx::simd_mul(dY, dY) ), bx::simd_mul(dZ, dZ) );
+
+				const bx::simd128_t blend = simdLerp(bx::simd_ld(&blendStart[ii]), bx::simd_ld(&blendEnd[ii]), bx::simd_ld(ttBlend) );
+				const bx::simd128_t scale = simdLerp(bx::simd_ld(&scaleStart[ii]), bx::simd_ld(&scaleEnd[ii]), bx::simd_ld(ttScale) );
+
+				const bx::simd128_t usX = bx::simd_mul(uX, scale);
+				const bx::simd128_t usY = bx::simd_mul(uY, scale);
+				const bx::simd128_t usZ = bx::simd_mul(uZ, scale);
+				const bx::simd128_t vsX = bx::simd_mul(vX, scale);
+				const bx::simd128_t vsY = bx::simd_mul(vY, scale);
+				const bx::simd128_t vsZ = bx::simd_mul(vZ, scale);
+
+				const bx::simd128_t mX = bx::simd_sub(posX, usX);
+				const bx::simd128_t mY = bx::simd_sub(posY, usY);
+				const bx::simd128_t mZ = bx::simd_sub(posZ, usZ);
+				const bx::simd128_t pX = bx::simd_add(posX, usX);
+				const bx::simd128_t pY = bx::simd_add(posY, usY);
+				const bx::simd128_t pZ = bx::simd_add(posZ, usZ);
+
+				BX_ALIGN_DECL(16, float) corner[4][3][4];
+				bx::simd_st(corner[0][0], bx::simd_sub(mX, vsX) );
+				bx::simd_st(corner[0][1], bx::simd_sub(mY, vsY) );
+				bx::simd_st(corner[0][2], bx::simd_sub(mZ, vsZ) );
+				bx::simd_st(corner[1][0], bx::simd_sub(pX, vsX) );
+				bx::simd_st(corner[1][1], bx::simd_sub(pY, vsY) );
+				bx::simd_st(corner[1][2], bx::simd_sub(pZ, vsZ) );
+				bx::simd_st(corner[2][0], bx::simd_add(pX, vsX) );
+				bx::simd_st(corner[2][1], bx::simd_add(pY, vsY) );
+				bx::simd_st(corner[2][2], bx::simd_add(pZ, vsZ) );
+				bx::simd_st(corner[3][0], bx::simd_add(mX, vsX) );
+				bx::simd_st(corner[3][1], bx::simd_add(mY, vsY) );
+				bx::simd_st(corner[3][2], bx::simd_add(mZ, vsZ) );
+
+				const bx::simd128_t mask = bx::simd_icmplt(lane, bx::simd_isplat(numLanes) );
+				const bx::simd128_t eX = bx::simd_mul(extX, scale);
+				const bx::simd128_t eY = bx::simd_mul(extY, scale);
+				const bx::simd128_t eZ = bx::simd_mul(extZ, scale);
+				const bx::simd128_t loX = bx::simd_min(bx::simd_sub(posX, eX), bx::simd_add(posX, eX) );
+				const bx::simd128_t loY = bx::simd_min(bx::simd_sub(posY, eY), bx::simd_add(posY, eY) );
+				const bx::simd128_t loZ = bx::simd_min(bx::simd_sub(posZ, eZ), bx::simd_add(posZ, eZ) );
+				const bx::simd128_t hiX = bx::simd_max(bx::simd_sub(posX, eX), bx::simd_add(posX, eX) );
+				const bx::simd128_t hiY = bx::simd_max(bx::simd_sub(posY, eY), bx::simd_add(posY, eY) );
+				const bx::simd128_t hiZ = bx::simd_max(bx::simd_sub(posZ, eZ), bx::simd_add(posZ, eZ) );
+				minX = bx::simd_min(minX, bx::simd_selb(mask, loX, inf) );
+				minY = bx::simd_min(minY, bx::simd_selb(mask, loY, inf) );
+				minZ = bx::simd_min(minZ, bx::simd_selb(mask, loZ, inf) );
+				maxX = bx::simd_max(maxX, bx::simd_selb(mask, hiX, ninf) );
+				maxY = bx::simd_max(maxY, bx::simd_selb(mask, hiY, ninf) );
+				maxZ = bx::simd_max(maxZ, bx::simd_selb(mask, hiZ, ninf) );
+
+				BX_ALIGN_DECL(16, float) dist[4];
+				BX_ALIGN_DECL(16, float) blendOut[4];
+				bx::simd_st(dist,     distSq);
+				bx::simd_st(blendOut, blend);
+
+				for (uint32_t jj = 0; jj < numLanes; ++jj)
+				{
+					const uint32_t current = _first + ii + jj;
+
+					// Sort back to front, keys are inverted so that radix sort
+					// produces descending distance order.
+					_outKeys[current]   = ~bx::floatFlip(bx::floatToBits(dist[jj]) );
+					_outValues[current] = current;
+
+					const float tt4  = ttRgba[jj]*4.0f;
+					const uint32_t idx = bx::min<uint32_t>(uint32_t(tt4), 3);
+					const float ttmod  = tt4 - float(idx);
+
+					const uint32_t* rgba = &m_rgba[(ii + jj)*5];
+					const uint8_t* rgbaStart = (const uint8_t*)&rgba[idx];
+					const uint8_t* rgbaEnd   = (const uint8_t*)&rgba[idx+1];
+
+					const float rr = bx::lerp(rgbaStart[0], rgbaEnd[0], ttmod)/255.0f;
+					const float gg = bx::lerp(rgbaStart[1], rgbaEnd[1], ttmod)/255.0f;
+					const float bb = bx::lerp(rgbaStart[2], rgbaEnd[2], ttmod)/255.0f;
+					const float aa = bx::lerp(rgbaStart[3], rgbaEnd[3], ttmod)/255.0f;
+
+					const uint32_t abgr = toAbgr(rr, gg, bb, aa);
+
+					static const uint8_t s_uvIdx[4][2] =
+					{
+						{ 0, 1 },
+						{ 2, 1 },
+						{ 2, 3 },
+						{ 0, 3 },
+					};
+
+					PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
+
+					for (uint32_t kk = 0; kk < 4; ++kk, ++vertex)
+					{
+						vertex->m_x     = corner[kk][0][jj];
+						vertex->m_y     = corner[kk][1][jj];
+						vertex->m_z     = corner[kk][2][jj];
+						vertex->m_abgr  = abgr;
+						vertex->m_u     = _uv[s_uvIdx[kk][0] ];
+						vertex->m_v     = _uv[s_uvIdx[kk][1] ];
+						vertex->m_blend = blendOut[jj];
+					}
+				}
 			}
 
-			m_aabb = aabb;
+			BX_ALIGN_DECL(16, float) bounds[6][4];
+			bx::simd_st(bounds[0], minX);
+			bx::simd_st(bounds[1], minY);
+			bx::simd_st(bounds[2], minZ);
+			bx::simd_st(bounds[3], maxX);
+			bx::simd_st(bounds[4], maxY);
+			bx::simd_st(bounds[5], maxZ);
 
-			return m_num;
+			m_aabb =
+			{
+				{
+					bx::min(bounds[0][0], bounds[0][1], bounds[0][2], bounds[0][3]),
+					bx::min(bounds[1][0], bounds[1][1], bounds[1][2], bounds[1][3]),
+					bx::min(bounds[2][0], bounds[2][1], bounds[2][2], bounds[2][3]),
+				},
+				{
+					bx::max(bounds[3][0], bounds[3][1], bounds[3][2], bounds[3][3]),
+					bx::max(bounds[4][0], bounds[4][1], bounds[4][2], bounds[4][3]),
+					bx::max(bounds[5][0], bounds[5][1], bounds[5][2], bounds[5][3]),
+				},
+			};
 		}
 
 		EmitterShape::Enum     m_shape;
@@ -427,21 +604,31 @@ namespace ps
 
 		bx::Aabb m_aabb;
 
-		Particle* m_particles;
-		uint32_t m_num;
-		uint32_t m_max;
+		float*    m_stream[ParticleStream::Count];
+		uint32_t* m_rgba;
+		uint32_t  m_num;
+		uint32_t  m_max;
 	};
 
-	static int32_t particleSortFn(const void* _lhs, const void* _rhs)
+	template<typename Ty>
+	static void writeIndices(Ty* _indices, const uint32_t* _particle, uint32_t _num)
 	{
-		const ParticleSort& lhs = *(const ParticleSort*)_lhs;
-		const ParticleSort& rhs = *(const ParticleSort*)_rhs;
-		return lhs.dist > rhs.dist ? -1 : 1;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			Ty* index = &_indices[ii*6];
+			const Ty idx = Ty(_particle[ii]*4);
+			index[0] = idx+0;
+			index[1] = idx+1;
+			index[2] = idx+2;
+			index[3] = idx+2;
+			index[4] = idx+3;
+			index[5] = idx+0;
+		}
 	}
 
 	struct ParticleSystem
 	{
-		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+		void init(uint16_t _maxEmitters, uint16_t _numThreads, bx::AllocatorI* _allocator)
 		{
 			m_allocator = _allocator;
 
@@ -458,6 +645,8 @@ namespace ps
 
 			m_num = 0;
 
+			m_workerPool.init(_numThreads, "ps");
+
 			s_texColor = bgfx::createUniform("s_texColor", bgfx::UniformType::Sampler);
 			m_texture  = bgfx::createTexture2D(
 				  SPRITE_TEXTURE_SIZE
@@ -477,6 +666,8 @@ namespace ps
 
 		void shutdown()
 		{
+			m_workerPool.shutdown();
+
 			bgfx::destroy(m_particleProgram);
 			bgfx::destroy(m_texture);
 			bgfx::destroy(s_texColor);
@@ -514,20 +705,74 @@ namespace ps
 			m_sprite.destroy(_handle);
 		}
 
+		struct UpdateTask
+		{
+			ParticleSystem* ps;
+			float dt;
+		};
+
+		static void updateTaskFn(void* _userData, uint32_t _idx, uint32_t /*_num*/)
+		{
+			UpdateTask& task = *(UpdateTask*)_userData;
+			ParticleSystem& ps = *task.ps;
+
+			const uint16_t idx = ps.m_emitterAlloc->getHandleAt(uint16_t(_idx) );
+			ps.m_emitter[idx].update(task.dt);
+		}
+
 		void update(float _dt)
 		{
+			const uint16_t numEmitters = m_emitterAlloc->getNumHandles();
+
+			UpdateTask task = { this, _dt };
+			m_workerPool.run(updateTaskFn, &task, numEmitters);
+
 			uint32_t numParticles = 0;
-			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
+			for (uint16_t ii = 0; ii < numEmitters; ++ii)
 			{
 				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-				Emitter& emitter = m_emitter[idx];
-				emitter.update(_dt);
-				numParticles += emitter.m_num;
+				numParticles += m_emitter[idx].m_num;
 			}
 
 			m_num = numParticles;
 		}
 
+		struct RenderTask
+		{
+			ParticleSystem* ps;
+			const float* mtxView;
+			bx::Vec3 eye;
+			const uint32_t* first;
+			uint32_t max;
+			uint32_t* keys;
+			uint32_t* values;
+			PosColorTexCoord0Vertex* vertices;
+		};
+
+		static void renderTaskFn(void* _userData, uint32_t _idx, uint32_t /*_num*/)
+		{
+			RenderTask& task = *(RenderTask*)_userData;
+			ParticleSystem& ps = *task.ps;
+
+			const uint16_t idx = ps.m_emitterAlloc->getHandleAt(uint16_t(_idx) );
+			Emitter& emitter = ps.m_emitter[idx];
+
+			const uint32_t first = task.first[_idx];
+			const uint32_t num   = bx::min(emitter.m_num, task.max - first);
+
+			const Pack2D& pack = ps.m_sprite.get(emitter.m_uniforms.m_handle);
+			const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
+			const float uv[4] =
+			{
+				 pack.m_x                  * invTextureSize,
+				 pack.m_y                  * invTextureSize,
+				(pack.m_x + pack.m_width ) * invTextureSize,
+				(pack.m_y + pack.m_height) * invTextureSize,
+			};
+
+			emitter.render(uv, task.mtxView, task.eye, first, num, task.keys, task.values, task.vertices);
+		}
+
 		void render(uint8_t _view, const float* _mtxView, const bx::Vec3& _eye)
 		{
 			if (0 != m_num)
@@ -535,8 +780,14 @@ namespace ps
 				bgfx::TransientVertexBuffer tvb;
 				bgfx::TransientIndexBuffer tib;
 
-				const uint32_t numVertices = bgfx::getAvailTransientVertexBuffer(m_num*4, PosColorTexCoord0Vertex::ms_layout);
-				const uint32_t numIndices  = bgfx::getAvailTransientIndexBuffer(m_num*6);
+				// 16-bit indices can address only 16384 particles.
+				const bool index32 = m_num*4 > UINT16_MAX+1
+					&& 0 != (bgfx::getCaps()->supported & BGFX_CAPS_INDEX32)
+					;
+				const uint32_t num = index32 ? m_num : bx::min<uint32_t>(m_num, (UINT16_MAX+1)/4);
+
+				const uint32_t numVertices = bgfx::getAvailTransientVertexBuffer(num*4, PosColorTexCoord0Vertex::ms_layout);
+				const uint32_t numIndices  = bgfx::getAvailTransientIndexBuffer(num*6, index32);
 				const uint32_t max = bx::uint32_min(numVertices/4, numIndices/6);
 				BX_WARN(m_num == max
 					, "Truncating transient buffer for particles to maximum available (requested %d, available %d)."
@@ -551,51 +802,41 @@ namespace ps
 						, max*4
 						, &tib
 						, max*6
+						, index32
 						);
 					PosColorTexCoord0Vertex* vertices = (PosColorTexCoord0Vertex*)tvb.data;
 
-					ParticleSort* particleSort = (ParticleSort*)bx::alloc(m_allocator, max*sizeof(ParticleSort) );
+					const uint16_t numEmitters = m_emitterAlloc->getNumHandles();
+
+					uint32_t* keys       = (uint32_t*)bx::alloc(m_allocator, (max*4 + numEmitters)*sizeof(uint32_t) );
+					uint32_t* tempKeys   = &keys[max];
+					uint32_t* values     = &keys[max*2];
+					uint32_t* tempValues = &keys[max*3];
+					uint32_t* first      = &keys[max*4];
 
 					uint32_t pos = 0;
-					for (uint16_t ii = 0, numEmitters = m_emitterAlloc->getNumHandles(); ii < numEmitters; ++ii)
+					for (uint16_t ii = 0; ii < numEmitters; ++ii)
 					{
 						const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-						Emitter& emitter = m_emitter[idx];
-
-						const Pack2D& pack = m_sprite.get(emitter.m_uniforms.m_handle);
-						const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
-						const float uv[4] =
-						{
-							 pack.m_x                  * invTextureSize,
-							 pack.m_y                  * invTextureSize,
-							(pack.m_x + pack.m_width ) * invTextureSize,
-							(pack.m_y + pack.m_height) * invTextureSize,
-						};
-
-						pos += emitter.render(uv, _mtxView, _eye, pos, max, particleSort, vertices);
+						first[ii] = pos;
+						pos = bx::min(pos + m_emitter[idx].m_num, max);
 					}
 
-					qsort(particleSort
-						, max
-						, sizeof(ParticleSort)
-						, particleSortFn
-						);
+					RenderTask task = { this, _mtxView, _eye, first, max, keys, values, vertices };
+					m_workerPool.run(renderTaskFn, &task, numEmitters);
 
-					uint16_t* indices = (uint16_t*)tib.data;
-					for (uint32_t ii = 0; ii < max; ++ii)
+					bx::radixSort(keys, tempKeys, values, tempValues, max);
+
+					if (index32)
+					{
+						writeIndices( (uint32_t*)tib.data, values, max);
+					}
+					else
 					{
-						const ParticleSort& sort = particleSort[ii];
-						uint16_t* index = &indices[ii*6];
-						uint16_t idx = (uint16_t)sort.idx;
-						index[0] = idx*4+0;
-						index[1] = idx*4+1;
-						index[2] = idx*4+2;
-						index[3] = idx*4+2;
-						index[4] = idx*4+3;
-						index[5] = idx*4+0;
+						writeIndices( (uint16_t*)tib.data, values, max);
 					}
 
-					bx::free(m_allocator, particleSort);
+					bx::free(m_allocator, keys);
 
 					bgfx::setState(0
 						| BGFX_STATE_WRITE_RGB
@@ -675,6 +916,8 @@ namespace ps
 		bgfx::TextureHandle m_texture;
 		bgfx::ProgramHandle m_particleProgram;
 
+		WorkerPool m_workerPool;
+
 		uint32_t m_num;
 	};
 
@@ -687,22 +930,39 @@ namespace ps
 		m_shape     = _shape;
 		m_direction = _direction;
 		m_max       = _maxParticles;
-		m_particles = (Particle*)bx::alloc(s_ctx.m_allocator, m_max*sizeof(Particle) );
+
+		// All streams live in single allocation, each stream is padded to
+		// multiple of 4 particles.
+		const uint32_t maxAligned = bx::alignUp(bx::max(m_max, 1u), 4);
+		uint8_t* data = (uint8_t*)bx::alignedAlloc(
+			  s_ctx.m_allocator
+			, maxAligned*(ParticleStream::Count*sizeof(float) + 5*sizeof(uint32_t) )
+			, 16
+			);
+
+		for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+		{
+			m_stream[ii] = (float*)data;
+			data += maxAligned*sizeof(float);
+		}
+
+		m_rgba = (uint32_t*)data;
 	}
 
 	void Emitter::destroy()
 	{
-		bx::free(s_ctx.m_allocator, m_particles);
-		m_particles = NULL;
+		bx::alignedFree(s_ctx.m_allocator, m_stream[0], 16);
+		bx::memSet(m_stream, 0, sizeof(m_stream) );
+		m_rgba = NULL;
 	}
 
 } // namespace ps
 
 using namespace ps;
 
-void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator, uint16_t _numThreads)
 {
-	s_ctx.init(_maxEmitters, _allocator);
+	s_ctx.init(_maxEmitters, _numThreads, _allocator);
 }
 
 void psShutdown()
@@ -745,6 +1005,11 @@ void psUpdate(float _dt)
 	s_ctx.update(_dt);
 }
 
+uint32_t psGetNumParticles()
+{
+	return s_ctx.m_num;
+}
+
 void psRender(uint8_t _view, const float* _mtxView, const bx::Vec3& _eye)
 {
 	s_ctx.render(_view, _mtxView, _eye);
@@ -72,8 +72,9 @@ struct EmitterUniforms
 	EmitterSpriteHandle m_handle;
 };
 
-///
-void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL);
+/// Initialize particle system. `_numThreads` worker threads are used to update
+/// and generate vertices for emitters in parallel.
+void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL, uint16_t _numThreads = 0);
 
 ///
 void psShutdown();
@@ -99,6 +100,9 @@ void psDestroyEmitter(EmitterHandle _handle);
 ///
 void psUpdate(float _dt);
 
+/// Returns number of live particles in all emitters after last `psUpdate`.
+uint32_t psGetNumParticles();
+
 ///
 void psRender(uint8_t _view, const float* _mtxView, const bx::Vec3& _eye);
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2011-2024 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include <bx/string.h>
+
+#include "workerpool.h"
+
+WorkerPool::WorkerPool()
+	: m_fn(NULL)
+	, m_userData(NULL)
+	, m_numTasks(0)
+	, m_stride(1)
+	, m_numWorkers(0)
+	, m_exit(false)
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+	shutdown();
+}
+
+void WorkerPool::init(uint32_t _numThreads, const char* _name)
+{
+	shutdown();
+
+	m_exit = false;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_numWorkers = bx::min<uint32_t>(_numThreads, kMaxThreads);
+
+	for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+	{
+		char name[64];
+		bx::snprintf(name, BX_COUNTOF(name), "%s %d", _name, ii);
+
+		Worker& worker = m_worker[ii];
+		worker.m_pool  = this;
+		worker.m_first = ii+1;
+		worker.m_thread.init(threadFunc, &worker, 0, name);
+	}
+#else
+	BX_UNUSED(_numThreads, _name);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
+
+void WorkerPool::shutdown()
+{
+	m_exit = true;
+
+	for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+	{
+		m_worker[ii].m_start.post();
+		m_worker[ii].m_thread.shutdown();
+	}
+
+	m_numWorkers = 0;
+}
+
+void WorkerPool::run(TaskFn _fn, void* _userData, uint32_t _num)
+{
+	// Only workers that have at least one task assigned are woken up.
+	const uint32_t numWorkers = bx::min(m_numWorkers, _num > 0 ? _num-1 : 0);
+
+	m_fn       = _fn;
+	m_userData = _userData;
+	m_numTasks = _num;
+	m_stride   = numWorkers+1;
+
+	for (uint32_t ii = 0; ii < numWorkers; ++ii)
+	{
+		m_worker[ii].m_start.post();
+	}
+
+	execute(0);
+
+	for (uint32_t ii = 0; ii < numWorkers; ++ii)
+	{
+		m_done.wait();
+	}
+}
+
+int32_t WorkerPool::threadFunc(bx::Thread* /*_thread*/, void* _userData)
+{
+	Worker& worker = *(Worker*)_userData;
+	WorkerPool& pool = *worker.m_pool;
+
+	for (;;)
+	{
+		worker.m_start.wait();
+
+		if (pool.m_exit)
+		{
+			break;
+		}
+
+		pool.execute(worker.m_first);
+		pool.m_done.post();
+	}
+
+	return 0;
+}
+
+void WorkerPool::execute(uint32_t _first)
+{
+	for (uint32_t idx = _first; idx < m_numTasks; idx += m_stride)
+	{
+		m_fn(m_userData, idx, m_numTasks);
+	}
+}
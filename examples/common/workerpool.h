@@ -0,0 +1,72 @@
+/*
+ * Copyright 2011-2024 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef WORKERPOOL_H_HEADER_GUARD
+#define WORKERPOOL_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+/// Small fixed size pool of threads used by examples to split work into
+/// parallel tasks. Tasks are statically assigned, thread N executes tasks N,
+/// N+numThreads, N+2*numThreads, etc. Calling thread is thread 0, so pool
+/// without worker threads executes all tasks serially.
+///
+class WorkerPool
+{
+public:
+	/// Maximum number of worker threads.
+	static constexpr uint32_t kMaxThreads = 16;
+
+	/// Task function, `_idx` is task index in range [0, `_num`).
+	typedef void (*TaskFn)(void* _userData, uint32_t _idx, uint32_t _num);
+
+	///
+	WorkerPool();
+
+	///
+	~WorkerPool();
+
+	/// Start `_numThreads` worker threads.
+	void init(uint32_t _numThreads, const char* _name);
+
+	/// Stop all worker threads.
+	void shutdown();
+
+	/// Execute `_num` tasks and wait until all of them are done.
+	void run(TaskFn _fn, void* _userData, uint32_t _num);
+
+	/// Returns number of threads executing tasks, including calling thread.
+	uint32_t getNumThreads() const
+	{
+		return m_numWorkers + 1;
+	}
+
+private:
+	struct Worker
+	{
+		bx::Thread    m_thread;
+		bx::Semaphore m_start;
+		WorkerPool*   m_pool;
+		uint32_t      m_first;
+	};
+
+	static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+
+	void execute(uint32_t _first);
+
+	Worker        m_worker[kMaxThreads];
+	bx::Semaphore m_done;
+
+	TaskFn   m_fn;
+	void*    m_userData;
+	uint32_t m_numTasks;
+	uint32_t m_stride;
+	uint32_t m_numWorkers;
+	bool     m_exit;
+};
+
+#endif // WORKERPOOL_H_HEADER_GUARD
@@ -419,6 +419,7 @@ namespace bgfx
 
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(DrawBundleHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -716,6 +717,8 @@ namespace bgfx
 			uint32_t minResourceCbSize; //!< Minimum resource command buffer size.
 			uint32_t transientVbSize;   //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize;   //!< Maximum transient index buffer size.
+			uint16_t maxSortThreads;    //!< Maximum number of worker threads used to sort render items.
+			uint32_t maxUploadSize;     //!< Maximum amount of texture update data uploaded per frame (0 - unlimited).
 		};
 
 		Limits limits; //!< Configurable runtime limits.
@@ -1011,6 +1014,9 @@ namespace bgfx
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
 		uint32_t gpuFrameNum;               //<! Frame which generated gpuTimeBegin, gpuTimeEnd.
+		uint32_t numPipelinesPending;       //!< Number of pipelines being compiled in background.
+		uint32_t numPipelineCacheHits;      //!< Number of pipelines created from pipeline cache data.
+		uint32_t numPipelineCacheMisses;    //!< Number of pipelines compiled without pipeline cache data.
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
 		uint16_t numDynamicVertexBuffers;   //!< Number of used dynamic vertex buffers.
@@ -1028,11 +1034,22 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int64_t dynamicIbTotal;             //!< Size of dynamic index buffer pages.
+		int64_t dynamicIbFree;              //!< Amount of free memory in dynamic index buffer pages.
+		uint32_t dynamicIbLargestFree;      //!< Largest free block in dynamic index buffer pages.
+		int64_t dynamicVbTotal;             //!< Size of dynamic vertex buffer pages.
+		int64_t dynamicVbFree;              //!< Amount of free memory in dynamic vertex buffer pages.
+		uint32_t dynamicVbLargestFree;      //!< Largest free block in dynamic vertex buffer pages.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
 		int64_t gpuMemoryMax;               //!< Maximum available GPU memory for application.
 		int64_t gpuMemoryUsed;              //!< Amount of GPU memory used by the application.
+		int64_t gpuMemoryAllocated;         //!< Amount of device memory allocated by renderer.
+		int64_t gpuMemoryBlockFree;         //!< Amount of free memory inside renderer device memory blocks.
+		int64_t gpuMemoryLargestFree;       //!< Largest free range inside renderer device memory blocks.
+		uint32_t numGpuMemoryAllocs;        //!< Number of device memory allocations made by renderer.
+		uint32_t numGpuMemorySubAllocs;     //!< Number of resources placed inside device memory blocks.
 
 		uint16_t width;                     //!< Backbuffer width in pixels.
 		uint16_t height;                    //!< Backbuffer height in pixels.
@@ -1561,6 +1578,37 @@ namespace bgfx
 			, uint8_t _flags = BGFX_DISCARD_ALL
 			);
 
+		/// Start recording draw calls into draw bundle. All draw calls submitted
+		/// until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+		/// being submitted for rendering. Previous content of draw bundle is
+		/// discarded.
+		///
+		/// @param[in] _handle Draw bundle handle.
+		///
+		/// @remark
+		///   Transient buffers and occlusion queries can't be recorded.
+		///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+		///   and dynamic buffers must not be resized, while draw bundle is in use.
+		///   Otherwise submit of draw bundle is dropped until it's recorded again.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_begin_draw_bundle`.
+		///
+		void beginDrawBundle(DrawBundleHandle _handle);
+
+		/// Stop recording draw calls into draw bundle.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_end_draw_bundle`.
+		///
+		void endDrawBundle();
+
+		/// Submit all draw calls retained in draw bundle for rendering.
+		///
+		/// @param[in] _handle Draw bundle handle.
+		///
+		/// @attention C99's equivalent binding is `bgfx_encoder_submit_draw_bundle`.
+		///
+		void submit(DrawBundleHandle _handle);
+
 		/// Set compute index buffer.
 		///
 		/// @param[in] _stage Compute stage.
@@ -2009,6 +2057,50 @@ namespace bgfx
 		, bool _index32
 		);
 
+	/// Sort indices, using caller provided scratch memory.
+	///
+	/// @param[in] _sort Sort order, see `TopologySort::Enum`.
+	/// @param[in] _dst Destination index buffer.
+	/// @param[in] _dstSize Destination index buffer in bytes. It must be
+	///    large enough to contain output indices. If destination size is
+	///    insufficient index buffer will be truncated.
+	/// @param[in] _dir Direction (vector must be normalized).
+	/// @param[in] _pos Position.
+	/// @param[in] _vertices Pointer to first vertex represented as
+	///    float x, y, z. Must contain at least number of vertices
+	///    referencende by index buffer.
+	/// @param[in] _stride Vertex stride.
+	/// @param[in] _indices Source indices.
+	/// @param[in] _numIndices Number of input indices.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	/// @param[in] _scratch Scratch memory. If this argument is NULL
+	///    function will only return required scratch memory size.
+	/// @param[in] _scratchSize Scratch memory size in bytes.
+	/// @param[in] _coherent Set to `true` when the same scratch memory was
+	///    used to sort the same index buffer before. Triangle order of the
+	///    previous sort is used as starting point, which is faster when view
+	///    changes a little between sorts.
+	///
+	/// @returns Required scratch memory size in bytes.
+	///
+	/// @attention C99's equivalent binding is `bgfx_topology_sort_tri_list_scratch`.
+	///
+	uint32_t topologySortTriList(
+		  TopologySort::Enum _sort
+		, void* _dst
+		, uint32_t _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, void* _scratch
+		, uint32_t _scratchSize
+		, bool _coherent
+		);
+
 	/// Returns supported backend API renderers.
 	///
 	/// @param[in] _max Maximum number of elements in _enum array.
@@ -3073,6 +3165,18 @@ namespace bgfx
 	///
 	void* getDirectAccessPtr(TextureHandle _handle);
 
+	/// Returns texture residency.
+	///
+	/// @param[in] _handle Texture handle.
+	///
+	/// @returns True when all data passed to texture create and update functions so far
+	///   has been uploaded. When `Init::Limits::maxUploadSize` is set, uploads are spread
+	///   across frames, smallest mips first.
+	///
+	/// @attention C99's equivalent binding is `bgfx_is_texture_resident`.
+	///
+	bool isTextureResident(TextureHandle _handle);
+
 	/// Destroy texture.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3315,6 +3419,23 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create draw bundle. Draw bundle retains draw calls recorded with
+	/// `bgfx::Encoder::beginDrawBundle` across frames.
+	///
+	/// @returns Handle to draw bundle object.
+	///
+	/// @attention C99's equivalent binding is `bgfx_create_draw_bundle`.
+	///
+	DrawBundleHandle createDrawBundle();
+
+	/// Destroy draw bundle.
+	///
+	/// @param[in] _handle Handle to draw bundle object.
+	///
+	/// @attention C99's equivalent binding is `bgfx_destroy_draw_bundle`.
+	///
+	void destroy(DrawBundleHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -4064,6 +4185,37 @@ namespace bgfx
 		, uint8_t _flags = BGFX_DISCARD_ALL
 		);
 
+	/// Start recording draw calls into draw bundle. All draw calls submitted
+	/// until `bgfx::endDrawBundle` are retained in draw bundle instead of
+	/// being submitted for rendering. Previous content of draw bundle is
+	/// discarded.
+	///
+	/// @param[in] _handle Draw bundle handle.
+	///
+	/// @remark
+	///   Transient buffers and occlusion queries can't be recorded.
+	///   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+	///   and dynamic buffers must not be resized, while draw bundle is in use.
+	///   Otherwise submit of draw bundle is dropped until it's recorded again.
+	///
+	/// @attention C99's equivalent binding is `bgfx_begin_draw_bundle`.
+	///
+	void beginDrawBundle(DrawBundleHandle _handle);
+
+	/// Stop recording draw calls into draw bundle.
+	///
+	/// @attention C99's equivalent binding is `bgfx_end_draw_bundle`.
+	///
+	void endDrawBundle();
+
+	/// Submit all draw calls retained in draw bundle for rendering.
+	///
+	/// @param[in] _handle Draw bundle handle.
+	///
+	/// @attention C99's equivalent binding is `bgfx_submit_draw_bundle`.
+	///
+	void submit(DrawBundleHandle _handle);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
@@ -463,6 +463,7 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_draw_bundle_handle_s { uint16_t idx; } bgfx_draw_bundle_handle_t;
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -665,6 +666,8 @@ typedef struct bgfx_init_limits_s
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint16_t             maxSortThreads;     /** Maximum number of worker threads used to sort render items. */
+    uint32_t             maxUploadSize;      /** Maximum amount of texture update data uploaded per frame (0 - unlimited). */
 
 } bgfx_init_limits_t;
 
@@ -883,6 +886,9 @@ typedef struct bgfx_stats_s
     uint32_t             numBlit;            /** Number of blit calls submitted.          */
     uint32_t             maxGpuLatency;      /** GPU driver latency.                      */
     uint32_t             gpuFrameNum;        /** Frame which generated gpuTimeBegin, gpuTimeEnd. */
+    uint32_t             numPipelinesPending; /** Number of pipelines being compiled in background. */
+    uint32_t             numPipelineCacheHits; /** Number of pipelines created from pipeline cache data. */
+    uint32_t             numPipelineCacheMisses; /** Number of pipelines compiled without pipeline cache data. */
     uint16_t             numDynamicIndexBuffers; /** Number of used dynamic index buffers.    */
     uint16_t             numDynamicVertexBuffers; /** Number of used dynamic vertex buffers.   */
     uint16_t             numFrameBuffers;    /** Number of used frame buffers.            */
@@ -898,9 +904,20 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int64_t              dynamicIbTotal;     /** Size of dynamic index buffer pages.      */
+    int64_t              dynamicIbFree;      /** Amount of free memory in dynamic index buffer pages. */
+    uint32_t             dynamicIbLargestFree; /** Largest free block in dynamic index buffer pages. */
+    int64_t              dynamicVbTotal;     /** Size of dynamic vertex buffer pages.     */
+    int64_t              dynamicVbFree;      /** Amount of free memory in dynamic vertex buffer pages. */
+    uint32_t             dynamicVbLargestFree; /** Largest free block in dynamic vertex buffer pages. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
+    int64_t              gpuMemoryAllocated; /** Amount of device memory allocated by renderer. */
+    int64_t              gpuMemoryBlockFree; /** Amount of free memory inside renderer device memory blocks. */
+    int64_t              gpuMemoryLargestFree; /** Largest free range inside renderer device memory blocks. */
+    uint32_t             numGpuMemoryAllocs; /** Number of device memory allocations made by renderer. */
+    uint32_t             numGpuMemorySubAllocs; /** Number of resources placed inside device memory blocks. */
     uint16_t             width;              /** Backbuffer width in pixels.              */
     uint16_t             height;             /** Backbuffer height in pixels.             */
     uint16_t             textWidth;          /** Debug text width in characters.          */
@@ -1108,6 +1125,36 @@ BGFX_C_API uint32_t bgfx_topology_convert(bgfx_topology_convert_t _conversion, v
  */
 BGFX_C_API void bgfx_topology_sort_tri_list(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
 
+/**
+ * Sort indices, using caller provided scratch memory.
+ *
+ * @param[in] _sort Sort order, see `TopologySort::Enum`.
+ * @param[out] _dst Destination index buffer.
+ * @param[in] _dstSize Destination index buffer in bytes. It must be
+ *  large enough to contain output indices. If destination size is
+ *  insufficient index buffer will be truncated.
+ * @param[in] _dir Direction (vector must be normalized).
+ * @param[in] _pos Position.
+ * @param[in] _vertices Pointer to first vertex represented as
+ *  float x, y, z. Must contain at least number of vertices
+ *  referencende by index buffer.
+ * @param[in] _stride Vertex stride.
+ * @param[in] _indices Source indices.
+ * @param[in] _numIndices Number of input indices.
+ * @param[in] _index32 Set to `true` if input indices are 32-bit.
+ * @param[in] _scratch Scratch memory. If this argument is NULL
+ *  function will only return required scratch memory size.
+ * @param[in] _scratchSize Scratch memory size in bytes.
+ * @param[in] _coherent Set to `true` when the same scratch memory was
+ *  used to sort the same index buffer before. Triangle order of the
+ *  previous sort is used as starting point, which is faster when view
+ *  changes a little between sorts.
+ *
+ * @returns Required scratch memory size in bytes.
+ *
+ */
+BGFX_C_API uint32_t bgfx_topology_sort_tri_list_scratch(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, void* _scratch, uint32_t _scratchSize, bool _coherent);
+
 /**
  * Returns supported backend API renderers.
  *
@@ -2001,6 +2048,18 @@ BGFX_C_API void bgfx_set_texture_name(bgfx_texture_handle_t _handle, const char*
  */
 BGFX_C_API void* bgfx_get_direct_access_ptr(bgfx_texture_handle_t _handle);
 
+/**
+ * Returns texture residency.
+ *
+ * @param[in] _handle Texture handle.
+ *
+ * @returns True when all data passed to texture create and update functions so far
+ *  has been uploaded. When `Init::Limits::maxUploadSize` is set, uploads are spread
+ *  across frames, smallest mips first.
+ *
+ */
+BGFX_C_API bool bgfx_is_texture_resident(bgfx_texture_handle_t _handle);
+
 /**
  * Destroy texture.
  *
@@ -2195,6 +2254,21 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create draw bundle. Draw bundle retains draw calls recorded with
+ * `bgfx::Encoder::beginDrawBundle` across frames.
+ *
+ */
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle(void);
+
+/**
+ * Destroy draw bundle.
+ *
+ * @param[in] _handle Handle to draw bundle object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2732,6 +2806,36 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
  */
 BGFX_C_API void bgfx_encoder_submit_indirect_count(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Start recording draw calls into draw bundle. All draw calls submitted
+ * until `bgfx::Encoder::endDrawBundle` are retained in draw bundle instead of
+ * being submitted for rendering. Previous content of draw bundle is
+ * discarded.
+ * @remark
+ *   Transient buffers and occlusion queries can't be recorded.
+ *   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+ *   and dynamic buffers must not be resized, while draw bundle is in use.
+ *   Otherwise submit of draw bundle is dropped until it's recorded again.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * Stop recording draw calls into draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this);
+
+/**
+ * Submit all draw calls retained in draw bundle for rendering.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -3315,6 +3419,36 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
  */
 BGFX_C_API void bgfx_submit_indirect_count(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Start recording draw calls into draw bundle. All draw calls submitted
+ * until `bgfx::endDrawBundle` are retained in draw bundle instead of
+ * being submitted for rendering. Previous content of draw bundle is
+ * discarded.
+ * @remark
+ *   Transient buffers and occlusion queries can't be recorded.
+ *   Buffers, textures, programs, and uniforms used by draw bundle must not be destroyed,
+ *   and dynamic buffers must not be resized, while draw bundle is in use.
+ *   Otherwise submit of draw bundle is dropped until it's recorded again.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * Stop recording draw calls into draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_end_draw_bundle(void);
+
+/**
+ * Submit all draw calls retained in draw bundle for rendering.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -3535,6 +3669,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_GET_RESULT,
     BGFX_FUNCTION_ID_DESTROY_OCCLUSION_QUERY,
+    BGFX_FUNCTION_ID_CREATE_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_DESTROY_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR_RGBA8,
     BGFX_FUNCTION_ID_SET_VIEW_NAME,
@@ -3580,6 +3716,9 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_INDIRECT,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_INDIRECT_COUNT,
+    BGFX_FUNCTION_ID_ENCODER_BEGIN_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_ENCODER_END_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_ENCODER_SUBMIT_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3626,6 +3765,9 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_SUBMIT_INDIRECT,
     BGFX_FUNCTION_ID_SUBMIT_INDIRECT_COUNT,
+    BGFX_FUNCTION_ID_BEGIN_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_END_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_SUBMIT_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3657,6 +3799,7 @@ struct bgfx_interface_vtbl
     uint32_t (*weld_vertices)(void* _output, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon);
     uint32_t (*topology_convert)(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32);
     void (*topology_sort_tri_list)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    uint32_t (*topology_sort_tri_list_scratch)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, void* _scratch, uint32_t _scratchSize, bool _coherent);
     uint8_t (*get_supported_renderers)(uint8_t _max, bgfx_renderer_type_t* _enum);
     const char* (*get_renderer_name)(bgfx_renderer_type_t _type);
     void (*init_ctor)(bgfx_init_t* _init);
@@ -3722,6 +3865,7 @@ struct bgfx_interface_vtbl
     uint32_t (*read_texture)(bgfx_texture_handle_t _handle, void* _data, uint8_t _mip);
     void (*set_texture_name)(bgfx_texture_handle_t _handle, const char* _name, int32_t _len);
     void* (*get_direct_access_ptr)(bgfx_texture_handle_t _handle);
+    bool (*is_texture_resident)(bgfx_texture_handle_t _handle);
     void (*destroy_texture)(bgfx_texture_handle_t _handle);
     bgfx_frame_buffer_handle_t (*create_frame_buffer)(uint16_t _width, uint16_t _height, bgfx_texture_format_t _format, uint64_t _textureFlags);
     bgfx_frame_buffer_handle_t (*create_frame_buffer_scaled)(bgfx_backbuffer_ratio_t _ratio, bgfx_texture_format_t _format, uint64_t _textureFlags);
@@ -3737,6 +3881,8 @@ struct bgfx_interface_vtbl
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_draw_bundle_handle_t (*create_draw_bundle)(void);
+    void (*destroy_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name, int32_t _len);
@@ -3782,6 +3928,9 @@ struct bgfx_interface_vtbl
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, uint32_t _num, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect_count)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
+    void (*encoder_begin_draw_bundle)(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+    void (*encoder_end_draw_bundle)(bgfx_encoder_t* _this);
+    void (*encoder_submit_draw_bundle)(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3828,6 +3977,9 @@ struct bgfx_interface_vtbl
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, uint32_t _num, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect_count)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint32_t _start, bgfx_index_buffer_handle_t _numHandle, uint32_t _numIndex, uint32_t _numMax, uint32_t _depth, uint8_t _flags);
+    void (*begin_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
+    void (*end_draw_bundle)(void);
+    void (*submit_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
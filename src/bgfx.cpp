@@ -296,6 +296,22 @@ namespace bgfx
 	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
 #endif
 
+#if BGFX_CONFIG_TRANSIENT_CHUNK_SIZE > 0 && defined(BX_THREAD_LOCAL)
+	static BX_THREAD_LOCAL TransientChunk s_transientChunk[TransientChunk::Count];
+#endif // BGFX_CONFIG_TRANSIENT_CHUNK_SIZE > 0 && defined(BX_THREAD_LOCAL)
+
+	TransientChunk* getTransientChunk(TransientChunk::Enum _type)
+	{
+#if BGFX_CONFIG_TRANSIENT_CHUNK_SIZE > 0 && defined(BX_THREAD_LOCAL)
+		return &s_transientChunk[_type];
+#else
+		BX_UNUSED(_type);
+		return NULL;
+#endif // BGFX_CONFIG_TRANSIENT_CHUNK_SIZE > 0 && defined(BX_THREAD_LOCAL)
+	}
+
+	uint32_t Frame::s_transientFrameId = 0;
+
 	static Context* s_ctx = NULL;
 	static bool s_renderFrameCalled = false;
 	InternalData g_internalData;
@@ -1260,6 +1276,20 @@ namespace bgfx
 		}
 	}
 
+	static uint64_t encodeDrawKey(SortKey& _key, ViewMode::Enum _mode, uint32_t _depth)
+	{
+		SortKey::Enum type;
+		switch (_mode)
+		{
+		case ViewMode::Sequential:      _key.m_seq   = s_ctx->getSeqIncr(_key.m_view); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:  _key.m_depth =            _depth;              type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending: _key.m_depth = UINT32_MAX-_depth;              type = SortKey::SortDepth;    break;
+		default:                        _key.m_depth =            _depth;              type = SortKey::SortProgram;  break;
+		}
+
+		return _key.encodeDraw(type);
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1292,15 +1322,23 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS <= renderItemIdx)
+		uint32_t renderItemIdx = UINT32_MAX;
+		RenderBindRef bindRef;
+		if (NULL == m_drawBundle)
 		{
-			discard(_flags);
-			++m_numDropped;
-			return;
-		}
+			renderItemIdx = encodeRenderBind(m_bind, bindRef)
+				? allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS)
+				: UINT32_MAX
+				;
+			if (UINT32_MAX == renderItemIdx)
+			{
+				discard(_flags);
+				++m_numDropped;
+				return;
+			}
 
-		++m_numSubmitted;
+			++m_numSubmitted;
+		}
 
 		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 		m_uniformEnd = uniformBuffer->getPos();
@@ -1312,19 +1350,8 @@ namespace bgfx
 
 		m_key.m_view = _id;
 
-		SortKey::Enum type;
-		switch (s_ctx->m_view[_id].m_mode)
-		{
-		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
-		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
-		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
-		default:                        m_key.m_depth =            _depth;      type = SortKey::SortProgram;  break;
-		}
-
-		uint64_t key = m_key.encodeDraw(type);
-
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		uint64_t key = encodeDrawKey(m_key, mode, _depth);
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
@@ -1357,8 +1384,18 @@ namespace bgfx
 			m_draw.m_occlusionQuery = _occlusionQuery;
 		}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+		if (NULL != m_drawBundle)
+		{
+			SortKey sortKey = m_key;
+			sortKey.m_depth = _depth;
+			m_drawBundle->add(key, sortKey, mode, m_draw, m_bind, uniformBuffer, m_frame->m_frameCache);
+		}
+		else
+		{
+			m_frame->m_sortKeys[renderItemIdx]        = key;
+			m_frame->m_renderItem[renderItemIdx].draw = m_draw;
+			m_frame->m_renderItemBind[renderItemIdx]  = bindRef;
+		}
 
 		m_draw.clear(_flags);
 		m_bind.clear(_flags);
@@ -1368,142 +1405,979 @@ namespace bgfx
 		}
 	}
 
+	void EncoderImpl::submit(const DrawBundle& _bundle)
+	{
+		BX_ASSERT(&_bundle != m_drawBundle, "Draw bundle can't be submitted while it's being recorded.");
+
+		if (0 == _bundle.m_num)
+		{
+			return;
+		}
+
+		if (!_bundle.checkRefs() )
+		{
+			BX_WARN(false, "Draw bundle references destroyed or reallocated resource, it must be recorded again.");
+			m_numDropped += _bundle.m_num;
+			return;
+		}
+
+		// Bundle uniform commands are inserted in front of uniforms already set
+		// for the next draw call, which are copied after them.
+		const uint32_t pending = m_frame->m_uniformBuffer[m_uniformIdx]->getPos() - m_uniformBegin;
+		const uint32_t size    = _bundle.m_uniformSize + pending;
+		UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx], bx::max<uint32_t>(64<<10, size), bx::max<uint32_t>(1<<20, size+(64<<10) ) );
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+
+		const uint32_t uniformBase = uniformBuffer->getPos();
+		uniformBuffer->write(_bundle.m_uniforms, _bundle.m_uniformSize);
+
+		if (0 != pending)
+		{
+			uniformBuffer->write(uniformBuffer->getData(m_uniformBegin), pending);
+		}
+
+		m_uniformBegin = uniformBase + _bundle.m_uniformSize;
+
+		uint32_t firstMatrix = 0;
+		uint16_t numMatrices = uint16_t(bx::min<uint32_t>(_bundle.m_numMatrices, UINT16_MAX) );
+		if (0 != numMatrices)
+		{
+			firstMatrix = m_frame->m_frameCache.m_matrixCache.reserve(&numMatrices);
+			bx::memCopy(
+				  m_frame->m_frameCache.m_matrixCache.toPtr(firstMatrix)
+				, _bundle.m_matrix
+				, numMatrices*sizeof(Matrix4)
+				);
+		}
+
+		uint32_t firstBinding = 0;
+		if (0 != _bundle.m_numBindings)
+		{
+			firstBinding = m_frame->reserveRenderItemBindings(_bundle.m_numBindings);
+			if (UINT32_MAX == firstBinding)
+			{
+				m_numDropped += _bundle.m_num;
+				return;
+			}
+
+			bx::memCopy(
+				  &m_frame->m_renderItemBinding[firstBinding]
+				, _bundle.m_binding
+				, _bundle.m_numBindings*sizeof(Binding)
+				);
+		}
+
+		uint32_t firstRect = 0;
+		uint32_t numRects  = _bundle.m_numRects;
+		if (0 != numRects)
+		{
+			firstRect = m_frame->m_frameCache.m_rectCache.add(_bundle.m_rect, &numRects);
+		}
+
+		for (uint32_t ii = 0; ii < _bundle.m_num;)
+		{
+			uint32_t num = _bundle.m_num - ii;
+			const uint32_t first = allocRenderItems(BGFX_CONFIG_MAX_DRAW_CALLS, &num);
+			if (UINT32_MAX == first)
+			{
+				m_numDropped += _bundle.m_num - ii;
+				break;
+			}
+
+			bx::memCopy(&m_frame->m_sortKeys[first], &_bundle.m_sortKeys[ii], num*sizeof(uint64_t) );
+
+			for (uint32_t jj = 0; jj < num; ++jj)
+			{
+				const DrawBundle::Item& item = _bundle.m_item[ii+jj];
+
+				// Pre-encoded key is valid as long as view mode didn't change.
+				// Sequential views need new sequence number every time.
+				const ViewMode::Enum mode = s_ctx->m_view[item.m_key.m_view].m_mode;
+				if (ViewMode::Sequential == mode
+				||  item.m_mode != mode)
+				{
+					SortKey key = item.m_key;
+					m_frame->m_sortKeys[first+jj] = encodeDrawKey(key, mode, item.m_key.m_depth);
+				}
+
+				RenderBindRef& bindRef = m_frame->m_renderItemBind[first+jj];
+				bindRef = _bundle.m_bindRef[ii+jj];
+				bindRef.m_first += firstBinding;
+
+				RenderDraw& draw = m_frame->m_renderItem[first+jj].draw;
+				draw = _bundle.m_draw[ii+jj];
+
+				draw.m_uniformIdx    = m_uniformIdx;
+				draw.m_uniformBegin += uniformBase;
+				draw.m_uniformEnd   += uniformBase;
+
+				if (0 != draw.m_startMatrix)
+				{
+					const uint32_t idx = draw.m_startMatrix-1;
+					draw.m_startMatrix = idx < numMatrices ? firstMatrix+idx : 0;
+				}
+
+				if (UINT16_MAX != draw.m_scissor)
+				{
+					draw.m_scissor = draw.m_scissor < numRects
+						? uint16_t(firstRect+draw.m_scissor)
+						: UINT16_MAX
+						;
+				}
+			}
+
+			m_numSubmitted += num;
+			ii += num;
+		}
+	}
+
+	void DrawBundle::destroy()
+	{
+		bx::free(g_allocator, m_sortKeys);
+		bx::free(g_allocator, m_item);
+		bx::free(g_allocator, m_draw,   BX_ALIGNOF(RenderDraw) );
+		bx::free(g_allocator, m_bindRef);
+		bx::free(g_allocator, m_binding);
+		bx::free(g_allocator, m_uniforms);
+		bx::free(g_allocator, m_matrix, BX_ALIGNOF(Matrix4) );
+		bx::free(g_allocator, m_rect);
+		bx::free(g_allocator, m_ref);
+
+		m_sortKeys = NULL;
+		m_item     = NULL;
+		m_draw     = NULL;
+		m_bindRef  = NULL;
+		m_binding  = NULL;
+		m_uniforms = NULL;
+		m_matrix   = NULL;
+		m_rect     = NULL;
+		m_ref      = NULL;
+
+		m_max         = 0;
+		m_uniformMax  = 0;
+		m_maxMatrices = 0;
+		m_maxRects    = 0;
+		m_maxBindings = 0;
+		m_maxRefs     = 0;
+
+		reset();
+	}
+
+	void DrawBundle::addRef(Handle::Enum _type, uint16_t _idx)
+	{
+		for (uint32_t ii = 0; ii < m_numRefs; ++ii)
+		{
+			if (_idx  == m_ref[ii].m_idx
+			&&  _type == m_ref[ii].m_type)
+			{
+				return;
+			}
+		}
+
+		if (m_numRefs == m_maxRefs)
+		{
+			m_maxRefs = bx::max<uint32_t>(m_maxRefs*2, 64);
+			m_ref     = (Ref*)bx::realloc(g_allocator, m_ref, m_maxRefs*sizeof(Ref) );
+		}
+
+		Ref& ref = m_ref[m_numRefs++];
+		ref.m_idx  = _idx;
+		ref.m_gen  = s_ctx->getResourceGen(_type, _idx);
+		ref.m_type = uint8_t(_type);
+	}
+
+	bool DrawBundle::checkRefs() const
+	{
+		for (uint32_t ii = 0; ii < m_numRefs; ++ii)
+		{
+			const Ref& ref = m_ref[ii];
+			if (ref.m_gen != s_ctx->getResourceGen(Handle::Enum(ref.m_type), ref.m_idx) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void DrawBundle::add(
+		  uint64_t _sortKey
+		, const SortKey& _key
+		, ViewMode::Enum _mode
+		, const RenderDraw& _draw
+		, const RenderBind& _bind
+		, const UniformBuffer* _uniformBuffer
+		, const FrameCache& _frameCache
+		)
+	{
+		BX_ASSERT(!isValid(_draw.m_occlusionQuery), "Occlusion query can't be recorded into draw bundle.");
+
+		if (m_num == m_max)
+		{
+			m_max = bx::max<uint32_t>(m_max*2, 256);
+			m_sortKeys = (uint64_t*  )bx::realloc(g_allocator, m_sortKeys, m_max*sizeof(uint64_t)   );
+			m_item     = (Item*      )bx::realloc(g_allocator, m_item,     m_max*sizeof(Item)       );
+			m_draw     = (RenderDraw*)bx::realloc(g_allocator, m_draw,     m_max*sizeof(RenderDraw), BX_ALIGNOF(RenderDraw) );
+			m_bindRef  = (RenderBindRef*)bx::realloc(g_allocator, m_bindRef, m_max*sizeof(RenderBindRef) );
+		}
+
+		const uint32_t idx = m_num++;
+		m_sortKeys[idx]     = _sortKey;
+		m_item[idx].m_key   = _key;
+		m_item[idx].m_mode  = uint8_t(_mode);
+
+		if (UINT32_MAX == m_lastBindRef.m_first
+		||  0 != bx::memCmp(&m_lastBind, &_bind, sizeof(RenderBind) ) )
+		{
+			uint32_t num;
+			const uint32_t mask = _bind.getMask(&num);
+
+			if (m_numBindings + num > m_maxBindings)
+			{
+				m_maxBindings = bx::max<uint32_t>(m_maxBindings*2, bx::max<uint32_t>(m_numBindings + num, 256) );
+				m_binding     = (Binding*)bx::realloc(g_allocator, m_binding, m_maxBindings*sizeof(Binding) );
+			}
+
+			_bind.pack(&m_binding[m_numBindings], mask);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const Binding& bind = m_binding[m_numBindings+ii];
+				switch (bind.m_type)
+				{
+				case Binding::IndexBuffer:  addRef(Handle::IndexBuffer,  bind.m_idx); break;
+				case Binding::VertexBuffer: addRef(Handle::VertexBuffer, bind.m_idx); break;
+				default:                    addRef(Handle::Texture,      bind.m_idx); break;
+				}
+			}
+
+			bx::memCopy(&m_lastBind, &_bind, sizeof(RenderBind) );
+			m_lastBindRef.m_first = m_numBindings;
+			m_lastBindRef.m_mask  = mask;
+			m_numBindings += num;
+		}
+
+		m_bindRef[idx] = m_lastBindRef;
+
+		addRef(Handle::Program, _key.m_program.idx);
+
+		if (UINT8_MAX != _draw.m_streamMask)
+		{
+			for (uint32_t streamMask = _draw.m_streamMask; 0 != streamMask; streamMask &= streamMask-1)
+			{
+				addRef(Handle::VertexBuffer, _draw.m_stream[bx::uint32_cnttz(streamMask)].m_handle.idx);
+			}
+		}
+
+		if (isValid(_draw.m_indexBuffer) )
+		{
+			addRef(Handle::IndexBuffer, _draw.m_indexBuffer.idx);
+		}
+
+		if (isValid(_draw.m_instanceDataBuffer) )
+		{
+			addRef(Handle::VertexBuffer, _draw.m_instanceDataBuffer.idx);
+		}
+
+		if (isValid(_draw.m_indirectBuffer) )
+		{
+			addRef(Handle::VertexBuffer, _draw.m_indirectBuffer.idx);
+		}
+
+		if (isValid(_draw.m_numIndirectBuffer) )
+		{
+			addRef(Handle::IndexBuffer, _draw.m_numIndirectBuffer.idx);
+		}
+
+		RenderDraw& draw = m_draw[idx];
+		draw = _draw;
+
+		// Draw calls that preserve state share start of uniform range with
+		// previous draw call, only newly written uniform commands are appended.
+		if (_draw.m_uniformBegin != m_lastUniformBegin
+		||  _draw.m_uniformEnd   <  m_lastUniformEnd)
+		{
+			m_lastUniformBegin  = _draw.m_uniformBegin;
+			m_lastUniformEnd    = _draw.m_uniformBegin;
+			m_lastUniformOffset = m_uniformSize;
+		}
+
+		const uint32_t size = _draw.m_uniformEnd - m_lastUniformEnd;
+		if (m_uniformSize + size > m_uniformMax)
+		{
+			m_uniformMax = bx::max<uint32_t>(m_uniformMax*2, bx::max<uint32_t>(m_uniformSize + size, 4<<10) );
+			m_uniforms   = (char*)bx::realloc(g_allocator, m_uniforms, m_uniformMax);
+		}
+
+		bx::memCopy(&m_uniforms[m_uniformSize], _uniformBuffer->getData(m_lastUniformEnd), size);
+		m_uniformSize   += size;
+		m_lastUniformEnd = _draw.m_uniformEnd;
+
+		draw.m_uniformBegin = m_lastUniformOffset;
+		draw.m_uniformEnd   = m_uniformSize;
+
+		// Matrix index is stored 1-based, 0 still refers to identity matrix.
+		if (0 != _draw.m_startMatrix)
+		{
+			if (m_numMatrices + _draw.m_numMatrices > m_maxMatrices)
+			{
+				m_maxMatrices = bx::max<uint32_t>(m_maxMatrices*2, bx::max<uint32_t>(m_numMatrices + _draw.m_numMatrices, 256) );
+				m_matrix      = (Matrix4*)bx::realloc(g_allocator, m_matrix, m_maxMatrices*sizeof(Matrix4), BX_ALIGNOF(Matrix4) );
+			}
+
+			bx::memCopy(
+				  &m_matrix[m_numMatrices]
+				, &_frameCache.m_matrixCache.m_cache[_draw.m_startMatrix]
+				, _draw.m_numMatrices*sizeof(Matrix4)
+				);
+			draw.m_startMatrix = m_numMatrices+1;
+			m_numMatrices     += _draw.m_numMatrices;
+		}
+
+		if (UINT16_MAX != _draw.m_scissor)
+		{
+			if (_draw.m_scissor != m_lastScissor)
+			{
+				if (m_numRects == m_maxRects)
+				{
+					m_maxRects = bx::max<uint32_t>(m_maxRects*2, 64);
+					m_rect     = (Rect*)bx::realloc(g_allocator, m_rect, m_maxRects*sizeof(Rect) );
+				}
+
+				m_rect[m_numRects++] = _frameCache.m_rectCache.m_cache[_draw.m_scissor];
+				m_lastScissor = _draw.m_scissor;
+			}
+
+			draw.m_scissor = uint16_t(m_numRects-1);
+		}
+	}
+
 	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
 	{
+		BX_ASSERT(NULL == m_drawBundle, "Compute dispatch can't be recorded into draw bundle.");
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
 		{
 			m_uniformSet.clear();
 		}
 
-		if (m_discard)
+		if (m_discard)
+		{
+			discard(_flags);
+			return;
+		}
+
+		RenderBindRef bindRef;
+		const uint32_t renderItemIdx = encodeRenderBind(m_bind, bindRef)
+			? allocRenderItem(BGFX_CONFIG_MAX_DRAW_CALLS-1)
+			: UINT32_MAX
+			;
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard(_flags);
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_compute.m_startMatrix = m_draw.m_startMatrix;
+		m_compute.m_numMatrices = m_draw.m_numMatrices;
+		m_compute.m_numX   = bx::max(_numX, 1u);
+		m_compute.m_numY   = bx::max(_numY, 1u);
+		m_compute.m_numZ   = bx::max(_numZ, 1u);
+
+		m_key.m_program = _handle;
+		m_key.m_depth   = 0;
+		m_key.m_view    = _id;
+		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+
+		uint64_t key = m_key.encodeCompute();
+		m_frame->m_sortKeys[renderItemIdx] = key;
+
+		m_compute.m_uniformIdx   = m_uniformIdx;
+		m_compute.m_uniformBegin = m_uniformBegin;
+		m_compute.m_uniformEnd   = m_uniformEnd;
+		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
+		m_frame->m_renderItemBind[renderItemIdx]     = bindRef;
+
+		m_compute.clear(_flags);
+		m_bind.clear(_flags);
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	{
+		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
+			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
+			, BGFX_CONFIG_MAX_BLIT_ITEMS
+			);
+		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			uint16_t item = m_frame->m_numBlitItems++;
+
+			BlitItem& bi = m_frame->m_blitItem[item];
+			bi.m_srcX    = _srcX;
+			bi.m_srcY    = _srcY;
+			bi.m_srcZ    = _srcZ;
+			bi.m_dstX    = _dstX;
+			bi.m_dstY    = _dstY;
+			bi.m_dstZ    = _dstZ;
+			bi.m_width   = _width;
+			bi.m_height  = _height;
+			bi.m_depth   = _depth;
+			bi.m_srcMip  = _srcMip;
+			bi.m_dstMip  = _dstMip;
+			bi.m_src     = _src;
+			bi.m_dst     = _dst;
+
+			BlitKey key;
+			key.m_view = _id;
+			key.m_item = item;
+			m_frame->m_blitKeys[item] = key.encode();
+		}
+	}
+
+	// Multi-threaded LSD radix sort of render item keys. Each pass splits source
+	// array into one contiguous range per task, builds per-task histograms, and
+	// scatters every range into its own slice of destination buckets. Order of
+	// equal keys is preserved, so result is identical to `bx::radixSort`.
+	struct RenderItemSortMt
+	{
+		static constexpr uint32_t kRadixBits       = 11;
+		static constexpr uint32_t kHistogramSize   = 1<<kRadixBits;
+		static constexpr uint32_t kHistogramMask   = kHistogramSize-1;
+		static constexpr uint32_t kNumPasses       = (64+kRadixBits-1)/kRadixBits;
+		static constexpr uint32_t kMinItemsPerTask = 4<<10;
+		static constexpr uint32_t kMaxTasks        = BGFX_CONFIG_MAX_WORKER_THREADS+1;
+
+		void getRange(uint32_t _idx, uint32_t _numTasks, uint32_t& _begin, uint32_t& _end) const
+		{
+			_begin = uint32_t(uint64_t(m_num)*(_idx  )/_numTasks);
+			_end   = uint32_t(uint64_t(m_num)*(_idx+1)/_numTasks);
+		}
+
+		// Compacts used slots of all render item chunks, remaps views, and builds
+		// histogram for the first pass.
+		static void compactTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			RenderItemSortMt& ctx = *(RenderItemSortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			uint32_t* histogram = ctx.m_histogram[_idx];
+			bx::memSet(histogram, 0, sizeof(ctx.m_histogram[0]) );
+
+			if (begin == end)
+			{
+				return;
+			}
+
+			// Find chunk containing first item of the range.
+			uint32_t chunkIdx = 0;
+			for (uint32_t count = ctx.m_numChunks; 0 < count;)
+			{
+				const uint32_t step = count/2;
+				if (ctx.m_chunkOffset[chunkIdx+step+1] <= begin)
+				{
+					chunkIdx += step+1;
+					count    -= step+1;
+				}
+				else
+				{
+					count = step;
+				}
+			}
+
+			const uint64_t*  srcKeys   = ctx.m_keys[0];
+			uint64_t*        dstKeys   = ctx.m_keys[1];
+			RenderItemCount* dstValues = ctx.m_values[1];
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				while (ii >= ctx.m_chunkOffset[chunkIdx+1])
+				{
+					++chunkIdx;
+				}
+
+				const uint32_t slot = ctx.m_chunk[chunkIdx].m_first + ii - ctx.m_chunkOffset[chunkIdx];
+				const uint64_t key  = SortKey::remapView(srcKeys[slot], ctx.m_viewRemap);
+
+				dstKeys[ii]   = key;
+				dstValues[ii] = RenderItemCount(slot);
+
+				++histogram[key & kHistogramMask];
+			}
+		}
+
+		static void histogramTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			RenderItemSortMt& ctx = *(RenderItemSortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			uint32_t* histogram = ctx.m_histogram[_idx];
+			bx::memSet(histogram, 0, sizeof(ctx.m_histogram[0]) );
+
+			const uint64_t* keys  = ctx.m_keys[ctx.m_src];
+			const uint32_t  shift = ctx.m_shift;
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				++histogram[(keys[ii] >> shift) & kHistogramMask];
+			}
+		}
+
+		static void scatterTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			RenderItemSortMt& ctx = *(RenderItemSortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			uint32_t* offset = ctx.m_histogram[_idx];
+
+			const uint64_t*        srcKeys   = ctx.m_keys[ctx.m_src];
+			const RenderItemCount* srcValues = ctx.m_values[ctx.m_src];
+			uint64_t*              dstKeys   = ctx.m_keys[ctx.m_src^1];
+			RenderItemCount*       dstValues = ctx.m_values[ctx.m_src^1];
+			const uint32_t         shift     = ctx.m_shift;
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				const uint64_t key  = srcKeys[ii];
+				const uint32_t dest = offset[(key >> shift) & kHistogramMask]++;
+
+				dstKeys[dest]   = key;
+				dstValues[dest] = srcValues[ii];
+			}
+		}
+
+		// Converts per-task histograms into per-task scatter offsets. Returns
+		// false when all keys fall into the same bucket, and pass can be skipped.
+		bool prefixSum(uint32_t _numTasks)
+		{
+			uint32_t offset = 0;
+
+			for (uint32_t bucket = 0; bucket < kHistogramSize; ++bucket)
+			{
+				uint32_t count = 0;
+
+				for (uint32_t task = 0; task < _numTasks; ++task)
+				{
+					const uint32_t num = m_histogram[task][bucket];
+					m_histogram[task][bucket] = offset + count;
+					count += num;
+				}
+
+				if (count == m_num)
+				{
+					return false;
+				}
+
+				offset += count;
+			}
+
+			return true;
+		}
+
+		void sort(WorkerPool& _pool, uint32_t _numTasks)
+		{
+			_pool.run(compactTask, this, _numTasks);
+			m_src = 1;
+
+			for (uint32_t pass = 0; pass < kNumPasses; ++pass)
+			{
+				m_shift = pass*kRadixBits;
+
+				if (0 < pass)
+				{
+					_pool.run(histogramTask, this, _numTasks);
+				}
+
+				if (prefixSum(_numTasks) )
+				{
+					_pool.run(scatterTask, this, _numTasks);
+					m_src ^= 1;
+				}
+			}
+
+			if (0 != m_src)
+			{
+				bx::memCopy(m_keys[0],   m_keys[1],   m_num*sizeof(uint64_t) );
+				bx::memCopy(m_values[0], m_values[1], m_num*sizeof(RenderItemCount) );
+			}
+		}
+
+		const Frame::RenderItemChunk* m_chunk;
+		ViewId*                       m_viewRemap;
+		uint64_t*                     m_keys[2];
+		RenderItemCount*              m_values[2];
+		uint32_t m_numChunks;
+		uint32_t m_num;
+		uint32_t m_shift;
+		uint32_t m_src;
+
+		uint32_t m_chunkOffset[Frame::kMaxFrameRenderItemChunks+1];
+		uint32_t m_histogram[kMaxTasks][kHistogramSize];
+	};
+
+	static RenderItemSortMt s_renderItemSortMt;
+
+	void Frame::sort()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+
+		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+
+			View& view = m_view[ii];
+			Rect rect(0, 0, uint16_t(m_resolution.width), uint16_t(m_resolution.height) );
+
+			if (isValid(view.m_fbh) )
+			{
+				const FrameBufferRef& fbr = s_ctx->m_frameBufferRef[view.m_fbh.idx];
+				const BackbufferRatio::Enum bbRatio = fbr.m_window
+					? BackbufferRatio::Count
+					: BackbufferRatio::Enum(s_ctx->m_textureRef[fbr.un.m_th[0].idx].m_bbRatio)
+					;
+
+				if (BackbufferRatio::Count != bbRatio)
+				{
+					getTextureSizeFromRatio(bbRatio, rect.m_width, rect.m_height);
+				}
+				else
+				{
+					rect.m_width  = fbr.m_width;
+					rect.m_height = fbr.m_height;
+				}
+			}
+
+			view.m_rect.intersect(rect);
+
+			if (!view.m_scissor.isZero() )
+			{
+				view.m_scissor.intersect(rect);
+			}
+		}
+
+		if (BX_ENABLED(BGFX_CONFIG_ENCODER_SORT) )
+		{
+			merge(viewRemap);
+		}
+		else
+		{
+			radixSortRenderItems(viewRemap);
+		}
+
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+		}
+
+		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+	}
+
+	void Frame::radixSortRenderItems(ViewId* _viewRemap)
+	{
+		// Encoders fill render item slots in chunks reserved from the frame. Chunks
+		// can be partially filled, so compact keys of all used slots into
+		// contiguous range, and remap views in the same pass.
+		bx::quickSort(
+			  m_renderItemChunk
+			, m_numRenderItemChunks
+			, sizeof(RenderItemChunk)
+			, [](const void* _lhs, const void* _rhs) -> int32_t
+			{
+				const RenderItemChunk& lhs = *(const RenderItemChunk*)_lhs;
+				const RenderItemChunk& rhs = *(const RenderItemChunk*)_rhs;
+				return lhs.m_first < rhs.m_first ? -1 : 1;
+			});
+
+		uint32_t numRenderItems = 0;
+		for (uint32_t ii = 0, num = m_numRenderItemChunks; ii < num; ++ii)
+		{
+			numRenderItems += m_renderItemChunk[ii].m_num;
+		}
+
+		m_numRenderItems = numRenderItems;
+
+		// Pool is shared with topologySortTriList, which may be called from any thread.
+		WorkerPool& pool = s_ctx->m_sortWorkerPool;
+		const uint32_t numTasks = bx::min(pool.getNumThreads(), numRenderItems/RenderItemSortMt::kMinItemsPerTask);
+
+		if (1 < numTasks
+		&&  pool.tryAcquire() )
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Sort MT", 0xff2040ff);
+
+			RenderItemSortMt& ctx = s_renderItemSortMt;
+			ctx.m_chunk     = m_renderItemChunk;
+			ctx.m_numChunks = m_numRenderItemChunks;
+			ctx.m_viewRemap = _viewRemap;
+			ctx.m_keys[0]   = m_sortKeys;
+			ctx.m_keys[1]   = s_ctx->m_tempKeys;
+			ctx.m_values[0] = m_sortValues;
+			ctx.m_values[1] = s_ctx->m_tempValues;
+			ctx.m_num       = numRenderItems;
+
+			ctx.m_chunkOffset[0] = 0;
+			for (uint32_t ii = 0, num = m_numRenderItemChunks; ii < num; ++ii)
+			{
+				ctx.m_chunkOffset[ii+1] = ctx.m_chunkOffset[ii] + m_renderItemChunk[ii].m_num;
+			}
+
+			ctx.sort(pool, numTasks);
+
+			pool.release();
+		}
+		else
+		{
+			// Chunks are visited in slot order, so compaction in place never
+			// overwrites unread keys.
+			uint32_t idx = 0;
+			for (uint32_t chunkIdx = 0, numChunks = m_numRenderItemChunks; chunkIdx < numChunks; ++chunkIdx)
+			{
+				const RenderItemChunk& chunk = m_renderItemChunk[chunkIdx];
+
+				for (uint32_t ii = chunk.m_first, end = chunk.m_first+chunk.m_num; ii < end; ++ii, ++idx)
+				{
+					m_sortKeys[idx]   = SortKey::remapView(m_sortKeys[ii], _viewRemap);
+					m_sortValues[idx] = RenderItemCount(ii);
+				}
+			}
+
+			bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+		}
+	}
+
+	// Runs of render items presorted by encoders, merged by Frame::merge.
+	struct RenderItemMerge
+	{
+		static constexpr uint32_t kMaxRuns = 4<<10;
+
+		bool less(uint32_t _lhs, uint32_t _rhs) const
+		{
+			const uint64_t lhsKey = m_keys[m_begin[_lhs] ];
+			const uint64_t rhsKey = m_keys[m_begin[_rhs] ];
+
+			return lhsKey < rhsKey
+				|| (lhsKey == rhsKey && m_values[m_begin[_lhs] ] < m_values[m_begin[_rhs] ])
+				;
+		}
+
+		void siftDown(uint32_t _idx)
+		{
+			for (;;)
+			{
+				const uint32_t left  = _idx*2+1;
+				const uint32_t right = left+1;
+
+				uint32_t smallest = _idx;
+				if (left < m_numHeap
+				&&  less(m_heap[left], m_heap[smallest]) )
+				{
+					smallest = left;
+				}
+
+				if (right < m_numHeap
+				&&  less(m_heap[right], m_heap[smallest]) )
+				{
+					smallest = right;
+				}
+
+				if (smallest == _idx)
+				{
+					break;
+				}
+
+				bx::swap(m_heap[_idx], m_heap[smallest]);
+				_idx = smallest;
+			}
+		}
+
+		void merge(uint64_t* _dstKeys, RenderItemCount* _dstValues, uint32_t _numRuns)
+		{
+			m_numHeap = _numRuns;
+			for (uint32_t ii = 0; ii < _numRuns; ++ii)
+			{
+				m_heap[ii] = ii;
+			}
+
+			for (uint32_t ii = _numRuns/2; ii > 0; --ii)
+			{
+				siftDown(ii-1);
+			}
+
+			for (uint32_t dst = 0; 0 < m_numHeap; ++dst)
+			{
+				const uint32_t run = m_heap[0];
+				const uint32_t src = m_begin[run]++;
+
+				_dstKeys[dst]   = m_keys[src];
+				_dstValues[dst] = m_values[src];
+
+				if (m_begin[run] == m_end[run])
+				{
+					m_heap[0] = m_heap[--m_numHeap];
+				}
+
+				siftDown(0);
+			}
+		}
+
+		const uint64_t*        m_keys;
+		const RenderItemCount* m_values;
+		uint32_t m_numHeap;
+
+		uint32_t m_begin[kMaxRuns];
+		uint32_t m_end[kMaxRuns];
+		uint32_t m_heap[kMaxRuns];
+	};
+
+	static RenderItemMerge s_renderItemMerge;
+
+	void EncoderImpl::sortRenderItems()
+	{
+		uint32_t num = 0;
+		for (uint32_t ii = 0, numChunks = m_numChunks; ii < numChunks; ++ii)
 		{
-			discard(_flags);
-			return;
+			num += m_chunk[ii].m_num;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		if (m_sortCapacity < num)
 		{
-			discard(_flags);
-			++m_numDropped;
-			return;
+			m_sortCapacity = bx::min<uint32_t>(bx::max(num, m_sortCapacity*2), BGFX_CONFIG_MAX_DRAW_CALLS);
+			m_sortKeys     = (uint64_t*)bx::realloc(g_allocator, m_sortKeys, m_sortCapacity*2*(sizeof(uint64_t)+sizeof(RenderItemCount) ) );
+			m_sortValues   = (RenderItemCount*)&m_sortKeys[m_sortCapacity*2];
 		}
 
-		++m_numSubmitted;
+		uint64_t*        keys       = m_sortKeys;
+		uint64_t*        tempKeys   = &m_sortKeys[m_sortCapacity];
+		RenderItemCount* values     = m_sortValues;
+		RenderItemCount* tempValues = &m_sortValues[m_sortCapacity];
 
-		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-		m_uniformEnd = uniformBuffer->getPos();
+		uint32_t idx = 0;
+		for (uint32_t ii = 0, numChunks = m_numChunks; ii < numChunks; ++ii)
+		{
+			const Frame::RenderItemChunk& chunk = m_chunk[ii];
 
-		m_compute.m_startMatrix = m_draw.m_startMatrix;
-		m_compute.m_numMatrices = m_draw.m_numMatrices;
-		m_compute.m_numX   = bx::max(_numX, 1u);
-		m_compute.m_numY   = bx::max(_numY, 1u);
-		m_compute.m_numZ   = bx::max(_numZ, 1u);
+			for (uint32_t slot = chunk.m_first, end = chunk.m_first+chunk.m_num; slot < end; ++slot, ++idx)
+			{
+				keys[idx]   = m_frame->m_sortKeys[slot];
+				values[idx] = RenderItemCount(slot);
+			}
+		}
 
-		m_key.m_program = _handle;
-		m_key.m_depth   = 0;
-		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+		bx::radixSort(keys, tempKeys, values, tempValues, num);
 
-		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		// Write sorted run back into slots owned by this encoder. Sort values
+		// keep pointing to original render item of each key.
+		idx = 0;
+		for (uint32_t ii = 0, numChunks = m_numChunks; ii < numChunks; ++ii)
+		{
+			const Frame::RenderItemChunk& chunk = m_chunk[ii];
 
-		m_compute.m_uniformIdx   = m_uniformIdx;
-		m_compute.m_uniformBegin = m_uniformBegin;
-		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+			for (uint32_t slot = chunk.m_first, end = chunk.m_first+chunk.m_num; slot < end; ++slot, ++idx)
+			{
+				m_frame->m_sortKeys[slot]   = keys[idx];
+				m_frame->m_sortValues[slot] = values[idx];
+			}
+		}
 
-		m_compute.clear(_flags);
-		m_bind.clear(_flags);
-		m_uniformBegin = m_uniformEnd;
+		m_numChunks = 0;
 	}
 
-	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	void Frame::merge(ViewId* _viewRemap)
 	{
-		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
-			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
-			, BGFX_CONFIG_MAX_BLIT_ITEMS
-			);
-		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
-		{
-			uint16_t item = m_frame->m_numBlitItems++;
+		BGFX_PROFILER_SCOPE("bgfx/Merge", 0xff2040ff);
 
-			BlitItem& bi = m_frame->m_blitItem[item];
-			bi.m_srcX    = _srcX;
-			bi.m_srcY    = _srcY;
-			bi.m_srcZ    = _srcZ;
-			bi.m_dstX    = _dstX;
-			bi.m_dstY    = _dstY;
-			bi.m_dstZ    = _dstZ;
-			bi.m_width   = _width;
-			bi.m_height  = _height;
-			bi.m_depth   = _depth;
-			bi.m_srcMip  = _srcMip;
-			bi.m_dstMip  = _dstMip;
-			bi.m_src     = _src;
-			bi.m_dst     = _dst;
+		// Group chunks by encoder, in slot order, so that keys of each encoder
+		// form its presorted run.
+		bx::quickSort(
+			  m_renderItemChunk
+			, m_numRenderItemChunks
+			, sizeof(RenderItemChunk)
+			, [](const void* _lhs, const void* _rhs) -> int32_t
+			{
+				const RenderItemChunk& lhs = *(const RenderItemChunk*)_lhs;
+				const RenderItemChunk& rhs = *(const RenderItemChunk*)_rhs;
 
-			BlitKey key;
-			key.m_view = _id;
-			key.m_item = item;
-			m_frame->m_blitKeys[item] = key.encode();
-		}
-	}
+				if (lhs.m_encoder != rhs.m_encoder)
+				{
+					return lhs.m_encoder < rhs.m_encoder ? -1 : 1;
+				}
 
-	void Frame::sort()
-	{
-		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+				return lhs.m_first < rhs.m_first ? -1 : 1;
+			});
 
-		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
-		{
-			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+		RenderItemMerge& ctx = s_renderItemMerge;
+		uint64_t*        keys   = s_ctx->m_tempKeys;
+		RenderItemCount* values = s_ctx->m_tempValues;
 
-			View& view = m_view[ii];
-			Rect rect(0, 0, uint16_t(m_resolution.width), uint16_t(m_resolution.height) );
+		// View remap can reorder views, so presorted run stays sorted only
+		// between view changes. Split runs where keys stop being ascending.
+		uint32_t num      = 0;
+		uint32_t numRuns  = 0;
+		uint32_t encoder  = UINT32_MAX;
+		bool     overflow = false;
 
-			if (isValid(view.m_fbh) )
+		for (uint32_t chunkIdx = 0, numChunks = m_numRenderItemChunks; chunkIdx < numChunks; ++chunkIdx)
+		{
+			const RenderItemChunk& chunk = m_renderItemChunk[chunkIdx];
+
+			for (uint32_t slot = chunk.m_first, end = chunk.m_first+chunk.m_num; slot < end; ++slot, ++num)
 			{
-				const FrameBufferRef& fbr = s_ctx->m_frameBufferRef[view.m_fbh.idx];
-				const BackbufferRatio::Enum bbRatio = fbr.m_window
-					? BackbufferRatio::Count
-					: BackbufferRatio::Enum(s_ctx->m_textureRef[fbr.un.m_th[0].idx].m_bbRatio)
-					;
+				const uint64_t key = SortKey::remapView(m_sortKeys[slot], _viewRemap);
 
-				if (BackbufferRatio::Count != bbRatio)
+				if (encoder != chunk.m_encoder
+				||  key < keys[num-1])
 				{
-					getTextureSizeFromRatio(bbRatio, rect.m_width, rect.m_height);
-				}
-				else
-				{
-					rect.m_width  = fbr.m_width;
-					rect.m_height = fbr.m_height;
-				}
-			}
+					encoder  = chunk.m_encoder;
+					overflow = overflow || RenderItemMerge::kMaxRuns == numRuns;
 
-			view.m_rect.intersect(rect);
+					if (!overflow)
+					{
+						if (0 < numRuns)
+						{
+							ctx.m_end[numRuns-1] = num;
+						}
 
-			if (!view.m_scissor.isZero() )
-			{
-				view.m_scissor.intersect(rect);
+						ctx.m_begin[numRuns] = num;
+						++numRuns;
+					}
+				}
+
+				keys[num]   = key;
+				values[num] = m_sortValues[slot];
 			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		m_numRenderItems = num;
+
+		if (overflow)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			BX_TRACE("Too many presorted render item runs, falling back to radix sort.");
+			bx::radixSort(keys, m_sortKeys, values, m_sortValues, num);
+			bx::memCopy(m_sortKeys,   keys,   num*sizeof(uint64_t) );
+			bx::memCopy(m_sortValues, values, num*sizeof(RenderItemCount) );
+			return;
 		}
 
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
-
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		if (0 < numRuns)
 		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			ctx.m_end[numRuns-1] = num;
+			ctx.m_keys   = keys;
+			ctx.m_values = values;
+			ctx.merge(m_sortKeys, m_sortValues, numRuns);
 		}
-
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1970,6 +2844,7 @@ namespace bgfx
 		m_flipAfterRender = !!(m_init.resolution.reset & BGFX_RESET_FLIP_AFTER_RENDER);
 
 		m_submit->create(_init.limits.minResourceCbSize);
+		m_sortWorkerPool.init(_init.limits.maxSortThreads, "bgfx - sort worker");
 
 #if BGFX_CONFIG_MULTITHREADED
 		m_render->create(_init.limits.minResourceCbSize);
@@ -2050,6 +2925,7 @@ namespace bgfx
 			frame();
 			m_vertexLayoutRef.shutdown(m_layoutHandle);
 			m_submit->destroy();
+			m_sortWorkerPool.shutdown();
 #if BGFX_CONFIG_MULTITHREADED
 			m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
@@ -2138,8 +3014,10 @@ namespace bgfx
 		bx::alignedFree(g_allocator, m_encoder, BX_ALIGNOF(EncoderImpl) );
 		bx::free(g_allocator, m_encoderStats);
 
-		m_dynVertexBufferAllocator.compact();
-		m_dynIndexBufferAllocator.compact();
+		for (uint16_t ii = 0, num = m_drawBundleHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_drawBundle[m_drawBundleHandle.getHandleAt(ii)].destroy();
+		}
 
 		BX_ASSERT(
 			  m_layoutHandle.getNumHandles() == m_vertexLayoutRef.m_vertexLayoutMap.getNumElements()
@@ -2165,6 +3043,8 @@ namespace bgfx
 		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		m_sortWorkerPool.shutdown();
+
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
@@ -2244,6 +3124,7 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("DrawBundleHandle",          m_drawBundleHandle                                          );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
@@ -2389,6 +3270,8 @@ namespace bgfx
 
 	void Context::swap()
 	{
+		transientSwapBegin();
+
 		freeDynamicBuffers();
 		m_submit->m_resolution = m_init.resolution;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
@@ -2433,6 +3316,8 @@ namespace bgfx
 		int64_t now = bx::getHPCounter();
 		m_submit->m_perfStats.cpuTimeFrame = now - m_frameTimeLast;
 		m_frameTimeLast = now;
+
+		transientSwapEnd();
 	}
 
 	///
@@ -2505,6 +3390,11 @@ namespace bgfx
 
 			if (m_rendererInitialized)
 			{
+				{
+					BGFX_PROFILER_SCOPE("bgfx/Pending uploads", 0xff2040ff);
+					flushPendingUploads();
+				}
+
 				{
 					BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
 					m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
@@ -2648,6 +3538,137 @@ namespace bgfx
 		}
 	}
 
+	// Deferred update can outlive 2 frames guaranteed for memory passed by reference,
+	// so referenced data is copied and reference is released right away.
+	static const Memory* deferMemory(const Memory* _mem)
+	{
+		if (isMemoryRef(_mem) )
+		{
+			const Memory* mem = copy(_mem->data, _mem->size);
+			release(_mem);
+			return mem;
+		}
+
+		return _mem;
+	}
+
+	void Context::queueTextureUpdate(CommandBuffer& _cmdbuf)
+	{
+		PendingTextureUpdate update;
+		_cmdbuf.read(update.m_handle);
+		_cmdbuf.read(update.m_side);
+		_cmdbuf.read(update.m_mip);
+		_cmdbuf.read(update.m_rect);
+		_cmdbuf.read(update.m_z);
+		_cmdbuf.read(update.m_depth);
+		_cmdbuf.read(update.m_pitch);
+		_cmdbuf.read(update.m_mem);
+		update.m_mem = deferMemory(update.m_mem);
+
+		// Keep queue ordered from smallest to largest mip, so that low resolution version of
+		// texture becomes available first. Updates of the same mip stay in submission order.
+		PendingTextureUpdateArray::iterator it = m_pendingTextureUpdate.end();
+		while (it != m_pendingTextureUpdate.begin()
+		&&     (it-1)->m_mip < update.m_mip)
+		{
+			--it;
+		}
+
+		m_pendingTextureUpdate.insert(it, update);
+		bx::atomicFetchAndAdd<uint32_t>(&m_textureUploadPending[update.m_handle.idx], update.m_mem->size);
+	}
+
+	void Context::discardPendingTextureUpdates(TextureHandle _handle)
+	{
+		if (0 == bx::atomicFetchAndAdd<uint32_t>(&m_textureUploadPending[_handle.idx], 0) )
+		{
+			return;
+		}
+
+		for (uint32_t ii = 0; ii < m_pendingTextureUpdate.size();)
+		{
+			const PendingTextureUpdate& update = m_pendingTextureUpdate[ii];
+			if (update.m_handle.idx == _handle.idx)
+			{
+				release(update.m_mem);
+				m_pendingTextureUpdate.erase(m_pendingTextureUpdate.begin() + ii);
+			}
+			else
+			{
+				++ii;
+			}
+		}
+
+		clearTextureUploadPending(_handle.idx);
+	}
+
+	void Context::clearTextureUploadPending(uint16_t _idx)
+	{
+		// Only render thread writes m_textureUploadPending, API thread reads it in
+		// isTextureResident.
+		const uint32_t pending = bx::atomicFetchAndAdd<uint32_t>(&m_textureUploadPending[_idx], 0);
+		bx::atomicCompareAndSwap<uint32_t>(&m_textureUploadPending[_idx], pending, 0);
+	}
+
+	void Context::flushPendingUploads()
+	{
+		const uint32_t maxUploadSize = m_init.limits.maxUploadSize;
+		uint32_t uploaded = 0;
+
+		// Budget applies to texture updates only. Dynamic buffer updates are executed with
+		// the rest of the frame's commands, since draw calls in the same frame depend on
+		// them. At least one texture update is always uploaded per frame, even if it's over
+		// budget, so that queue keeps moving.
+		uint32_t numTextures = 0;
+		uint32_t currentKey  = UINT32_MAX;
+		for (uint32_t num = m_pendingTextureUpdate.size(); numTextures < num && uploaded < maxUploadSize; ++numTextures)
+		{
+			const PendingTextureUpdate& update = m_pendingTextureUpdate[numTextures];
+
+			const uint32_t key = (update.m_handle.idx<<16)
+				| (update.m_side<<8)
+				| update.m_mip
+				;
+
+			if (key != currentKey)
+			{
+				if (currentKey != UINT32_MAX)
+				{
+					m_renderCtx->updateTextureEnd();
+				}
+				currentKey = key;
+				m_renderCtx->updateTextureBegin(update.m_handle, update.m_side, update.m_mip);
+			}
+
+			m_renderCtx->updateTexture(
+				  update.m_handle
+				, update.m_side
+				, update.m_mip
+				, update.m_rect
+				, update.m_z
+				, update.m_depth
+				, update.m_pitch
+				, update.m_mem
+				);
+
+			const uint32_t size = update.m_mem->size;
+			uploaded += size;
+			bx::atomicFetchAndAdd<uint32_t>(&m_textureUploadPending[update.m_handle.idx], 0-size);
+			release(update.m_mem);
+		}
+
+		if (currentKey != UINT32_MAX)
+		{
+			m_renderCtx->updateTextureEnd();
+		}
+
+		m_pendingTextureUpdate.erase(m_pendingTextureUpdate.begin(), m_pendingTextureUpdate.begin() + numTextures);
+
+		// All updates submitted up to this frame are either uploaded or accounted for in
+		// m_textureUploadPending.
+		bx::atomicCompareAndSwap<uint32_t>(&m_uploadFrameNum, m_uploadFrameNum, m_render->m_frameNum + 1);
+	}
+
 	typedef RendererContextI* (*RendererCreateFn)(const Init& _init);
 	typedef void (*RendererDestroyFn)();
 
@@ -2901,6 +3922,18 @@ namespace bgfx
 				{
 					BX_ASSERT(m_rendererInitialized, "This shouldn't happen! Bad synchronization?");
 					m_rendererInitialized = false;
+
+					for (uint32_t ii = 0, num = m_pendingTextureUpdate.size(); ii < num; ++ii)
+					{
+						release(m_pendingTextureUpdate[ii].m_mem);
+					}
+
+					m_pendingTextureUpdate.clear();
+
+					for (uint16_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURES; ++ii)
+					{
+						clearTextureUploadPending(ii);
+					}
 				}
 				break;
 
@@ -3209,6 +4242,12 @@ namespace bgfx
 				{
 					BGFX_PROFILER_SCOPE("UpdateTexture", 0xff2040ff);
 
+					if (0 != m_init.limits.maxUploadSize)
+					{
+						queueTextureUpdate(_cmdbuf);
+						break;
+					}
+
 					if (m_textureUpdateBatch.isFull() )
 					{
 						flushTextureUpdateBatch(_cmdbuf);
@@ -3276,6 +4315,7 @@ namespace bgfx
 					uint16_t numLayers;
 					_cmdbuf.read(numLayers);
 
+					discardPendingTextureUpdates(handle);
 					m_renderCtx->resizeTexture(handle, width, height, numMips, numLayers);
 				}
 				break;
@@ -3287,6 +4327,7 @@ namespace bgfx
 					TextureHandle handle;
 					_cmdbuf.read(handle);
 
+					discardPendingTextureUpdates(handle);
 					m_renderCtx->destroyTexture(handle);
 				}
 				break;
@@ -3439,9 +4480,61 @@ namespace bgfx
 		return topologyConvert(_conversion, _dst, _dstSize, _indices, _numIndices, _index32, g_allocator);
 	}
 
+	// Sort worker pool is used when bgfx is initialized and pool is not busy sorting
+	// render items, otherwise topology is sorted on the calling thread.
+	static WorkerPool* acquireTopologySortPool()
+	{
+		if (NULL != s_ctx
+		&&  s_ctx->m_sortWorkerPool.tryAcquire() )
+		{
+			return &s_ctx->m_sortWorkerPool;
+		}
+
+		return NULL;
+	}
+
 	void topologySortTriList(TopologySort::Enum _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
 	{
-		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator);
+		WorkerPool* pool = acquireTopologySortPool();
+
+		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator, pool);
+
+		if (NULL != pool)
+		{
+			pool->release();
+		}
+	}
+
+	uint32_t topologySortTriList(TopologySort::Enum _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, void* _scratch, uint32_t _scratchSize, bool _coherent)
+	{
+		const uint32_t scratchSize = topologySortTriListScratchSize(_numIndices);
+
+		if (NULL == _scratch)
+		{
+			return scratchSize;
+		}
+
+		BX_ASSERT(_scratchSize >= scratchSize
+			, "Scratch memory is too small (%d bytes), %d bytes are required."
+			, _scratchSize
+			, scratchSize
+			);
+
+		if (_scratchSize < scratchSize)
+		{
+			return scratchSize;
+		}
+
+		WorkerPool* pool = acquireTopologySortPool();
+
+		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, _scratch, _coherent, pool);
+
+		if (NULL != pool)
+		{
+			pool->release();
+		}
+
+		return scratchSize;
 	}
 
 	uint8_t getSupportedRenderers(uint8_t _max, RendererType::Enum* _enum)
@@ -3506,6 +4599,8 @@ namespace bgfx
 		, minResourceCbSize(BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE)
 		, transientVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE)
 		, transientIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+		, maxSortThreads(BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS)
+		, maxUploadSize(BGFX_CONFIG_DEFAULT_MAX_UPLOAD_SIZE)
 	{
 	}
 
@@ -3543,6 +4638,7 @@ namespace bgfx
 
 		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
+		init.limits.maxSortThreads    = bx::min<uint16_t>(init.limits.maxSortThreads, (0 != BGFX_CONFIG_MULTITHREADED) ? BGFX_CONFIG_MAX_WORKER_THREADS : 0);
 
 		struct ErrorState
 		{
@@ -3762,6 +4858,7 @@ namespace bgfx
 		const UniformRef& uniform = s_ctx->m_uniformRef[_handle.idx];
 		BX_ASSERT(isValid(_handle) && 0 < uniform.m_refCount, "Setting invalid uniform (handle %3d)!", _handle.idx);
 		BX_ASSERT(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+		BGFX_ENCODER(addDrawBundleRef(Handle::Uniform, _handle.idx) );
 		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, UINT16_MAX != _num ? _num : uniform.m_num) );
 	}
 
@@ -3786,6 +4883,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawBundleRef(Handle::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setIndexBuffer(dib, _firstIndex, _numIndices) );
 	}
 
@@ -3830,6 +4928,7 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_layoutHandle, _layoutHandle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawBundleRef(Handle::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setVertexBuffer(_stream, dvb, _startVertex, _numVertices, _layoutHandle) );
 	}
 
@@ -3885,6 +4984,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawBundleRef(Handle::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setInstanceDataBuffer(dvb.m_handle
 			, dvb.m_startVertex + _startVertex
 			, _num
@@ -3913,6 +5013,7 @@ namespace bgfx
 			BX_UNUSED(ref);
 		}
 
+		BGFX_ENCODER(addDrawBundleRef(Handle::Uniform, _sampler.idx) );
 		BGFX_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
@@ -3958,6 +5059,23 @@ namespace bgfx
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags) );
 	}
 
+	void Encoder::beginDrawBundle(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("beginDrawBundle", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(beginDrawBundle(&s_ctx->m_drawBundle[_handle.idx]) );
+	}
+
+	void Encoder::endDrawBundle()
+	{
+		BGFX_ENCODER(endDrawBundle() );
+	}
+
+	void Encoder::submit(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(submit(s_ctx->m_drawBundle[_handle.idx]) );
+	}
+
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
@@ -3977,6 +5095,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawBundleRef(Handle::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dib.m_handle, _access) );
 	}
 
@@ -3985,6 +5104,7 @@ namespace bgfx
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addDrawBundleRef(Handle::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dvb.m_handle, _access) );
 	}
 
@@ -4380,17 +5500,26 @@ namespace bgfx
 
 	bool allocTransientBuffers(bgfx::TransientVertexBuffer* _tvb, const bgfx::VertexLayout& _layout, uint32_t _numVertices, bgfx::TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32)
 	{
-		BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+		BX_ASSERT(NULL != _tvb, "_tvb can't be NULL");
+		BX_ASSERT(NULL != _tib, "_tib can't be NULL");
+		BX_ASSERT(0 < _numVertices, "Requesting 0 vertices.");
+		BX_ASSERT(0 < _numIndices, "Requesting 0 indices.");
+		BX_ASSERT(isValid(_layout), "Invalid VertexLayout.");
 
-		if (_numVertices == getAvailTransientVertexBuffer(_numVertices, _layout)
-		&&  _numIndices  == getAvailTransientIndexBuffer(_numIndices, _index32) )
+		if (_numVertices != getAvailTransientVertexBuffer(_numVertices, _layout)
+		||  _numIndices  != getAvailTransientIndexBuffer(_numIndices, _index32) )
 		{
-			allocTransientVertexBuffer(_tvb, _numVertices, _layout);
-			allocTransientIndexBuffer(_tib, _numIndices, _index32);
-			return true;
+			return false;
 		}
 
-		return false;
+		VertexLayoutHandle layoutHandle;
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			layoutHandle = s_ctx->findOrCreateVertexLayout(_layout, true);
+		}
+		BX_ASSERT(isValid(layoutHandle), "Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
+
+		return s_ctx->allocTransientBuffers(_tvb, layoutHandle, _layout.m_stride, _numVertices, _tib, _numIndices, _index32);
 	}
 
 	void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
@@ -5058,6 +6187,11 @@ namespace bgfx
 		return s_ctx->getDirectAccessPtr(_handle);
 	}
 
+	bool isTextureResident(TextureHandle _handle)
+	{
+		return s_ctx->isTextureResident(_handle);
+	}
+
 	void destroy(TextureHandle _handle)
 	{
 		s_ctx->destroyTexture(_handle);
@@ -5227,6 +6361,16 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	DrawBundleHandle createDrawBundle()
+	{
+		return s_ctx->createDrawBundle();
+	}
+
+	void destroy(DrawBundleHandle _handle)
+	{
+		s_ctx->destroyDrawBundle(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -5565,6 +6709,24 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _numHandle, _numIndex, _numMax, _depth, _flags);
 	}
 
+	void beginDrawBundle(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->beginDrawBundle(_handle);
+	}
+
+	void endDrawBundle()
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->endDrawBundle();
+	}
+
+	void submit(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_ENCODER0();
+		s_ctx->m_encoder0->submit(_handle);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_ENCODER0();
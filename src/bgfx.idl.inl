@@ -130,6 +130,11 @@ BGFX_C_API void bgfx_topology_sort_tri_list(bgfx_topology_sort_t _sort, void* _d
 	bgfx::topologySortTriList((bgfx::TopologySort::Enum)_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32);
 }
 
+BGFX_C_API uint32_t bgfx_topology_sort_tri_list_scratch(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32, void* _scratch, uint32_t _scratchSize, bool _coherent)
+{
+	return bgfx::topologySortTriList((bgfx::TopologySort::Enum)_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, _scratch, _scratchSize, _coherent);
+}
+
 BGFX_C_API uint8_t bgfx_get_supported_renderers(uint8_t _max, bgfx_renderer_type_t* _enum)
 {
 	return bgfx::getSupportedRenderers(_max, (bgfx::RendererType::Enum*)_enum);
@@ -515,6 +520,12 @@ BGFX_C_API void* bgfx_get_direct_access_ptr(bgfx_texture_handle_t _handle)
 	return bgfx::getDirectAccessPtr(handle.cpp);
 }
 
+BGFX_C_API bool bgfx_is_texture_resident(bgfx_texture_handle_t _handle)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::isTextureResident(handle.cpp);
+}
+
 BGFX_C_API void bgfx_destroy_texture(bgfx_texture_handle_t _handle)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
@@ -615,6 +626,19 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle(void)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createDrawBundle();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -894,6 +918,26 @@ BGFX_C_API void bgfx_encoder_submit_indirect_count(bgfx_encoder_t* _this, bgfx_v
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, numHandle.cpp, _numIndex, _numMax, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->endDrawBundle();
+}
+
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->submit(handle.cpp);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -1172,6 +1216,23 @@ BGFX_C_API void bgfx_submit_indirect_count(bgfx_view_id_t _id, bgfx_program_hand
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, numHandle.cpp, _numIndex, _numMax, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_end_draw_bundle(void)
+{
+	bgfx::endDrawBundle();
+}
+
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::submit(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1286,6 +1347,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_weld_vertices,
 			bgfx_topology_convert,
 			bgfx_topology_sort_tri_list,
+			bgfx_topology_sort_tri_list_scratch,
 			bgfx_get_supported_renderers,
 			bgfx_get_renderer_name,
 			bgfx_init_ctor,
@@ -1351,6 +1413,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_read_texture,
 			bgfx_set_texture_name,
 			bgfx_get_direct_access_ptr,
+			bgfx_is_texture_resident,
 			bgfx_destroy_texture,
 			bgfx_create_frame_buffer,
 			bgfx_create_frame_buffer_scaled,
@@ -1366,6 +1429,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_draw_bundle,
+			bgfx_destroy_draw_bundle,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1411,6 +1476,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
 			bgfx_encoder_submit_indirect_count,
+			bgfx_encoder_begin_draw_bundle,
+			bgfx_encoder_end_draw_bundle,
+			bgfx_encoder_submit_draw_bundle,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1457,6 +1525,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
 			bgfx_submit_indirect_count,
+			bgfx_begin_draw_bundle,
+			bgfx_end_draw_bundle,
+			bgfx_submit_draw_bundle,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
@@ -147,6 +147,7 @@ namespace bgfx
 #include "shader.h"
 #include "vertexlayout.h"
 #include "version.h"
+#include "worker.h"
 
 #define BGFX_CHUNK_MAGIC_TEX BX_MAKEFOURCC('T', 'E', 'X', 0x0)
 
@@ -173,41 +174,8 @@ namespace bgfx
 #	include <tinystl/unordered_set.h>
 #	include <tinystl/vector.h>
 
-namespace tinystl
-{
-	template<typename T, typename Alloc = TINYSTL_ALLOCATOR>
-	class list : public vector<T, Alloc>
-	{
-	public:
-		void push_front(const T& _value)
-		{
-			this->insert(this->begin(), _value);
-		}
-
-		void pop_front()
-		{
-			this->erase(this->begin() );
-		}
-
-		void sort()
-		{
-			bx::quickSort(
-				  this->begin()
-				, uint32_t(this->end() - this->begin() )
-				, sizeof(T)
-				, [](const void* _a, const void* _b) -> int32_t {
-					const T& lhs = *(const T*)(_a);
-					const T& rhs = *(const T*)(_b);
-					return lhs < rhs ? -1 : 1;
-				});
-		}
-	};
-
-} // namespace tinystl
-
 namespace stl = tinystl;
 #else
-#	include <list>
 #	include <string>
 #	include <unordered_map>
 #	include <unordered_set>
@@ -585,6 +553,7 @@ namespace bgfx
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	bool isMemoryRef(const Memory* _mem);
 	const char* getAttribName(Attrib::Enum _attr);
 	const char* getAttribNameShort(Attrib::Enum _attr);
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height);
@@ -1451,6 +1420,17 @@ namespace bgfx
 			return first;
 		}
 
+		uint32_t add(const Rect* _rect, uint32_t* _num)
+		{
+			uint32_t num = *_num;
+			const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_RECT_CACHE-1);
+			BX_WARN(first+num < BGFX_CONFIG_MAX_RECT_CACHE, "Rect cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_RECT_CACHE);
+			num = bx::min(num, BGFX_CONFIG_MAX_RECT_CACHE-1-first);
+			bx::memCopy(&m_cache[first], _rect, num*sizeof(Rect) );
+			*_num = num;
+			return first;
+		}
+
 		Rect     m_cache[BGFX_CONFIG_MAX_RECT_CACHE];
 		uint32_t m_num;
 	};
@@ -1571,6 +1551,12 @@ namespace bgfx
 			return m_pos;
 		}
 
+		const char* getData(uint32_t _pos) const
+		{
+			BX_ASSERT(_pos <= m_size, "Out of bounds %d (size: %d).", _pos, m_size);
+			return &m_buffer[_pos];
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -1688,6 +1674,8 @@ namespace bgfx
 		VertexLayoutHandle m_layoutHandle;
 	};
 
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS <= 32, "Binding stage mask must fit into 32 bits.");
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) RenderBind
 	{
 		void clear(uint8_t _flags = BGFX_DISCARD_ALL)
@@ -1707,9 +1695,45 @@ namespace bgfx
 			}
 		};
 
+		/// Returns mask of used binding stages.
+		uint32_t getMask(uint32_t* _num) const
+		{
+			uint32_t mask = 0;
+			uint32_t num  = 0;
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+			{
+				if (kInvalidHandle != m_bind[ii].m_idx)
+				{
+					mask |= UINT32_C(1)<<ii;
+					++num;
+				}
+			}
+
+			*_num = num;
+			return mask;
+		}
+
+		/// Store only used binding stages.
+		void pack(Binding* _dst, uint32_t _mask) const
+		{
+			for (uint32_t mask = _mask; 0 != mask; mask &= mask-1)
+			{
+				const uint32_t ii = bx::uint32_cnttz(mask);
+				bx::memCopy(_dst++, &m_bind[ii], sizeof(Binding) );
+			}
+		}
+
 		Binding m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 	};
 
+	/// Reference to render item bindings stored in frame binding pool.
+	struct RenderBindRef
+	{
+		uint32_t m_first;
+		uint32_t m_mask;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) RenderDraw
 	{
 		void clear(uint8_t _flags = BGFX_DISCARD_ALL)
@@ -2029,6 +2053,7 @@ namespace bgfx
 		uint8_t  m_numSamples;
 		uint8_t  m_numMips;
 		uint16_t m_numLayers;
+		uint32_t m_uploadFrame;
 		bool     m_owned;
 		bool     m_immutable;
 		bool     m_cubeMap;
@@ -2157,6 +2182,25 @@ namespace bgfx
 		FrameBufferHandle handle;
 	};
 
+	/// Part of frame's transient buffer owned by single thread.
+	struct TransientChunk
+	{
+		enum Enum
+		{
+			Index,
+			Vertex,
+
+			Count
+		};
+
+		uint32_t m_frameId;
+		uint32_t m_offset;
+		uint32_t m_end;
+	};
+
+	/// Returns calling thread's transient chunk, or NULL when chunks are disabled.
+	TransientChunk* getTransientChunk(TransientChunk::Enum _type);
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
@@ -2172,6 +2216,7 @@ namespace bgfx
 			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
+			bx::memSet(&m_perfStats, 0, sizeof(m_perfStats) );
 			m_perfStats.viewStats = m_viewStats;
 
 			bx::memSet(&m_renderItemBind[0], 0, sizeof(m_renderItemBind));
@@ -2226,10 +2271,14 @@ namespace bgfx
 			m_perfStats.transientIbUsed = m_iboffset;
 
 			m_frameCache.reset();
-			m_numRenderItems = 0;
-			m_numBlitItems   = 0;
+			m_numRenderItems        = 0;
+			m_numRenderItemSlots    = 0;
+			m_numRenderItemChunks   = 0;
+			m_numRenderItemBindings = 0;
+			m_numBlitItems          = 0;
 			m_iboffset = 0;
 			m_vboffset = 0;
+			m_transientFrameId = bx::atomicAddAndFetch<uint32_t>(&s_transientFrameId, 1);
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
@@ -2244,43 +2293,170 @@ namespace bgfx
 		}
 
 		void sort();
+		void radixSortRenderItems(ViewId* _viewRemap);
+		void merge(ViewId* _viewRemap);
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		uint32_t reserveRenderItems(uint32_t* _num)
 		{
-			const uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t iboffset = offset + _num*_indexSize;
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			const uint32_t num = (iboffset-offset)/_indexSize;
-			return num;
+			const uint32_t num   = *_num;
+			const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_numRenderItemSlots, num, BGFX_CONFIG_MAX_DRAW_CALLS);
+			*_num = bx::min(num, BGFX_CONFIG_MAX_DRAW_CALLS-bx::min<uint32_t>(first, BGFX_CONFIG_MAX_DRAW_CALLS) );
+			return first;
 		}
 
-		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize)
+		/// Returns unused slots [_next, _end) of encoder's chunk back to the frame. Only
+		/// possible when no other encoder reserved slots after this chunk, and while the
+		/// frame has fewer than kMaxRenderItemChunks chunks retired.
+		void releaseRenderItems(uint32_t _next, uint32_t _end)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
-			m_iboffset = offset + num*_indexSize;
-			_num = num;
+			if (bx::atomicFetchAndAdd<uint32_t>(&m_numRenderItemChunks, 0) < kMaxRenderItemChunks)
+			{
+				bx::atomicCompareAndSwap<uint32_t>(&m_numRenderItemSlots, _end, _next);
+			}
+		}
 
-			return offset;
+		uint32_t reserveRenderItemBindings(uint32_t _num)
+		{
+			const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_numRenderItemBindings, _num, BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS);
+			BX_WARN(first+_num <= BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS
+				, "Render item bindings overflow. %d (max: %d)"
+				, first+_num
+				, BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS
+				);
+			return first+_num <= BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS ? first : UINT32_MAX;
 		}
 
-		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		/// Updates `_bind` with bindings of render item. Only stages used by
+		/// render item, or by previous render item `_prevRef`, are written.
+		/// Nothing is written if render item shares bindings with previous one.
+		void updateRenderBind(uint32_t _itemIdx, RenderBindRef& _prevRef, RenderBind& _bind) const
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
+			const RenderBindRef& ref = m_renderItemBind[_itemIdx];
+			if (ref.m_first == _prevRef.m_first
+			&&  ref.m_mask  == _prevRef.m_mask)
+			{
+				return;
+			}
+
+			for (uint32_t mask = _prevRef.m_mask & ~ref.m_mask; 0 != mask; mask &= mask-1)
+			{
+				Binding& bind = _bind.m_bind[bx::uint32_cnttz(mask)];
+				bx::memSet(&bind, 0, sizeof(Binding) );
+				bind.m_idx = kInvalidHandle;
+			}
+
+			const Binding* src = &m_renderItemBinding[ref.m_first];
+			for (uint32_t mask = ref.m_mask; 0 != mask; mask &= mask-1)
+			{
+				bx::memCopy(&_bind.m_bind[bx::uint32_cnttz(mask)], src++, sizeof(Binding) );
+			}
+
+			_prevRef = ref;
+		}
+
+		void addRenderItemChunk(uint32_t _first, uint32_t _num, uint32_t _encoder)
+		{
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_numRenderItemChunks, 1);
+			BX_ASSERT(idx < kMaxFrameRenderItemChunks, "Render item chunk overflow %d (max: %d).", idx, kMaxFrameRenderItemChunks);
+
+			RenderItemChunk& chunk = m_renderItemChunk[idx];
+			chunk.m_first   = _first;
+			chunk.m_num     = _num;
+			chunk.m_encoder = _encoder;
+		}
+
+		static uint32_t getAvailTransient(uint32_t _offset, uint32_t _size, uint32_t _num, uint16_t _stride)
+		{
+			const uint32_t offset = bx::strideAlign(_offset, _stride);
+			return offset < _size
+				? bx::min<uint32_t>(_num, (_size-offset)/_stride)
+				: 0
+				;
+		}
+
+		static uint32_t allocTransientShared(uint32_t* _offset, uint32_t _size, uint32_t& _num, uint16_t _stride, bool _all)
+		{
+			uint32_t current = bx::atomicFetchAndAdd<uint32_t>(_offset, 0);
+
+			for (;;)
+			{
+				const uint32_t offset = bx::strideAlign(current, _stride);
+
+				uint32_t num = getAvailTransient(current, _size, _num, _stride);
+				num = _all && num != _num ? 0 : num;
+
+				if (0 == num)
+				{
+					_num = 0;
+					return offset;
+				}
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_offset, current, offset + num*_stride);
+				if (prev == current)
+				{
+					_num = num;
+					return offset;
+				}
+
+				current = prev;
+			}
 		}
 
-		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		uint32_t allocTransient(uint32_t* _offset, uint32_t _size, uint32_t& _num, uint16_t _stride, TransientChunk* _chunk, bool _all)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			if (NULL != _chunk
+			&&  _num*_stride <= BGFX_CONFIG_TRANSIENT_CHUNK_SIZE/4)
+			{
+				if (_chunk->m_frameId != m_transientFrameId)
+				{
+					_chunk->m_frameId = m_transientFrameId;
+					_chunk->m_offset  = 0;
+					_chunk->m_end     = 0;
+				}
+
+				if (_num != getAvailTransient(_chunk->m_offset, _chunk->m_end, _num, _stride) )
+				{
+					uint32_t num = BGFX_CONFIG_TRANSIENT_CHUNK_SIZE/16;
+					const uint32_t first = allocTransientShared(_offset, _size, num, 16, true);
+
+					if (0 != num)
+					{
+						_chunk->m_offset = first;
+						_chunk->m_end    = first + num*16;
+					}
+				}
+
+				if (_num == getAvailTransient(_chunk->m_offset, _chunk->m_end, _num, _stride) )
+				{
+					const uint32_t offset = bx::strideAlign(_chunk->m_offset, _stride);
+					_chunk->m_offset = offset + _num*_stride;
+					return offset;
+				}
+			}
+
+			return allocTransientShared(_offset, _size, _num, _stride, _all);
+		}
 
-			return offset;
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint16_t _indexSize)
+		{
+			const uint32_t offset = bx::atomicFetchAndAdd<uint32_t>(&m_iboffset, 0);
+			return getAvailTransient(offset, g_caps.limits.transientIbSize, _num, _indexSize);
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint16_t _indexSize, TransientChunk* _chunk, bool _all = false)
+		{
+			return allocTransient(&m_iboffset, g_caps.limits.transientIbSize, _num, _indexSize, _chunk, _all);
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			const uint32_t offset = bx::atomicFetchAndAdd<uint32_t>(&m_vboffset, 0);
+			return getAvailTransient(offset, g_caps.limits.transientVbSize, _num, _stride);
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride, TransientChunk* _chunk, bool _all = false)
+		{
+			return allocTransient(&m_vboffset, g_caps.limits.transientVbSize, _num, _stride, _chunk, _all);
 		}
 
 		bool free(IndexBufferHandle _handle)
@@ -2345,7 +2521,23 @@ namespace bgfx
 		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
 		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
 		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		RenderBindRef m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS+1];
+		Binding m_renderItemBinding[BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS];
+
+		struct RenderItemChunk
+		{
+			uint32_t m_first;
+			uint32_t m_num;
+			uint32_t m_encoder;
+		};
+
+		// Within single encoder session all chunks except the last one are full. Chunk
+		// whose unused rest is not given back spans whole chunk of slots, so there can be
+		// at most kMaxRenderItemChunks+1 of those. Unused rest is given back only while
+		// fewer than kMaxRenderItemChunks chunks are retired, which bounds the others.
+		static constexpr uint32_t kMaxRenderItemChunks = (BGFX_CONFIG_MAX_DRAW_CALLS+BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE-1)/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+		static constexpr uint32_t kMaxFrameRenderItemChunks = kMaxRenderItemChunks*2+1;
+		RenderItemChunk m_renderItemChunk[kMaxFrameRenderItemChunks];
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
@@ -2354,10 +2546,15 @@ namespace bgfx
 		UniformBuffer** m_uniformBuffer;
 
 		uint32_t m_numRenderItems;
+		uint32_t m_numRenderItemSlots;
+		uint32_t m_numRenderItemChunks;
+		uint32_t m_numRenderItemBindings;
 		uint16_t m_numBlitItems;
 
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
+		uint32_t m_transientFrameId;
+		static uint32_t s_transientFrameId;
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2448,6 +2645,124 @@ namespace bgfx
 		bool m_capture;
 	};
 
+	/// Draw calls retained across frames. Sort keys, render items, uniform
+	/// commands, matrices, and scissor rects are stored in bundle local
+	/// storage, and copied into frame when bundle is submitted. Resources are
+	/// referenced by handle, and checked against their generation on submit.
+	struct DrawBundle
+	{
+		struct Item
+		{
+			SortKey m_key;  //!< Sort key, `m_depth` is depth as submitted.
+			uint8_t m_mode; //!< View mode at the time of recording.
+		};
+
+		struct Ref
+		{
+			uint16_t m_idx;
+			uint16_t m_gen;  //!< Resource generation at the time of recording.
+			uint8_t  m_type; //!< Handle::Enum
+		};
+
+		DrawBundle()
+			: m_sortKeys(NULL)
+			, m_item(NULL)
+			, m_draw(NULL)
+			, m_bindRef(NULL)
+			, m_binding(NULL)
+			, m_uniforms(NULL)
+			, m_matrix(NULL)
+			, m_rect(NULL)
+			, m_ref(NULL)
+			, m_num(0)
+			, m_max(0)
+			, m_uniformSize(0)
+			, m_uniformMax(0)
+			, m_numMatrices(0)
+			, m_maxMatrices(0)
+			, m_numRects(0)
+			, m_maxRects(0)
+			, m_numBindings(0)
+			, m_maxBindings(0)
+			, m_numRefs(0)
+			, m_maxRefs(0)
+		{
+			bx::memSet(&m_lastBind, 0, sizeof(m_lastBind) );
+			reset();
+		}
+
+		~DrawBundle()
+		{
+			destroy();
+		}
+
+		void reset()
+		{
+			m_num         = 0;
+			m_uniformSize = 0;
+			m_numMatrices = 0;
+			m_numRects    = 0;
+			m_numBindings = 0;
+			m_numRefs     = 0;
+
+			m_lastBindRef.m_first = UINT32_MAX;
+
+			m_lastUniformBegin  = UINT32_MAX;
+			m_lastUniformEnd    = 0;
+			m_lastUniformOffset = 0;
+			m_lastScissor       = UINT16_MAX;
+		}
+
+		void destroy();
+
+		void add(
+			  uint64_t _sortKey
+			, const SortKey& _key
+			, ViewMode::Enum _mode
+			, const RenderDraw& _draw
+			, const RenderBind& _bind
+			, const UniformBuffer* _uniformBuffer
+			, const FrameCache& _frameCache
+			);
+
+		void addRef(Handle::Enum _type, uint16_t _idx);
+
+		/// Returns false if any referenced resource was destroyed or reallocated
+		/// since recording.
+		bool checkRefs() const;
+
+		uint64_t*      m_sortKeys;
+		Item*          m_item;
+		RenderDraw*    m_draw;
+		RenderBindRef* m_bindRef;
+		Binding*       m_binding;
+		char*          m_uniforms;
+		Matrix4*       m_matrix;
+		Rect*          m_rect;
+		Ref*           m_ref;
+
+		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_uniformSize;
+		uint32_t m_uniformMax;
+		uint32_t m_numMatrices;
+		uint32_t m_maxMatrices;
+		uint32_t m_numRects;
+		uint32_t m_maxRects;
+		uint32_t m_numBindings;
+		uint32_t m_maxBindings;
+		uint32_t m_numRefs;
+		uint32_t m_maxRefs;
+
+		RenderBind    m_lastBind;
+		RenderBindRef m_lastBindRef;
+
+		uint32_t m_lastUniformBegin;
+		uint32_t m_lastUniformEnd;
+		uint32_t m_lastUniformOffset;
+		uint16_t m_lastScissor;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
 		EncoderImpl()
@@ -2458,8 +2773,22 @@ namespace bgfx
 			// as it reads those bytes too. To make this deterministic, we will
 			// clear all bytes (inclusively the padding) before we start.
 			bx::memSet(&m_bind, 0, sizeof(m_bind));
+			bx::memSet(&m_lastBind, 0, sizeof(m_lastBind) );
 
 			discard(BGFX_DISCARD_ALL);
+
+			m_sortKeys     = NULL;
+			m_sortValues   = NULL;
+			m_sortCapacity = 0;
+			m_drawBundle   = NULL;
+		}
+
+		~EncoderImpl()
+		{
+			if (NULL != m_sortKeys)
+			{
+				bx::free(g_allocator, m_sortKeys);
+			}
 		}
 
 		void begin(Frame* _frame, uint8_t _idx)
@@ -2477,10 +2806,34 @@ namespace bgfx
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			m_renderItemFirst = 0;
+			m_renderItemNext  = 0;
+			m_renderItemEnd   = 0;
+			m_numChunks       = 0;
+
+			m_lastBindRef.m_first = UINT32_MAX;
 		}
 
 		void end(bool _finalize)
 		{
+			BX_ASSERT(NULL == m_drawBundle, "Draw bundle recording must be ended before encoder ends.");
+
+			retireRenderItems();
+
+			// Unused rest of the chunk is given back, so that many short encoder sessions
+			// in a frame don't run out of render item slots.
+			if (m_renderItemNext != m_renderItemEnd)
+			{
+				m_frame->releaseRenderItems(m_renderItemNext, m_renderItemEnd);
+				m_renderItemEnd = m_renderItemNext;
+			}
+
+			if (BX_ENABLED(BGFX_CONFIG_ENCODER_SORT) )
+			{
+				sortRenderItems();
+			}
+
 			if (_finalize)
 			{
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
@@ -2500,6 +2853,90 @@ namespace bgfx
 			}
 		}
 
+		void retireRenderItems()
+		{
+			if (m_renderItemFirst != m_renderItemNext)
+			{
+				const uint32_t num = m_renderItemNext-m_renderItemFirst;
+				m_frame->addRenderItemChunk(m_renderItemFirst, num, m_uniformIdx);
+
+				if (BX_ENABLED(BGFX_CONFIG_ENCODER_SORT) )
+				{
+					Frame::RenderItemChunk& chunk = m_chunk[m_numChunks++];
+					chunk.m_first   = m_renderItemFirst;
+					chunk.m_num     = num;
+					chunk.m_encoder = m_uniformIdx;
+				}
+			}
+
+			m_renderItemFirst = m_renderItemNext;
+		}
+
+		void sortRenderItems();
+
+		uint32_t allocRenderItem(uint32_t _max)
+		{
+			if (m_renderItemNext == m_renderItemEnd)
+			{
+				retireRenderItems();
+
+				uint32_t num = BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+				m_renderItemFirst = m_frame->reserveRenderItems(&num);
+				m_renderItemNext  = m_renderItemFirst;
+				m_renderItemEnd   = m_renderItemFirst + num;
+			}
+
+			if (m_renderItemNext == m_renderItemEnd
+			||  _max <= m_renderItemNext)
+			{
+				return UINT32_MAX;
+			}
+
+			return m_renderItemNext++;
+		}
+
+		uint32_t allocRenderItems(uint32_t _max, uint32_t* _num)
+		{
+			const uint32_t first = allocRenderItem(_max);
+			if (UINT32_MAX == first)
+			{
+				*_num = 0;
+				return first;
+			}
+
+			const uint32_t num = bx::min(*_num, bx::min(m_renderItemEnd, _max) - first);
+			m_renderItemNext = first + num;
+			*_num = num;
+
+			return first;
+		}
+
+		/// Store used binding stages into frame, bindings identical to
+		/// previous render item's bindings are shared.
+		bool encodeRenderBind(const RenderBind& _bind, RenderBindRef& _ref)
+		{
+			if (UINT32_MAX == m_lastBindRef.m_first
+			||  0 != bx::memCmp(&m_lastBind, &_bind, sizeof(RenderBind) ) )
+			{
+				uint32_t num;
+				const uint32_t mask  = _bind.getMask(&num);
+				const uint32_t first = m_frame->reserveRenderItemBindings(num);
+				if (UINT32_MAX == first)
+				{
+					return false;
+				}
+
+				_bind.pack(&m_frame->m_renderItemBinding[first], mask);
+
+				bx::memCopy(&m_lastBind, &_bind, sizeof(RenderBind) );
+				m_lastBindRef.m_first = first;
+				m_lastBindRef.m_mask  = mask;
+			}
+
+			_ref = m_lastBindRef;
+			return true;
+		}
+
 		void setMarker(const bx::StringView& _name)
 		{
 			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
@@ -2559,6 +2996,7 @@ namespace bgfx
 
 		void setCondition(OcclusionQueryHandle _handle, bool _visible)
 		{
+			BX_ASSERT(NULL == m_drawBundle, "Occlusion query can't be recorded into draw bundle.");
 			m_draw.m_occlusionQuery = _handle;
 			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
 		}
@@ -2628,6 +3066,7 @@ namespace bgfx
 
 		void setIndexBuffer(const TransientIndexBuffer* _tib, uint32_t _firstIndex, uint32_t _numIndices)
 		{
+			BX_ASSERT(NULL == m_drawBundle, "Transient index buffer can't be recorded into draw bundle.");
 			BX_ASSERT(UINT8_MAX != m_draw.m_streamMask, "bgfx::setVertexCount was already called for this draw call.");
 			const uint32_t indexSize  = _tib->isIndex16 ? 2 : 4;
 			const uint32_t numIndices = bx::min(_numIndices, _tib->size/indexSize);
@@ -2688,6 +3127,7 @@ namespace bgfx
 			, VertexLayoutHandle _layoutHandle
 			)
 		{
+			BX_ASSERT(NULL == m_drawBundle, "Transient vertex buffer can't be recorded into draw bundle.");
 			BX_ASSERT(UINT8_MAX != m_draw.m_streamMask, "bgfx::setVertexCount was already called for this draw call.");
 			BX_ASSERT(_stream < BGFX_CONFIG_MAX_VERTEX_STREAMS, "Invalid stream %d (max %d).", _stream, BGFX_CONFIG_MAX_VERTEX_STREAMS);
 			if (m_draw.setStreamBit(_stream, _tvb->handle) )
@@ -2713,6 +3153,7 @@ namespace bgfx
 
 		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _start, uint32_t _num)
 		{
+			BX_ASSERT(NULL == m_drawBundle, "Instance data buffer can't be recorded into draw bundle.");
 			const uint32_t start = bx::min(_start, _idb->num);
 			const uint32_t num   = bx::min(_idb->num - start, _num);
 			m_draw.m_instanceDataOffset = _idb->offset + start*_idb->stride;
@@ -2816,6 +3257,31 @@ namespace bgfx
 			submit(_id, _program, _indirectHandle, _start, _numMax, _depth, _flags);
 		}
 
+		void beginDrawBundle(DrawBundle* _bundle)
+		{
+			BX_ASSERT(NULL == m_drawBundle, "Draw bundle recording already started.");
+			_bundle->reset();
+			m_drawBundle = _bundle;
+		}
+
+		void endDrawBundle()
+		{
+			BX_ASSERT(NULL != m_drawBundle, "Draw bundle recording was not started.");
+			m_drawBundle = NULL;
+		}
+
+		/// Records resource that is resolved before it reaches encoder (dynamic buffers,
+		/// uniforms), so that draw bundle can check it on submit.
+		void addDrawBundleRef(Handle::Enum _type, uint16_t _idx)
+		{
+			if (NULL != m_drawBundle)
+			{
+				m_drawBundle->addRef(_type, _idx);
+			}
+		}
+
+		void submit(const DrawBundle& _bundle);
+
 		void dispatch(ViewId _id, ProgramHandle _handle, uint32_t _ngx, uint32_t _ngy, uint32_t _ngz, uint8_t _flags);
 
 		void dispatch(ViewId _id, ProgramHandle _handle, IndirectBufferHandle _indirectHandle, uint32_t _start, uint32_t _num, uint8_t _flags)
@@ -2835,10 +3301,25 @@ namespace bgfx
 		RenderDraw    m_draw;
 		RenderCompute m_compute;
 		RenderBind    m_bind;
+		RenderBind    m_lastBind;
+		RenderBindRef m_lastBindRef;
 
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		uint32_t m_renderItemFirst;
+		uint32_t m_renderItemNext;
+		uint32_t m_renderItemEnd;
+
+		Frame::RenderItemChunk m_chunk[BGFX_CONFIG_ENCODER_SORT ? Frame::kMaxRenderItemChunks : 1];
+		uint32_t m_numChunks;
+
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint32_t         m_sortCapacity;
+
+		DrawBundle* m_drawBundle;
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
@@ -2950,7 +3431,9 @@ namespace bgfx
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
+	/// Two-level segregated fit (TLSF) non-local allocator. Block bookkeeping is kept
+	/// outside of managed memory. Alloc and free are O(1), and free blocks are merged
+	/// with their physical neighbours immediately.
 	class NonLocalAllocator
 	{
 	public:
@@ -2958,6 +3441,7 @@ namespace bgfx
 
 		NonLocalAllocator()
 		{
+			reset();
 		}
 
 		~NonLocalAllocator()
@@ -2966,113 +3450,373 @@ namespace bgfx
 
 		void reset()
 		{
-			m_free.clear();
+			m_block.clear();
+			m_page.clear();
 			m_used.clear();
+
+			m_flBitmap = 0;
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+
+			for (uint32_t ii = 0; ii < kNumFl; ++ii)
+			{
+				for (uint32_t jj = 0; jj < kNumSl; ++jj)
+				{
+					m_freeHead[ii][jj] = kInvalidIndex;
+				}
+			}
+
+			m_unusedNode = kInvalidIndex;
+			m_totalSize  = 0;
+			m_freeSize   = 0;
 		}
 
+		/// Add page of memory `_size` bytes large, starting at `_ptr`.
 		void add(uint64_t _ptr, uint32_t _size)
 		{
-			m_free.push_back(Free(_ptr, _size) );
+			const uint32_t size = _size & ~(kMinSize-1);
+
+			const uint32_t idx = allocNode();
+			Block& block = m_block[idx];
+			block.m_ptr      = _ptr;
+			block.m_size     = size;
+			block.m_prevPhys = kInvalidIndex;
+			block.m_nextPhys = kInvalidIndex;
+			block.m_free     = true;
+
+			m_page.push_back(idx);
+			m_totalSize += size;
+			m_freeSize  += size;
+
+			insertFree(idx);
 		}
 
+		/// Remove page, returns page start, or `kInvalidBlock` when there are no pages left.
 		uint64_t remove()
 		{
 			BX_ASSERT(0 == m_used.size(), "");
 
-			if (0 < m_free.size() )
+			if (0 < m_page.size() )
 			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
+				const uint32_t idx = m_page.back();
+				m_page.pop_back();
+
+				const Block& block = m_block[idx];
+				BX_ASSERT(block.m_free && kInvalidIndex == block.m_nextPhys, "Page is still in use.");
+
+				const uint64_t ptr = block.m_ptr;
+				m_totalSize -= block.m_size;
+				m_freeSize  -= block.m_size;
+
+				removeFree(idx);
+				releaseNode(idx);
+
+				return ptr;
 			}
 
-			return 0;
+			return kInvalidBlock;
 		}
 
 		uint64_t alloc(uint32_t _size)
 		{
-			_size = bx::max(_size, 16u);
+			if (_size > UINT32_MAX - kMinSize)
+			{
+				return kInvalidBlock;
+			}
+
+			const uint32_t size = bx::alignUp(bx::max(_size, kMinSize), kMinSize);
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			const uint32_t idx = findFree(size);
+			if (kInvalidIndex == idx)
 			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
 
-					m_used.insert(stl::make_pair(ptr, _size) );
+			removeFree(idx);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
+			if (m_block[idx].m_size > size)
+			{
+				const uint32_t split = allocNode();
+
+				Block& block = m_block[idx];
+				Block& rest  = m_block[split];
+				rest.m_ptr      = block.m_ptr  + size;
+				rest.m_size     = block.m_size - size;
+				rest.m_prevPhys = idx;
+				rest.m_nextPhys = block.m_nextPhys;
+				rest.m_free     = true;
 
-					return ptr;
+				if (kInvalidIndex != block.m_nextPhys)
+				{
+					m_block[block.m_nextPhys].m_prevPhys = split;
 				}
+
+				block.m_size     = size;
+				block.m_nextPhys = split;
+
+				insertFree(split);
 			}
 
-			// there is no block large enough.
-			return kInvalidBlock;
+			Block& block = m_block[idx];
+			block.m_free = false;
+			m_freeSize -= block.m_size;
+			m_used.insert(stl::make_pair(block.m_ptr, idx) );
+
+			return block.m_ptr;
 		}
 
 		void free(uint64_t _block)
 		{
 			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
+			if (it == m_used.end() )
+			{
+				return;
+			}
+
+			uint32_t idx = it->second;
+			m_used.erase(it);
+
+			m_block[idx].m_free = true;
+			m_freeSize += m_block[idx].m_size;
+
+			const uint32_t next = m_block[idx].m_nextPhys;
+			if (kInvalidIndex != next
+			&&  m_block[next].m_free)
+			{
+				removeFree(next);
+				merge(idx, next);
+			}
+
+			const uint32_t prev = m_block[idx].m_prevPhys;
+			if (kInvalidIndex != prev
+			&&  m_block[prev].m_free)
+			{
+				removeFree(prev);
+				merge(prev, idx);
+				idx = prev;
+			}
+
+			insertFree(idx);
+		}
+
+		/// Returns true when there are no used blocks.
+		bool isEmpty() const
+		{
+			return 0 == m_used.size();
+		}
+
+		/// Returns size of all pages.
+		uint64_t getTotalSize() const
+		{
+			return m_totalSize;
+		}
+
+		/// Returns size of all free blocks.
+		uint64_t getFreeSize() const
+		{
+			return m_freeSize;
+		}
+
+		/// Returns size of largest free block.
+		uint32_t getLargestFree() const
+		{
+			if (0 == m_flBitmap)
+			{
+				return 0;
+			}
+
+			const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+			const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+			uint32_t largest = 0;
+			for (uint32_t idx = m_freeHead[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+			{
+				largest = bx::max(largest, m_block[idx].m_size);
+			}
+
+			return largest;
+		}
+
+	private:
+		static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+		static constexpr uint32_t kMinSizeLog2  = 4;
+		static constexpr uint32_t kMinSize      = 1<<kMinSizeLog2;
+		static constexpr uint32_t kSlLog2       = 4;
+		static constexpr uint32_t kNumSl        = 1<<kSlLog2;
+		static constexpr uint32_t kNumFl        = 32 - kMinSizeLog2 - kSlLog2 + 1;
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			bool     m_free;
+		};
+
+		// Map size in `kMinSize` units to first and second level index.
+		static void mapping(uint32_t _num, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_num < kNumSl)
+			{
+				_fl = 0;
+				_sl = _num;
+			}
+			else
 			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
+				const uint32_t log2 = 31 - bx::uint32_cntlz(_num);
+				_fl = log2 - kSlLog2 + 1;
+				_sl = (_num >> (log2 - kSlLog2) ) - kNumSl;
 			}
 		}
 
-		bool compact()
+		uint32_t findFree(uint32_t _size) const
 		{
-			m_free.sort();
+			// Round size up to next size class, so that any block in found list fits.
+			uint32_t num = _size >> kMinSizeLog2;
+
+			if (num >= kNumSl)
+			{
+				const uint32_t log2 = 31 - bx::uint32_cntlz(num);
+				num += (1 << (log2 - kSlLog2) ) - 1;
+			}
+
+			uint32_t fl;
+			uint32_t sl;
+			mapping(num, fl, sl);
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+			if (fl >= kNumFl)
 			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
+				return kInvalidIndex;
+			}
+
+			uint32_t slBitmap = m_slBitmap[fl] & (UINT32_MAX << sl);
+
+			if (0 == slBitmap)
+			{
+				const uint32_t flBitmap = fl+1 < kNumFl ? m_flBitmap & (UINT32_MAX << (fl+1) ) : 0;
+
+				if (0 == flBitmap)
 				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
+					return kInvalidIndex;
 				}
-				else
+
+				fl = bx::uint32_cnttz(flBitmap);
+				slBitmap = m_slBitmap[fl];
+			}
+
+			sl = bx::uint32_cnttz(slBitmap);
+
+			return m_freeHead[fl][sl];
+		}
+
+		void insertFree(uint32_t _idx)
+		{
+			uint32_t fl;
+			uint32_t sl;
+			mapping(m_block[_idx].m_size >> kMinSizeLog2, fl, sl);
+
+			Block& block = m_block[_idx];
+			block.m_prevFree = kInvalidIndex;
+			block.m_nextFree = m_freeHead[fl][sl];
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = _idx;
+			}
+
+			m_freeHead[fl][sl] = _idx;
+			m_flBitmap     |= 1 << fl;
+			m_slBitmap[fl] |= 1 << sl;
+		}
+
+		void removeFree(uint32_t _idx)
+		{
+			uint32_t fl;
+			uint32_t sl;
+			mapping(m_block[_idx].m_size >> kMinSizeLog2, fl, sl);
+
+			const Block& block = m_block[_idx];
+
+			if (kInvalidIndex != block.m_prevFree)
+			{
+				m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_freeHead[fl][sl] = block.m_nextFree;
+			}
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
+			}
+
+			if (kInvalidIndex == m_freeHead[fl][sl])
+			{
+				m_slBitmap[fl] &= ~(1 << sl);
+
+				if (0 == m_slBitmap[fl])
 				{
-					it = next;
-					++next;
+					m_flBitmap &= ~(1 << fl);
 				}
 			}
-
-			return 0 == m_used.size();
 		}
 
-	private:
-		struct Free
+		// Merge `_next` into physically preceding `_idx`.
+		void merge(uint32_t _idx, uint32_t _next)
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
+			Block& block = m_block[_idx];
+			const Block& next = m_block[_next];
+
+			block.m_size    += next.m_size;
+			block.m_nextPhys = next.m_nextPhys;
+
+			if (kInvalidIndex != next.m_nextPhys)
 			{
+				m_block[next.m_nextPhys].m_prevPhys = _idx;
 			}
 
-			bool operator<(const Free& rhs) const
+			releaseNode(_next);
+		}
+
+		uint32_t allocNode()
+		{
+			if (kInvalidIndex != m_unusedNode)
 			{
-				return m_ptr < rhs.m_ptr;
+				const uint32_t idx = m_unusedNode;
+				m_unusedNode = m_block[idx].m_nextFree;
+				return idx;
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			m_block.push_back(Block() );
+			return uint32_t(m_block.size()-1);
+		}
 
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
+		void releaseNode(uint32_t _idx)
+		{
+			m_block[_idx].m_nextFree = m_unusedNode;
+			m_unusedNode = _idx;
+		}
+
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+
+		typedef stl::vector<uint32_t> PageArray;
+		PageArray m_page;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		uint32_t m_freeHead[kNumFl][kNumSl];
+		uint32_t m_slBitmap[kNumFl];
+		uint32_t m_flBitmap;
+
+		uint32_t m_unusedNode;
+		uint64_t m_totalSize;
+		uint64_t m_freeSize;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -3156,7 +3900,18 @@ namespace bgfx
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_uploadFrameNum(0)
+			, m_transientAllocs(0)
+			, m_transientSwap(0)
 		{
+			bx::memSet(m_textureUploadPending,   0, sizeof(m_textureUploadPending)   );
+			bx::memSet(m_indexBufferGen,         0, sizeof(m_indexBufferGen)         );
+			bx::memSet(m_vertexBufferGen,        0, sizeof(m_vertexBufferGen)        );
+			bx::memSet(m_programGen,             0, sizeof(m_programGen)             );
+			bx::memSet(m_textureGen,             0, sizeof(m_textureGen)             );
+			bx::memSet(m_dynamicIndexBufferGen,  0, sizeof(m_dynamicIndexBufferGen)  );
+			bx::memSet(m_dynamicVertexBufferGen, 0, sizeof(m_dynamicVertexBufferGen) );
+			bx::memSet(m_uniformGen,             0, sizeof(m_uniformGen)             );
 		}
 
 		~Context()
@@ -3330,6 +4085,13 @@ namespace bgfx
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
+			stats.dynamicIbTotal       = int64_t(m_dynIndexBufferAllocator.getTotalSize() );
+			stats.dynamicIbFree        = int64_t(m_dynIndexBufferAllocator.getFreeSize() );
+			stats.dynamicIbLargestFree = m_dynIndexBufferAllocator.getLargestFree();
+			stats.dynamicVbTotal       = int64_t(m_dynVertexBufferAllocator.getTotalSize() );
+			stats.dynamicVbFree        = int64_t(m_dynVertexBufferAllocator.getFreeSize() );
+			stats.dynamicVbLargestFree = m_dynVertexBufferAllocator.getLargestFree();
+
 			return &stats;
 		}
 
@@ -3380,6 +4142,7 @@ namespace bgfx
 			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_ASSERT(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
+			++m_indexBufferGen[_handle.idx];
 
 			IndexBuffer& ref = m_indexBuffers[_handle.idx];
 			ref.m_name.clear();
@@ -3498,6 +4261,7 @@ namespace bgfx
 			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_ASSERT(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
+			++m_vertexBufferGen[_handle.idx];
 
 			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
 			ref.m_name.clear();
@@ -3638,6 +4402,7 @@ namespace bgfx
 			if (dib.m_size < _mem->size
 			&&  0 != (dib.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
+				++m_dynamicIndexBufferGen[_handle.idx];
 				destroy(dib);
 
 				const uint64_t ptr = (0 != (dib.m_flags & BGFX_BUFFER_COMPUTE_READ) )
@@ -3685,9 +4450,9 @@ namespace bgfx
 			else
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(_dib.m_handle.idx) << 32 | _dib.m_offset);
-				if (m_dynIndexBufferAllocator.compact() )
+				if (m_dynIndexBufferAllocator.isEmpty() )
 				{
-					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); 0 != ptr; ptr = m_dynIndexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynIndexBufferAllocator.remove() )
 					{
 						IndexBufferHandle handle = { uint16_t(ptr >> 32) };
 						destroyIndexBuffer(handle);
@@ -3701,6 +4466,7 @@ namespace bgfx
 			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
 			destroy(dib);
 			dib.reset();
+			++m_dynamicIndexBufferGen[_handle.idx];
 			m_dynamicIndexBufferHandle.free(_handle.idx);
 		}
 
@@ -3835,6 +4601,7 @@ namespace bgfx
 			if (dvb.m_size < _mem->size
 			&&  0 != (dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
+				++m_dynamicVertexBufferGen[_handle.idx];
 				destroy(dvb);
 
 				const uint32_t size = bx::strideAlign<16>(_mem->size, dvb.m_stride)+dvb.m_stride;
@@ -3886,9 +4653,9 @@ namespace bgfx
 			else
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(_dvb.m_handle.idx) << 32 | _dvb.m_offset);
-				if (m_dynVertexBufferAllocator.compact() )
+				if (m_dynVertexBufferAllocator.isEmpty() )
 				{
-					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); 0 != ptr; ptr = m_dynVertexBufferAllocator.remove() )
+					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); NonLocalAllocator::kInvalidBlock != ptr; ptr = m_dynVertexBufferAllocator.remove() )
 					{
 						VertexBufferHandle handle = { uint16_t(ptr >> 32) };
 						destroyVertexBuffer(handle);
@@ -3912,12 +4679,13 @@ namespace bgfx
 			DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
 			destroy(dvb);
 			dvb.reset();
+			++m_dynamicVertexBufferGen[_handle.idx];
 			m_dynamicVertexBufferHandle.free(_handle.idx);
 		}
 
 		BGFX_API_FUNC(uint32_t getAvailTransientIndexBuffer(uint32_t _num, bool _index32) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TransientAllocScope transientAllocScope(this);
 
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
@@ -3926,7 +4694,7 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TransientAllocScope transientAllocScope(this);
 
 			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
 		}
@@ -3971,18 +4739,26 @@ namespace bgfx
 
 		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num, bool _index32) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TransientAllocScope transientAllocScope(this);
+
+			const bool isIndex16     = !_index32;
+			const uint16_t indexSize = isIndex16 ? 2 : 4;
+			const uint32_t offset    = m_submit->allocTransientIndexBuffer(_num, indexSize, getTransientChunk(TransientChunk::Index) );
+
+			setTransientIndexBuffer(_tib, offset, _num, _index32);
+		}
 
+		void setTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _offset, uint32_t _num, bool _index32)
+		{
 			const bool isIndex16     = !_index32;
 			const uint16_t indexSize = isIndex16 ? 2 : 4;
-			const uint32_t offset    = m_submit->allocTransientIndexBuffer(_num, indexSize);
 
 			TransientIndexBuffer& tib = *m_submit->m_transientIb;
 
-			_tib->data       = &tib.data[offset];
+			_tib->data       = &tib.data[_offset];
 			_tib->size       = _num * indexSize;
 			_tib->handle     = tib.handle;
-			_tib->startIndex = bx::strideAlign(offset, indexSize) / indexSize;
+			_tib->startIndex = bx::strideAlign(_offset, indexSize) / indexSize;
 			_tib->isIndex16  = isIndex16;
 		}
 
@@ -4041,14 +4817,20 @@ namespace bgfx
 
 		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TransientAllocScope transientAllocScope(this);
+
+			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _stride, getTransientChunk(TransientChunk::Vertex) );
+
+			setTransientVertexBuffer(_tvb, offset, _num, _layoutHandle, _stride);
+		}
 
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _stride);
+		void setTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _offset, uint32_t _num, VertexLayoutHandle _layoutHandle, uint16_t _stride)
+		{
 			const TransientVertexBuffer& dvb = *m_submit->m_transientVb;
 
-			_tvb->data         = &dvb.data[offset];
+			_tvb->data         = &dvb.data[_offset];
 			_tvb->size         = _num * _stride;
-			_tvb->startVertex  = bx::strideAlign(offset, _stride)/_stride;
+			_tvb->startVertex  = bx::strideAlign(_offset, _stride)/_stride;
 			_tvb->stride       = _stride;
 			_tvb->handle       = dvb.handle;
 			_tvb->layoutHandle = _layoutHandle;
@@ -4056,10 +4838,10 @@ namespace bgfx
 
 		BGFX_API_FUNC(void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride) )
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TransientAllocScope transientAllocScope(this);
 
 			const uint16_t stride = bx::alignUp(_stride, 16);
-			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride);
+			const uint32_t offset = m_submit->allocTransientVertexBuffer(_num, stride, getTransientChunk(TransientChunk::Vertex) );
 
 			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
 			_idb->data   = &dvb.data[offset];
@@ -4070,6 +4852,36 @@ namespace bgfx
 			_idb->handle = dvb.handle;
 		}
 
+		BGFX_API_FUNC(bool allocTransientBuffers(TransientVertexBuffer* _tvb, VertexLayoutHandle _layoutHandle, uint16_t _stride, uint32_t _numVertices, TransientIndexBuffer* _tib, uint32_t _numIndices, bool _index32) )
+		{
+			TransientAllocScope transientAllocScope(this);
+
+			const uint16_t indexSize = _index32 ? 4 : 2;
+
+			// Both allocations must succeed in full. When index buffer allocation fails, vertex
+			// buffer space stays reserved until the end of frame.
+			uint32_t numVertices = _numVertices;
+			const uint32_t vbOffset = m_submit->allocTransientVertexBuffer(numVertices, _stride, getTransientChunk(TransientChunk::Vertex), true);
+
+			if (0 == numVertices)
+			{
+				return false;
+			}
+
+			uint32_t numIndices = _numIndices;
+			const uint32_t ibOffset = m_submit->allocTransientIndexBuffer(numIndices, indexSize, getTransientChunk(TransientChunk::Index), true);
+
+			if (0 == numIndices)
+			{
+				return false;
+			}
+
+			setTransientVertexBuffer(_tvb, vbOffset, numVertices, _layoutHandle, _stride);
+			setTransientIndexBuffer(_tib, ibOffset, numIndices, _index32);
+
+			return true;
+		}
+
 		IndirectBufferHandle createIndirectBuffer(uint32_t _num)
 		{
 			BX_UNUSED(_num);
@@ -4098,6 +4910,7 @@ namespace bgfx
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(handle);
 			m_submit->free(handle);
+			++m_vertexBufferGen[handle.idx];
 		}
 
 		BGFX_API_FUNC(ShaderHandle createShader(const Memory* _mem) )
@@ -4500,6 +5313,7 @@ namespace bgfx
 			{
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_ASSERT(ok, "Program handle %d is already destroyed!", _handle.idx);
+				++m_programGen[_handle.idx];
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyProgram);
 				cmdbuf.write(_handle);
@@ -4571,6 +5385,7 @@ namespace bgfx
 				, imageContainer.m_cubeMap
 				, _flags
 				);
+			ref.m_uploadFrame = m_submit->m_frameNum;
 
 			if (ref.isRt() )
 			{
@@ -4618,6 +5433,19 @@ namespace bgfx
 			return ref.m_ptr;
 		}
 
+		BGFX_API_FUNC(bool isTextureResident(TextureHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BGFX_CHECK_HANDLE("isTextureResident", m_textureHandle, _handle);
+
+			const TextureRef& ref = m_textureRef[_handle.idx];
+			const uint32_t uploadFrameNum = bx::atomicFetchAndAdd<uint32_t>(&m_uploadFrameNum, 0);
+
+			return ref.m_uploadFrame < uploadFrameNum
+				&& 0 == bx::atomicFetchAndAdd<uint32_t>(&m_textureUploadPending[_handle.idx], 0)
+				;
+		}
+
 		BGFX_API_FUNC(void destroyTexture(TextureHandle _handle) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4653,8 +5481,9 @@ namespace bgfx
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
 		{
-			const TextureRef& ref = m_textureRef[_handle.idx];
+			TextureRef& ref = m_textureRef[_handle.idx];
 			BX_ASSERT(BackbufferRatio::Count != ref.m_bbRatio, "");
+			ref.m_uploadFrame = m_submit->m_frameNum;
 
 			getTextureSizeFromRatio(BackbufferRatio::Enum(ref.m_bbRatio), _width, _height);
 			_numMips = calcNumMips(1 < _numMips, _width, _height);
@@ -4709,6 +5538,7 @@ namespace bgfx
 
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_ASSERT(ok, "Texture handle %d is already destroyed!", _handle.idx);
+				++m_textureGen[_handle.idx];
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
 				cmdbuf.write(_handle);
@@ -4731,7 +5561,7 @@ namespace bgfx
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			const TextureRef& ref = m_textureRef[_handle.idx];
+			TextureRef& ref = m_textureRef[_handle.idx];
 			if (ref.m_immutable)
 			{
 				BX_WARN(false, "Can't update immutable texture.");
@@ -4739,6 +5569,8 @@ namespace bgfx
 				return;
 			}
 
+			ref.m_uploadFrame = m_submit->m_frameNum;
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
@@ -5004,6 +5836,7 @@ namespace bgfx
 
 				uniform.m_name.clear();
 				m_uniformHashMap.removeByHandle(_handle.idx);
+				++m_uniformGen[_handle.idx];
 
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniform);
 				cmdbuf.write(_handle);
@@ -5056,6 +5889,47 @@ namespace bgfx
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		uint16_t getResourceGen(Handle::Enum _type, uint16_t _idx) const
+		{
+			switch (_type)
+			{
+			case Handle::DynamicIndexBuffer:  return m_dynamicIndexBufferGen[_idx];
+			case Handle::DynamicVertexBuffer: return m_dynamicVertexBufferGen[_idx];
+			case Handle::IndexBuffer:         return m_indexBufferGen[_idx];
+			case Handle::Program:             return m_programGen[_idx];
+			case Handle::Texture:             return m_textureGen[_idx];
+			case Handle::Uniform:             return m_uniformGen[_idx];
+			default:                          break;
+			}
+
+			return m_vertexBufferGen[_idx];
+		}
+
+		BGFX_API_FUNC(DrawBundleHandle createDrawBundle() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DrawBundleHandle handle = { m_drawBundleHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate draw bundle handle.");
+
+			if (isValid(handle) )
+			{
+				m_drawBundle[handle.idx].reset();
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyDrawBundle(DrawBundleHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyDrawBundle", m_drawBundleHandle, _handle);
+
+			m_drawBundle[_handle.idx].destroy();
+			m_drawBundleHandle.free(_handle.idx);
+		}
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -5203,6 +6077,10 @@ namespace bgfx
 		void flip();
 		RenderFrame::Enum renderFrame(int32_t _msecs = -1);
 		void flushTextureUpdateBatch(CommandBuffer& _cmdbuf);
+		void queueTextureUpdate(CommandBuffer& _cmdbuf);
+		void discardPendingTextureUpdates(TextureHandle _handle);
+		void clearTextureUploadPending(uint16_t _idx);
+		void flushPendingUploads();
 		void rendererExecCommands(CommandBuffer& _cmdbuf);
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -5255,6 +6133,51 @@ namespace bgfx
 			}
 		}
 
+		// Transient buffer allocations don't take m_resourceApiLock. Each one is counted in
+		// m_transientAllocs while it uses m_submit, and swap() waits for all of them to finish
+		// before submit frame is finished, swapped and reset. Allocations started during swap
+		// block on m_resourceApiLock, which frame() holds until swap is done.
+		void transientAllocBegin()
+		{
+			for (;;)
+			{
+				bx::atomicFetchAndAdd<int32_t>(&m_transientAllocs, 1);
+
+				if (0 == bx::atomicFetchAndAdd<int32_t>(&m_transientSwap, 0) )
+				{
+					return;
+				}
+
+				bx::atomicFetchAndAdd<int32_t>(&m_transientAllocs, -1);
+
+				bx::MutexScope resourceApiScope(m_resourceApiLock);
+			}
+		}
+
+		void transientAllocEnd()
+		{
+			bx::atomicFetchAndAdd<int32_t>(&m_transientAllocs, -1);
+		}
+
+		void transientSwapBegin()
+		{
+			const int32_t swap = bx::atomicCompareAndSwap<int32_t>(&m_transientSwap, 0, 1);
+			BX_ASSERT(0 == swap, "Transient buffer swap is already in progress."); BX_UNUSED(swap);
+
+			// Allocations in flight are short, yield instead of burning the core they
+			// might need to finish.
+			while (0 != bx::atomicFetchAndAdd<int32_t>(&m_transientAllocs, 0) )
+			{
+				bx::yield();
+			}
+		}
+
+		void transientSwapEnd()
+		{
+			const int32_t swap = bx::atomicCompareAndSwap<int32_t>(&m_transientSwap, 1, 0);
+			BX_ASSERT(1 == swap, "Transient buffer swap was not started."); BX_UNUSED(swap);
+		}
+
 		void encoderApiWait()
 		{
 			uint16_t numEncoders = m_encoderHandle->getNumHandles();
@@ -5303,6 +6226,22 @@ namespace bgfx
 		{
 		}
 
+		void transientAllocBegin()
+		{
+		}
+
+		void transientAllocEnd()
+		{
+		}
+
+		void transientSwapBegin()
+		{
+		}
+
+		void transientSwapEnd()
+		{
+		}
+
 		void encoderApiWait()
 		{
 			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
@@ -5321,8 +6260,28 @@ namespace bgfx
 		Frame* m_render;
 		Frame* m_submit;
 
+		struct TransientAllocScope
+		{
+			TransientAllocScope(Context* _ctx)
+				: m_ctx(_ctx)
+			{
+				m_ctx->transientAllocBegin();
+			}
+
+			~TransientAllocScope()
+			{
+				m_ctx->transientAllocEnd();
+			}
+
+			Context* m_ctx;
+		};
+
+		int32_t m_transientAllocs;
+		int32_t m_transientSwap;
+
 		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
 		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		WorkerPool m_sortWorkerPool;
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -5352,6 +6311,19 @@ namespace bgfx
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_DRAW_BUNDLES> m_drawBundleHandle;
+
+		DrawBundle m_drawBundle[BGFX_CONFIG_MAX_DRAW_BUNDLES];
+
+		// Incremented when resource is destroyed or reallocated, draw bundles
+		// use it to detect stale handles.
+		uint16_t m_indexBufferGen[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		uint16_t m_vertexBufferGen[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint16_t m_programGen[BGFX_CONFIG_MAX_PROGRAMS];
+		uint16_t m_textureGen[BGFX_CONFIG_MAX_TEXTURES];
+		uint16_t m_dynamicIndexBufferGen[BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS];
+		uint16_t m_dynamicVertexBufferGen[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
+		uint16_t m_uniformGen[BGFX_CONFIG_MAX_UNIFORMS];
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -5399,6 +6371,24 @@ namespace bgfx
 
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+
+		struct PendingTextureUpdate
+		{
+			TextureHandle m_handle;
+			uint8_t       m_side;
+			uint8_t       m_mip;
+			Rect          m_rect;
+			uint16_t      m_z;
+			uint16_t      m_depth;
+			uint16_t      m_pitch;
+			const Memory* m_mem;
+		};
+
+		typedef stl::vector<PendingTextureUpdate> PendingTextureUpdateArray;
+
+		PendingTextureUpdateArray m_pendingTextureUpdate;
+		uint32_t m_uploadFrameNum;
+		uint32_t m_textureUploadPending[BGFX_CONFIG_MAX_TEXTURES];
 	};
 
 #undef BGFX_API_FUNC
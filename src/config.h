@@ -170,6 +170,39 @@
 #	define BGFX_CONFIG_RENDERER_DIRECT3D11_USE_STAGING_BUFFER 0
 #endif // BGFX_CONFIG_RENDERER_DIRECT3D11_USE_STAGING_BUFFER
 
+/// Number of threads compiling Vulkan graphics pipelines in background. Draw
+/// calls using pipeline that is still being compiled are skipped, so this is
+/// opt-in. When 0, pipelines are compiled on render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS
+#	define BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS 0
+#endif // BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS
+
+/// Number of new Vulkan pipelines after which pipeline cache is written with
+/// `bgfx::CallbackI::cacheWrite`. When 0, pipeline cache is written only at
+/// shutdown.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_COUNT
+#	define BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_COUNT 64
+#endif // BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_COUNT
+
+/// Size of Vulkan device memory block buffers and textures are placed in.
+/// Resources larger than half of block size get dedicated allocation.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE
+#	define BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE (64<<20)
+#endif // BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE
+
+/// Number of worker threads recording Vulkan draw calls of a view into
+/// secondary command buffers. Opt-in, when 0, all draw calls are recorded on
+/// render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS 0
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+
+/// Minimum number of draw calls in view for view to be recorded on worker
+/// threads.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS 256
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS
+
 /// Enable use of tinystl.
 #ifndef BGFX_CONFIG_USE_TINYSTL
 #	define BGFX_CONFIG_USE_TINYSTL 1
@@ -213,6 +246,27 @@
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+#ifndef BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+/// Number of render item slots each encoder reserves from the frame at once.
+/// Encoders fill reserved slots locally, without touching shared counters.
+#	define BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE 256
+#endif // BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+
+#ifndef BGFX_CONFIG_ENCODER_SORT
+/// When enabled, each encoder sorts its own render items when it ends, on the
+/// thread that submitted them, and Frame::sort only merges presorted runs.
+#	define BGFX_CONFIG_ENCODER_SORT 0
+#endif // BGFX_CONFIG_ENCODER_SORT
+
+#ifndef BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS
+/// Number of texture and buffer bindings stored per frame. Render items store
+/// only used binding stages, and consecutive draw calls with the same bindings
+/// share them. Default is sized for the worst case, so draw calls are never
+/// dropped because of bindings. Pool is filled from the start and never
+/// cleared, so only the part that is used gets touched.
+#	define BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS ( (BGFX_CONFIG_MAX_DRAW_CALLS+1)*BGFX_CONFIG_MAX_TEXTURE_SAMPLERS)
+#endif // BGFX_CONFIG_MAX_RENDER_ITEM_BINDINGS
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
@@ -312,6 +366,10 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+#ifndef BGFX_CONFIG_MAX_DRAW_BUNDLES
+#	define BGFX_CONFIG_MAX_DRAW_BUNDLES 256
+#endif // BGFX_CONFIG_MAX_DRAW_BUNDLES
+
 #ifndef BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
@@ -324,6 +382,13 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+#ifndef BGFX_CONFIG_TRANSIENT_CHUNK_SIZE
+/// Size of per-thread transient buffer chunk in bytes. Small transient vertex,
+/// index, and instance data allocations are served from calling thread's chunk
+/// without touching shared frame offsets. 0 disables chunks.
+#	define BGFX_CONFIG_TRANSIENT_CHUNK_SIZE 0
+#endif // BGFX_CONFIG_TRANSIENT_CHUNK_SIZE
+
 #ifndef BGFX_CONFIG_PER_FRAME_SCRATCH_STAGING_BUFFER_SIZE
 /// Amount of scratch buffer size (per in-flight frame) that will be reserved
 /// for staging data for copying to the device (such as vertex buffer data,
@@ -374,6 +439,21 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+#ifndef BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+#	define BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS 0
+#endif // BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+
+/// Default maximum amount of texture update data uploaded per
+/// frame. Updates over budget are deferred to following frames. 0 disables
+/// budgeting and all updates are uploaded in the frame they're submitted.
+#ifndef BGFX_CONFIG_DEFAULT_MAX_UPLOAD_SIZE
+#	define BGFX_CONFIG_DEFAULT_MAX_UPLOAD_SIZE 0
+#endif // BGFX_CONFIG_DEFAULT_MAX_UPLOAD_SIZE
+
+#ifndef BGFX_CONFIG_MAX_WORKER_THREADS
+#	define BGFX_CONFIG_MAX_WORKER_THREADS 16
+#endif // BGFX_CONFIG_MAX_WORKER_THREADS
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
@@ -6393,6 +6393,10 @@ namespace bgfx { namespace d3d12
 		RenderBind currentBind;
 		currentBind.clear();
 
+		RenderBind renderBind;
+		renderBind.clear();
+		RenderBindRef renderBindRef = { UINT32_MAX, 0 };
+
 		static ViewState viewState;
 		viewState.reset(_render);
 
@@ -6508,7 +6512,7 @@ namespace bgfx { namespace d3d12
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				_render->updateRenderBind(itemIdx, renderBindRef, renderBind);
 				++item;
 
 				if (viewChanged)
@@ -546,6 +546,7 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
@@ -764,6 +765,7 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
@@ -2245,6 +2247,7 @@ namespace bgfx { namespace gl
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
+			, m_persistentBufferSupport(false)
 			, m_flip(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
@@ -2252,8 +2255,12 @@ namespace bgfx { namespace gl
 			, m_msaaBlitProgram(0)
 			, m_clearQuadColor(BGFX_INVALID_HANDLE)
 			, m_clearQuadDepth(BGFX_INVALID_HANDLE)
+			, m_frameIdx(0)
+			, m_uploadOffset(0)
 		{
 			bx::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			bx::memSet(m_frameFence, 0, sizeof(m_frameFence) );
+			m_uploadBuffer.m_size = 0;
 		}
 
 		~RendererContextGL()
@@ -3003,6 +3010,19 @@ namespace bgfx { namespace gl
 					&& NULL != glGetQueryObjectui64v
 					;
 
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+				m_persistentBufferSupport = true
+					&& s_extension[Extension::ARB_buffer_storage].m_supported
+					&& NULL != glBufferStorage
+					&& NULL != glMapBufferRange
+					&& NULL != glUnmapBuffer
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					&& NULL != glCopyBufferSubData
+					;
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+
 				m_occlusionQuerySupport = false
 					|| s_extension[Extension::ARB_occlusion_query        ].m_supported
 					|| s_extension[Extension::ARB_occlusion_query2       ].m_supported
@@ -3192,6 +3212,12 @@ namespace bgfx { namespace gl
 					m_occlusionQuery.create();
 				}
 
+				if (m_persistentBufferSupport)
+				{
+					// When persistent mapping fails, buffers are updated with glBufferSubData.
+					m_persistentBufferSupport = m_uploadBuffer.create(GL_COPY_READ_BUFFER, BGFX_GL_CONFIG_UPLOAD_BUFFER_SIZE);
+				}
+
 				// Init reserved part of view name.
 				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 				{
@@ -3239,6 +3265,18 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			// Persistent buffers might be disabled at runtime after failed mapping, upload
+			// buffer and frame fences created before that still need to be released.
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameFence); ++ii)
+			{
+				waitFrameFence(ii);
+			}
+
+			if (m_uploadBuffer.isValid() )
+			{
+				m_uploadBuffer.destroy(GL_COPY_READ_BUFFER);
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -4171,6 +4209,68 @@ namespace bgfx { namespace gl
 			m_flip = true;
 		}
 
+		void waitFrameFence(uint32_t _idx)
+		{
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+			GLsync fence = m_frameFence[_idx];
+			if (NULL != fence)
+			{
+				GLenum result;
+				do
+				{
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+				}
+				while (GL_TIMEOUT_EXPIRED == result);
+
+				GL_CHECK(glDeleteSync(fence) );
+				m_frameFence[_idx] = NULL;
+			}
+#else
+			BX_UNUSED(_idx);
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+		}
+
+		void frameFence()
+		{
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+			if (m_persistentBufferSupport)
+			{
+				m_frameFence[m_frameIdx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+				// Wait until GPU is done with frame that used next set of persistent buffers,
+				// so that next frame can write into them directly.
+				m_frameIdx = (m_frameIdx + 1) % BGFX_CONFIG_MAX_FRAME_LATENCY;
+				waitFrameFence(m_frameIdx);
+
+				m_uploadOffset = 0;
+			}
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+		}
+
+		bool uploadBuffer(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data)
+		{
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+			if (m_persistentBufferSupport
+			&&  m_uploadOffset + _size <= m_uploadBuffer.m_size)
+			{
+				bx::memCopy(m_uploadBuffer.m_ptr[m_frameIdx] + m_uploadOffset, _data, _size);
+
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  m_uploadBuffer.m_id[m_frameIdx]) );
+				GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, _id) );
+				GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, m_uploadOffset, _offset, _size) );
+				GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  0) );
+
+				m_uploadOffset = bx::alignUp(m_uploadOffset + _size, 16);
+				return true;
+			}
+#else
+			BX_UNUSED(_id, _offset, _size, _data);
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+
+			return false;
+		}
+
 		void invalidateCache()
 		{
 			if (m_samplerObjectSupport)
@@ -4798,6 +4898,7 @@ namespace bgfx { namespace gl
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
 		bool m_imageLoadStoreSupport;
+		bool m_persistentBufferSupport;
 		bool m_flip;
 
 		uint64_t m_hash;
@@ -4825,6 +4926,11 @@ namespace bgfx { namespace gl
 		Workaround m_workaround;
 
 		GLuint m_currentFbo;
+
+		GLsync m_frameFence[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		BufferRingGL m_uploadBuffer;
+		uint32_t m_frameIdx;
+		uint32_t m_uploadOffset;
 	};
 
 	RendererContextGL* s_renderGL;
@@ -5512,14 +5618,189 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	bool BufferRingGL::create(GLenum _target, uint32_t _size)
+	{
+		m_size = 0;
+
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
+
+		GL_CHECK(glGenBuffers(BX_COUNTOF(m_id), m_id) );
+
+		uint32_t numMapped = 0;
+		for (; numMapped < BX_COUNTOF(m_id); ++numMapped)
+		{
+			GL_CHECK(glBindBuffer(_target, m_id[numMapped]) );
+			GL_CHECK(glBufferStorage(_target, _size, NULL, flags) );
+			m_ptr[numMapped] = (uint8_t*)glMapBufferRange(_target, 0, _size, flags);
+
+			if (NULL == m_ptr[numMapped])
+			{
+				break;
+			}
+		}
+
+		if (numMapped != BX_COUNTOF(m_id) )
+		{
+			BX_TRACE("Failed to map persistent buffer (size %d).", _size);
+
+			for (uint32_t ii = 0; ii < numMapped; ++ii)
+			{
+				GL_CHECK(glBindBuffer(_target, m_id[ii]) );
+				GL_CHECK(glUnmapBuffer(_target) );
+			}
+
+			GL_CHECK(glBindBuffer(_target, 0) );
+			GL_CHECK(glDeleteBuffers(BX_COUNTOF(m_id), m_id) );
+			return false;
+		}
+
+		GL_CHECK(glBindBuffer(_target, 0) );
+
+		m_size = _size;
+		return true;
+#else
+		BX_UNUSED(_target, _size);
+		return false;
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+	}
+
+	void BufferRingGL::destroy(GLenum _target)
+	{
+#if BGFX_USE_GL_PERSISTENT_BUFFER
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_id); ++ii)
+		{
+			GL_CHECK(glBindBuffer(_target, m_id[ii]) );
+			GL_CHECK(glUnmapBuffer(_target) );
+		}
+
+		GL_CHECK(glBindBuffer(_target, 0) );
+		GL_CHECK(glDeleteBuffers(BX_COUNTOF(m_id), m_id) );
+#else
+		BX_UNUSED(_target);
+#endif // BGFX_USE_GL_PERSISTENT_BUFFER
+
+		m_size = 0;
+	}
+
+	void IndexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_ASSERT(0 != m_id, "Updating invalid index buffer.");
+
+		if (_discard
+		&&  s_renderGL->m_persistentBufferSupport)
+		{
+			// Discarded buffer is replaced every frame, write it directly into
+			// persistent buffer of current frame.
+			if (!m_ring.isValid() )
+			{
+				destroy();
+
+				if (!m_ring.create(GL_ELEMENT_ARRAY_BUFFER, m_size) )
+				{
+					s_renderGL->m_persistentBufferSupport = false;
+					create(m_size, NULL, m_flags);
+				}
+			}
+
+			if (m_ring.isValid() )
+			{
+				const uint32_t idx = s_renderGL->m_frameIdx;
+				bx::memCopy(m_ring.m_ptr[idx] + _offset, _data, _size);
+				m_id = m_ring.m_id[idx];
+				return;
+			}
+		}
+		else if (_discard)
+		{
+			// orphan buffer...
+			destroy();
+			create(m_size, NULL, m_flags);
+		}
+		else if (s_renderGL->uploadBuffer(m_id, _offset, _size, _data) )
+		{
+			return;
+		}
+
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+		GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+	}
+
 	void IndexBufferGL::destroy()
 	{
+		if (m_ring.isValid() )
+		{
+			m_ring.destroy(GL_ELEMENT_ARRAY_BUFFER);
+			return;
+		}
+
 		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
 		GL_CHECK(glDeleteBuffers(1, &m_id) );
 	}
 
+	void VertexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_ASSERT(0 != m_id, "Updating invalid vertex buffer.");
+
+		if (_discard
+		&&  s_renderGL->m_persistentBufferSupport)
+		{
+			if (!m_ring.isValid() )
+			{
+				destroy();
+
+				if (!m_ring.create(m_target, m_size) )
+				{
+					s_renderGL->m_persistentBufferSupport = false;
+					create(m_size, NULL, m_layoutHandle, 0);
+				}
+			}
+
+			if (m_ring.isValid() )
+			{
+				const uint32_t idx = s_renderGL->m_frameIdx;
+				bx::memCopy(m_ring.m_ptr[idx] + _offset, _data, _size);
+				m_id = m_ring.m_id[idx];
+				return;
+			}
+		}
+		else if (_discard)
+		{
+			// orphan buffer...
+			destroy();
+			create(m_size, NULL, m_layoutHandle, 0);
+		}
+		else if (s_renderGL->uploadBuffer(m_id, _offset, _size, _data) )
+		{
+			return;
+		}
+
+		GL_CHECK(glBindBuffer(m_target, m_id) );
+		GL_CHECK(glBufferSubData(m_target
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(m_target, 0) );
+	}
+
 	void VertexBufferGL::destroy()
 	{
+		if (m_ring.isValid() )
+		{
+			m_ring.destroy(m_target);
+			return;
+		}
+
 		GL_CHECK(glBindBuffer(m_target, 0) );
 		GL_CHECK(glDeleteBuffers(1, &m_id) );
 	}
@@ -7513,6 +7794,10 @@ namespace bgfx { namespace gl
 		RenderBind currentBind;
 		currentBind.clear();
 
+		RenderBind renderBind;
+		renderBind.clear();
+		RenderBindRef renderBindRef = { UINT32_MAX, 0 };
+
 		static ViewState viewState;
 		viewState.reset(_render);
 
@@ -7591,7 +7876,7 @@ namespace bgfx { namespace gl
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				_render->updateRenderBind(itemIdx, renderBindRef, renderBind);
 				++item;
 
 				if (viewChanged)
@@ -8817,6 +9102,8 @@ namespace bgfx { namespace gl
 			BGFX_GL_PROFILER_END();
 		}
 
+		frameFence();
+
 		if (0 != m_vao)
 		{
 			GL_CHECK(glBindVertexArray(0) );
@@ -38,6 +38,24 @@
 #	define BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION 0
 #endif // BGFX_GL_CONFIG_TEXTURE_READ_BACK_EMULATION
 
+// Keep transient buffers and dynamic buffer uploads in persistently mapped
+// memory when GL_ARB_buffer_storage is available. If mapping fails, buffers
+// are updated with glBufferSubData.
+#ifndef BGFX_GL_CONFIG_PERSISTENT_BUFFER
+#	define BGFX_GL_CONFIG_PERSISTENT_BUFFER 0
+#endif // BGFX_GL_CONFIG_PERSISTENT_BUFFER
+
+// Size of per frame staging area used for dynamic buffer uploads when
+// persistent buffers are used. Updates that don't fit use glBufferSubData.
+#ifndef BGFX_GL_CONFIG_UPLOAD_BUFFER_SIZE
+#	define BGFX_GL_CONFIG_UPLOAD_BUFFER_SIZE (4<<20)
+#endif // BGFX_GL_CONFIG_UPLOAD_BUFFER_SIZE
+
+#define BGFX_USE_GL_PERSISTENT_BUFFER (BGFX_GL_CONFIG_PERSISTENT_BUFFER \
+	&& BGFX_CONFIG_RENDERER_OPENGL                                      \
+	&& BGFX_USE_GL_DYNAMIC_LIB                                          \
+	)
+
 #define BGFX_GL_PROFILER_BEGIN(_view, _abgr)                                               \
 	BX_MACRO_BLOCK_BEGIN                                                                   \
 		GL_CHECK(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, s_viewName[view]) ); \
@@ -86,6 +104,7 @@ typedef double GLdouble;
 #		include <GLES2/gl2ext.h>
 typedef int64_t  GLint64;
 typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 #		define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
 #		define GL_HALF_FLOAT GL_HALF_FLOAT_OES
 #		define GL_RGBA8 GL_RGBA8_OES
@@ -1095,6 +1114,14 @@ typedef uint64_t GLuint64;
 #	define GL_DRAW_INDIRECT_BUFFER 0x8F3F
 #endif // GL_DRAW_INDIRECT_BUFFER
 
+#ifndef GL_COPY_READ_BUFFER
+#	define GL_COPY_READ_BUFFER 0x8F36
+#endif // GL_COPY_READ_BUFFER
+
+#ifndef GL_COPY_WRITE_BUFFER
+#	define GL_COPY_WRITE_BUFFER 0x8F37
+#endif // GL_COPY_WRITE_BUFFER
+
 #ifndef GL_DISPATCH_INDIRECT_BUFFER
 #	define GL_DISPATCH_INDIRECT_BUFFER 0x90EE
 #endif // GL_DISPATCH_INDIRECT_BUFFER
@@ -1321,12 +1348,32 @@ namespace bgfx { namespace gl
 		HashMap m_hashMap;
 	};
 
+	/// Persistently and coherently mapped buffer per frame in flight. Frame
+	/// fences in RendererContextGL guarantee that buffer for current frame is
+	/// not used by GPU anymore.
+	struct BufferRingGL
+	{
+		/// Returns false when buffer can't be mapped, buffer is not created then.
+		bool create(GLenum _target, uint32_t _size);
+		void destroy(GLenum _target);
+
+		bool isValid() const
+		{
+			return 0 != m_size;
+		}
+
+		GLuint   m_id[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint8_t* m_ptr[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t m_size;
+	};
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
 		{
 			m_size  = _size;
 			m_flags = _flags;
+			m_ring.m_size = 0;
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_ASSERT(0 != m_id, "Failed to generate buffer id.");
@@ -1339,31 +1386,13 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_ASSERT(0 != m_id, "Updating invalid index buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_flags);
-			}
-
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
-			GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		uint32_t m_size;
 		uint16_t m_flags;
+		BufferRingGL m_ring;
 	};
 
 	struct VertexBufferGL
@@ -1375,6 +1404,7 @@ namespace bgfx { namespace gl
 			const bool drawIndirect = 0 != (_flags & BGFX_BUFFER_DRAW_INDIRECT);
 
 			m_target = drawIndirect ? GL_DRAW_INDIRECT_BUFFER : GL_ARRAY_BUFFER;
+			m_ring.m_size = 0;
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_ASSERT(0 != m_id, "Failed to generate buffer id.");
@@ -1387,32 +1417,14 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(m_target, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_ASSERT(0 != m_id, "Updating invalid vertex buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_layoutHandle, 0);
-			}
-
-			GL_CHECK(glBindBuffer(m_target, m_id) );
-			GL_CHECK(glBufferSubData(m_target
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(m_target, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		GLenum m_target;
 		uint32_t m_size;
 		VertexLayoutHandle m_layoutHandle;
+		BufferRingGL m_ring;
 	};
 
 	struct TextureGL
@@ -4130,6 +4130,10 @@ BX_STATIC_ASSERT(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNa
 		RenderBind currentBind;
 		currentBind.clear();
 
+		RenderBind renderBind;
+		renderBind.clear();
+		RenderBindRef renderBindRef = { UINT32_MAX, 0 };
+
 		static ViewState viewState;
 		viewState.reset(_render);
 		uint32_t blendFactor = 0;
@@ -4190,7 +4194,7 @@ BX_STATIC_ASSERT(BX_COUNTOF(s_accessNames) == Access::Count, "Invalid s_accessNa
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				_render->updateRenderBind(itemIdx, renderBindRef, renderBind);
 				++item;
 
 				if (viewChanged
@@ -362,6 +362,7 @@ VK_IMPORT_DEVICE
 			EXT_debug_utils,
 			EXT_line_rasterization,
 			EXT_memory_budget,
+			EXT_pipeline_creation_feedback,
 			EXT_shader_viewport_index_layer,
 			KHR_draw_indirect_count,
 			KHR_get_physical_device_properties2,
@@ -387,6 +388,7 @@ VK_IMPORT_DEVICE
 		{ "VK_EXT_debug_utils",                     1, false, false, BGFX_CONFIG_DEBUG_OBJECT_NAME || BGFX_CONFIG_DEBUG_ANNOTATION, Layer::Count },
 		{ "VK_EXT_line_rasterization",              1, false, false, true,                                                          Layer::Count },
 		{ "VK_EXT_memory_budget",                   1, false, false, true,                                                          Layer::Count },
+		{ "VK_EXT_pipeline_creation_feedback",      1, false, false, true,                                                          Layer::Count },
 		{ "VK_EXT_shader_viewport_index_layer",     1, false, false, true,                                                          Layer::Count },
 		{ "VK_KHR_draw_indirect_count",             1, false, false, true,                                                          Layer::Count },
 		{ "VK_KHR_get_physical_device_properties2", 1, false, false, true,                                                          Layer::Count },
@@ -878,7 +880,6 @@ VK_IMPORT_DEVICE
 	template<> VkObjectType getType<VkBuffer             >() { return VK_OBJECT_TYPE_BUFFER;                }
 	template<> VkObjectType getType<VkCommandPool        >() { return VK_OBJECT_TYPE_COMMAND_POOL;          }
 	template<> VkObjectType getType<VkDescriptorPool     >() { return VK_OBJECT_TYPE_DESCRIPTOR_POOL;       }
-	template<> VkObjectType getType<VkDescriptorSet      >() { return VK_OBJECT_TYPE_DESCRIPTOR_SET;        }
 	template<> VkObjectType getType<VkDescriptorSetLayout>() { return VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT; }
 	template<> VkObjectType getType<VkDeviceMemory       >() { return VK_OBJECT_TYPE_DEVICE_MEMORY;         }
 	template<> VkObjectType getType<VkFence              >() { return VK_OBJECT_TYPE_FENCE;                 }
@@ -1107,12 +1108,18 @@ VK_IMPORT_DEVICE
 			);
 	}
 
-#define MAX_DESCRIPTOR_SETS (1024 * BGFX_CONFIG_MAX_FRAME_LATENCY)
+#define MAX_DESCRIPTOR_SETS 1024
 
 	struct RendererContextVK : public RendererContextI
 	{
 		RendererContextVK()
 			: m_allocatorCb(NULL)
+			, m_pipelineCacheId(0)
+			, m_descriptorSetGeneration(0)
+			, m_colorPaletteHash(0)
+			, m_pipelineCacheHits(0)
+			, m_pipelineCacheMisses(0)
+			, m_numPipelinesUnsaved(0)
 			, m_renderDocDll(NULL)
 			, m_vulkan1Dll(NULL)
 			, m_maxAnisotropy(1.0f)
@@ -1889,6 +1896,8 @@ VK_IMPORT_DEVICE
 					: _init.resolution.maxFrameLatency
 					;
 
+				m_memoryAllocator.init(m_device, m_allocatorCb, BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE);
+
 				result = m_cmd.init(m_globalQueueFamily, m_globalQueue, m_numFramesInFlight);
 
 				if (VK_SUCCESS != result)
@@ -1944,44 +1953,77 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SwapChainCreated;
 
 			{
-				VkDescriptorPoolSize dps[] =
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
-					{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_SAMPLER,                MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, MAX_DESCRIPTOR_SETS * 2                                },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          MAX_DESCRIPTOR_SETS * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-				};
+					result = m_descriptorSetCache[ii].init(m_device, m_allocatorCb, MAX_DESCRIPTOR_SETS);
 
-				VkDescriptorPoolCreateInfo dpci;
-				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-				dpci.pNext = NULL;
-				dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-				dpci.maxSets       = MAX_DESCRIPTOR_SETS;
-				dpci.poolSizeCount = BX_COUNTOF(dps);
-				dpci.pPoolSizes    = dps;
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+						goto error;
+					}
+				}
 
-				result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &m_descriptorPool);
+				result = m_drawRecorder.init(
+					  m_device
+					, m_allocatorCb
+					, m_globalQueueFamily
+					, m_numFramesInFlight
+					, BGFX_CONFIG_MULTITHREADED ? BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS : 0
+					);
 
 				if (VK_SUCCESS != result)
 				{
-					BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+					BX_TRACE("Init error: Failed to create draw recorder %d: %s.", result, getName(result) );
 					goto error;
 				}
 
+				bx::HashMurmur2A murmur;
+				murmur.begin();
+				murmur.add(m_deviceProperties.vendorID);
+				murmur.add(m_deviceProperties.deviceID);
+				murmur.add(m_deviceProperties.driverVersion);
+				murmur.add(m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+				m_pipelineCacheId = (uint64_t(BX_MAKEFOURCC('V', 'K', 'P', 'C') ) << 32) | murmur.end();
+
+				uint32_t cacheSize = g_callback->cacheReadSize(m_pipelineCacheId);
+				void* cacheData = NULL;
+
+				if (0 < cacheSize)
+				{
+					cacheData = bx::alloc(g_allocator, cacheSize);
+					if (g_callback->cacheRead(m_pipelineCacheId, cacheData, cacheSize) )
+					{
+						BX_TRACE("Loading pipeline cache (size %d).", cacheSize);
+					}
+					else
+					{
+						cacheSize = 0;
+					}
+				}
+
 				VkPipelineCacheCreateInfo pcci;
 				pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 				pcci.pNext = NULL;
 				pcci.flags = 0;
-				pcci.initialDataSize = 0;
-				pcci.pInitialData    = NULL;
+				pcci.initialDataSize = cacheSize;
+				pcci.pInitialData    = cacheData;
 				result = vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &m_pipelineCache);
 
+				bx::free(g_allocator, cacheData);
+
 				if (VK_SUCCESS != result)
 				{
 					BX_TRACE("Init error: vkCreatePipelineCache failed %d: %s.", result, getName(result) );
 					goto error;
 				}
+
+				m_pipelineCompiler.init(
+					  m_device
+					, m_pipelineCache
+					, m_allocatorCb
+					, BGFX_CONFIG_MULTITHREADED ? BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS : 0
+					);
 			}
 
 			{
@@ -2067,16 +2109,24 @@ VK_IMPORT_DEVICE
 					m_scratchBuffer[ii].destroy();
 					m_scratchStagingBuffer[ii].destroy();
 				}
+				m_pipelineCompiler.shutdown();
 				vkDestroy(m_pipelineCache);
-				vkDestroy(m_descriptorPool);
 				[[fallthrough]];
 
 			case ErrorState::SwapChainCreated:
+				m_drawRecorder.shutdown();
+
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+				{
+					m_descriptorSetCache[ii].shutdown();
+				}
+
 				m_backBuffer.destroy();
 				[[fallthrough]];
 
 			case ErrorState::CommandQueueCreated:
 				m_cmd.shutdown();
+				m_memoryAllocator.shutdown();
 				[[fallthrough]];
 
 			case ErrorState::DeviceCreated:
@@ -2118,6 +2168,10 @@ VK_IMPORT_DEVICE
 
 			preReset();
 
+			updatePipelines(true);
+			m_pipelineCompiler.shutdown();
+			savePipelineCache();
+
 			m_pipelineStateCache.invalidate();
 			m_descriptorSetLayoutCache.invalidate();
 			m_renderPassCache.invalidate();
@@ -2163,9 +2217,16 @@ VK_IMPORT_DEVICE
 			m_backBuffer.destroy();
 
 			m_cmd.shutdown();
+			m_memoryAllocator.shutdown();
 
 			vkDestroy(m_pipelineCache);
-			vkDestroy(m_descriptorPool);
+
+			m_drawRecorder.shutdown();
+
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				m_descriptorSetCache[ii].shutdown();
+			}
 
 			vkDestroyDevice(m_device, m_allocatorCb);
 
@@ -2223,6 +2284,7 @@ VK_IMPORT_DEVICE
 
 		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2244,6 +2306,7 @@ VK_IMPORT_DEVICE
 
 		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2259,6 +2322,7 @@ VK_IMPORT_DEVICE
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2275,6 +2339,7 @@ VK_IMPORT_DEVICE
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2285,6 +2350,8 @@ VK_IMPORT_DEVICE
 
 		void destroyShader(ShaderHandle _handle) override
 		{
+			// Shader module might be used by pipeline being compiled.
+			updatePipelines(true);
 			m_shaders[_handle.idx].destroy();
 		}
 
@@ -2295,6 +2362,7 @@ VK_IMPORT_DEVICE
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			updatePipelines(true);
 			m_program[_handle.idx].destroy();
 		}
 
@@ -2386,6 +2454,7 @@ VK_IMPORT_DEVICE
 
 		void destroyTexture(TextureHandle _handle) override
 		{
+			invalidateDescriptorSets();
 			m_imageViewCache.invalidateWithParent(_handle.idx);
 			m_textures[_handle.idx].destroy();
 		}
@@ -2579,6 +2648,15 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void release(DeviceMemoryAllocationVK& _allocation)
+		{
+			if (VK_NULL_HANDLE != _allocation.m_memory)
+			{
+				m_cmd.release(_allocation);
+				_allocation = DeviceMemoryAllocationVK();
+			}
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -2762,6 +2840,7 @@ VK_IMPORT_DEVICE
 				m_maxAnisotropy = maxAnisotropy;
 				m_samplerCache.invalidate();
 				m_samplerBorderColorCache.invalidate();
+				invalidateDescriptorSets();
 			}
 
 			bool depthClamp = m_deviceFeatures.depthClamp && !!(_resolution.reset & BGFX_RESET_DEPTH_CLAMP);
@@ -2769,6 +2848,7 @@ VK_IMPORT_DEVICE
 			if (m_depthClamp != depthClamp)
 			{
 				m_depthClamp = depthClamp;
+				updatePipelines(true);
 				m_pipelineStateCache.invalidate();
 			}
 
@@ -2936,6 +3016,7 @@ VK_IMPORT_DEVICE
 			if (m_wireframe != wireframe)
 			{
 				m_wireframe = wireframe;
+				updatePipelines(true);
 				m_pipelineStateCache.invalidate();
 			}
 		}
@@ -3504,6 +3585,13 @@ VK_IMPORT_DEVICE
 				| ( _stencil ? VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT)
 				;
 
+			if (1024 <= m_imageViewCache.getCount() )
+			{
+				// Least recently used view will be evicted, and it might be
+				// referenced by cached descriptor set.
+				invalidateDescriptorSets();
+			}
+
 			VkImageView view;
 			VK_CHECK(texture.createView(0, texture.m_numSides, _mip, _numMips, _type, aspectMask, false, &view) );
 			m_imageViewCache.add(hashKey, view, _handle.idx);
@@ -3547,11 +3635,12 @@ VK_IMPORT_DEVICE
 			VK_CHECK(vkCreateComputePipelines(m_device, m_pipelineCache, 1, &cpci, m_allocatorCb, &pipeline) );
 
 			m_pipelineStateCache.add(hash, pipeline);
+			++m_numPipelinesUnsaved;
 
 			return pipeline;
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData, bool _async = false)
 		{
 			ProgramVK& program = m_program[_program.idx];
 
@@ -3620,51 +3709,68 @@ VK_IMPORT_DEVICE
 				return pipeline;
 			}
 
-			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkPipelineColorBlendStateCreateInfo colorBlendState;
-			colorBlendState.pAttachments = blendAttachmentState;
+			if (m_pipelinePending.end() != m_pipelinePending.find(hash) )
+			{
+				if (_async)
+				{
+					return VK_NULL_HANDLE;
+				}
+
+				updatePipelines(true);
+				return m_pipelineStateCache.find(hash);
+			}
+
+			const bool async = _async && 0 < m_pipelineCompiler.getNumThreads();
+
+			PipelineCreateInfoVK stackPci;
+			PipelineCreateInfoVK& pci = async
+				? *BX_NEW(g_allocator, PipelineCreateInfoVK)
+				: stackPci
+				;
+
+			pci.m_hash     = hash;
+			pci.m_pipeline = VK_NULL_HANDLE;
+			pci.m_result   = VK_SUCCESS;
+			pci.m_next     = NULL;
+
+			VkPipelineColorBlendStateCreateInfo& colorBlendState = pci.m_colorBlendState;
+			colorBlendState.pAttachments = pci.m_blendAttachmentState;
 			setBlendState(colorBlendState, _state);
 
-			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			VkPipelineInputAssemblyStateCreateInfo& inputAssemblyState = pci.m_inputAssemblyState;
 			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 			inputAssemblyState.pNext = NULL;
 			inputAssemblyState.flags = 0;
 			inputAssemblyState.topology = s_primInfo[(_state&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT].m_topology;
 			inputAssemblyState.primitiveRestartEnable = VK_FALSE;
 
-			VkPipelineRasterizationStateCreateInfo rasterizationState;
+			VkPipelineRasterizationStateCreateInfo& rasterizationState = pci.m_rasterizationState;
 			setRasterizerState(rasterizationState, _state, m_wireframe);
 
 			VkBaseInStructure* nextRasterizationState = (VkBaseInStructure*)&rasterizationState;
 
-			VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRasterizationState;
 			if (s_extension[Extension::EXT_conservative_rasterization].m_supported)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&conservativeRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&conservativeRasterizationState;
-				setConservativeRasterizerState(conservativeRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&pci.m_conservativeRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&pci.m_conservativeRasterizationState;
+				setConservativeRasterizerState(pci.m_conservativeRasterizationState, _state);
 			}
 
-			VkPipelineRasterizationLineStateCreateInfoEXT lineRasterizationState;
 			if (m_lineAASupport)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&lineRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&lineRasterizationState;
-				setLineRasterizerState(lineRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&pci.m_lineRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&pci.m_lineRasterizationState;
+				setLineRasterizerState(pci.m_lineRasterizationState, _state);
 			}
 
-			VkPipelineDepthStencilStateCreateInfo depthStencilState;
-			setDepthStencilState(depthStencilState, _state, _stencil);
-
-			VkVertexInputBindingDescription  inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
-			VkVertexInputAttributeDescription inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+			setDepthStencilState(pci.m_depthStencilState, _state, _stencil);
 
-			VkPipelineVertexInputStateCreateInfo vertexInputState;
-			vertexInputState.pVertexBindingDescriptions   = inputBinding;
-			vertexInputState.pVertexAttributeDescriptions = inputAttrib;
+			VkPipelineVertexInputStateCreateInfo& vertexInputState = pci.m_vertexInputState;
+			vertexInputState.pVertexBindingDescriptions   = pci.m_inputBinding;
+			vertexInputState.pVertexAttributeDescriptions = pci.m_inputAttrib;
 			setInputLayout(vertexInputState, _numStreams, _layouts, program, _numInstanceData);
 
-			const VkDynamicState dynamicStates[] =
+			static const VkDynamicState dynamicStates[] =
 			{
 				VK_DYNAMIC_STATE_VIEWPORT,
 				VK_DYNAMIC_STATE_SCISSOR,
@@ -3672,14 +3778,14 @@ VK_IMPORT_DEVICE
 				VK_DYNAMIC_STATE_STENCIL_REFERENCE,
 			};
 
-			VkPipelineDynamicStateCreateInfo dynamicState;
+			VkPipelineDynamicStateCreateInfo& dynamicState = pci.m_dynamicState;
 			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 			dynamicState.pNext = NULL;
 			dynamicState.flags = 0;
 			dynamicState.dynamicStateCount = BX_COUNTOF(dynamicStates);
 			dynamicState.pDynamicStates    = dynamicStates;
 
-			VkPipelineShaderStageCreateInfo shaderStages[2];
+			VkPipelineShaderStageCreateInfo* shaderStages = pci.m_shaderStages;
 			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 			shaderStages[0].pNext = NULL;
 			shaderStages[0].flags = 0;
@@ -3699,7 +3805,7 @@ VK_IMPORT_DEVICE
 				shaderStages[1].pSpecializationInfo = NULL;
 			}
 
-			VkPipelineViewportStateCreateInfo viewportState;
+			VkPipelineViewportStateCreateInfo& viewportState = pci.m_viewportState;
 			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 			viewportState.pNext = NULL;
 			viewportState.flags = 0;
@@ -3708,7 +3814,7 @@ VK_IMPORT_DEVICE
 			viewportState.scissorCount  = 1;
 			viewportState.pScissors     = NULL;
 
-			VkPipelineMultisampleStateCreateInfo multisampleState;
+			VkPipelineMultisampleStateCreateInfo& multisampleState = pci.m_multisampleState;
 			multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
 			multisampleState.pNext = NULL;
 			multisampleState.flags = 0;
@@ -3719,7 +3825,7 @@ VK_IMPORT_DEVICE
 			multisampleState.alphaToCoverageEnable = !!(BGFX_STATE_BLEND_ALPHA_TO_COVERAGE & _state);
 			multisampleState.alphaToOneEnable      = VK_FALSE;
 
-			VkGraphicsPipelineCreateInfo graphicsPipeline;
+			VkGraphicsPipelineCreateInfo& graphicsPipeline = pci.m_info;
 			graphicsPipeline.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 			graphicsPipeline.pNext = NULL;
 			graphicsPipeline.flags = 0;
@@ -3731,7 +3837,7 @@ VK_IMPORT_DEVICE
 			graphicsPipeline.pViewportState      = &viewportState;
 			graphicsPipeline.pRasterizationState = &rasterizationState;
 			graphicsPipeline.pMultisampleState   = &multisampleState;
-			graphicsPipeline.pDepthStencilState  = &depthStencilState;
+			graphicsPipeline.pDepthStencilState  = &pci.m_depthStencilState;
 			graphicsPipeline.pColorBlendState    = &colorBlendState;
 			graphicsPipeline.pDynamicState       = &dynamicState;
 			graphicsPipeline.layout     = program.m_pipelineLayout;
@@ -3740,81 +3846,181 @@ VK_IMPORT_DEVICE
 			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
 			graphicsPipeline.basePipelineIndex  = 0;
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			bool cached = length > 0;
+			pci.m_feedback.flags    = 0;
+			pci.m_feedback.duration = 0;
+
+			if (s_extension[Extension::EXT_pipeline_creation_feedback].m_supported)
+			{
+				VkPipelineCreationFeedbackCreateInfoEXT& feedbackInfo = pci.m_feedbackInfo;
+				feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+				feedbackInfo.pNext = NULL;
+				feedbackInfo.pPipelineCreationFeedback          = &pci.m_feedback;
+				feedbackInfo.pipelineStageCreationFeedbackCount = graphicsPipeline.stageCount;
+				feedbackInfo.pPipelineStageCreationFeedbacks    = pci.m_stageFeedback;
+
+				graphicsPipeline.pNext = &feedbackInfo;
+			}
+
+			if (async)
+			{
+				m_pipelinePending.insert(hash);
+				m_pipelineCompiler.push(&pci);
+
+				return VK_NULL_HANDLE;
+			}
+
+			m_pipelineCompiler.compile(&pci);
+			addPipeline(pci);
+
+			return pci.m_pipeline;
+		}
 
-			void* cachedData = NULL;
+		void addPipeline(const PipelineCreateInfoVK& _pci)
+		{
+			BX_ASSERT(VK_SUCCESS == _pci.m_result
+				, "vkCreateGraphicsPipelines failed %d: %s."
+				, _pci.m_result
+				, getName(_pci.m_result)
+				);
 
-			VkPipelineCacheCreateInfo pcci;
-			pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-			pcci.pNext = NULL;
-			pcci.flags = 0;
-			pcci.initialDataSize = 0;
-			pcci.pInitialData    = NULL;
+			bool cacheHit = false;
 
-			if (cached)
+			if (0 != (_pci.m_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) )
 			{
-				cachedData = bx::alloc(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
+				if (0 != (_pci.m_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT) )
+				{
+					++m_pipelineCacheHits;
+					cacheHit = true;
+				}
+				else
 				{
-					BX_TRACE("Loading cached pipeline state (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
+					++m_pipelineCacheMisses;
+				}
+			}
 
-					pcci.initialDataSize = (size_t)reader.remaining();
-					pcci.pInitialData    = reader.getDataPtr();
+			if (VK_SUCCESS == _pci.m_result)
+			{
+				m_pipelineStateCache.add(_pci.m_hash, _pci.m_pipeline);
+
+				// Pipeline found in cache didn't add anything to it.
+				if (!cacheHit)
+				{
+					++m_numPipelinesUnsaved;
 				}
 			}
+		}
 
-			VkPipelineCache cache;
-			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
+		void updatePipelines(bool _wait)
+		{
+			for (PipelineCreateInfoVK* pci = m_pipelineCompiler.pop(_wait); NULL != pci; pci = m_pipelineCompiler.pop(_wait) )
+			{
+				m_pipelinePending.erase(pci->m_hash);
+				addPipeline(*pci);
+				bx::deleteObject(g_allocator, pci);
+			}
+		}
 
-			VK_CHECK(vkCreateGraphicsPipelines(
-				  m_device
-				, cache
-				, 1
-				, &graphicsPipeline
-				, m_allocatorCb
-				, &pipeline
-				) );
-			m_pipelineStateCache.add(hash, pipeline);
+		void savePipelineCache()
+		{
+			m_numPipelinesUnsaved = 0;
 
 			size_t dataSize;
-			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
+			VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, NULL) );
 
 			if (0 < dataSize)
 			{
-				if (length < dataSize)
-				{
-					cachedData = bx::realloc(g_allocator, cachedData, dataSize);
-				}
-
-				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
-				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
+				void* data = bx::alloc(g_allocator, dataSize);
+				VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data) );
+				g_callback->cacheWrite(m_pipelineCacheId, data, (uint32_t)dataSize);
+				bx::free(g_allocator, data);
 			}
+		}
+
+		uint32_t executeDrawCommands(const VkRenderPassBeginInfo& _rpbi, const VkViewport& _viewport, const VkRect2D& _scissor)
+		{
+			vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+			VkCommandBufferInheritanceInfo cbii;
+			cbii.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			cbii.pNext = NULL;
+			cbii.renderPass  = _rpbi.renderPass;
+			cbii.subpass     = 0;
+			cbii.framebuffer = _rpbi.framebuffer;
+			cbii.occlusionQueryEnable = VK_FALSE;
+			cbii.queryFlags         = 0;
+			cbii.pipelineStatistics = 0;
 
-			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
-			vkDestroy(cache);
+			::VkCommandBuffer commandBuffers[DrawRecorderVK::kMaxTasks];
+			const uint32_t num = m_drawRecorder.record(
+				  cbii
+				, _viewport
+				, _scissor
+				, m_drawCommands.empty() ? NULL : &m_drawCommands[0]
+				, uint32_t(m_drawCommands.size() )
+				, commandBuffers
+				);
 
-			if (NULL != cachedData)
+			if (0 < num)
 			{
-				bx::free(g_allocator, cachedData);
+				vkCmdExecuteCommands(m_commandBuffer, num, commandBuffers);
 			}
 
-			return pipeline;
+			vkCmdEndRenderPass(m_commandBuffer);
+
+			m_drawCommands.clear();
+
+			return num;
+		}
+
+		void invalidateDescriptorSets()
+		{
+			++m_descriptorSetGeneration;
 		}
 
 		VkDescriptorSet getDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, const ScratchBufferVK& scratchBuffer, const float _palette[][4])
 		{
-			VkDescriptorSet descriptorSet;
+			const uint32_t vsize = program.m_vsh->m_size;
+			const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
+
+			// Uniforms are bound with dynamic offsets, so only scratch buffer
+			// and uniform block sizes are part of descriptor set.
+			DescriptorSetKeyVK key;
+			bx::memSet(&key, 0, sizeof(key) );
+			key.m_layout  = program.m_descriptorSetLayout;
+			key.m_buffer  = scratchBuffer.m_buffer;
+			key.m_vsize   = vsize;
+			key.m_fsize   = fsize;
+			key.m_palette = NULL != _palette;
+
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& bind = renderBind.m_bind[stage];
+				DescriptorSetKeyVK::Bind& keyBind = key.m_bind[stage];
+
+				if (kInvalidHandle != bind.m_idx
+				&&  isValid(program.m_bindInfo[stage].uniformHandle) )
+				{
+					keyBind.m_samplerFlags = bind.m_samplerFlags;
+					keyBind.m_idx          = bind.m_idx;
+					keyBind.m_type         = bind.m_type;
+					keyBind.m_mip          = bind.m_mip;
+				}
+				else
+				{
+					keyBind.m_idx = kInvalidHandle;
+				}
+			}
 
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext              = NULL;
-			dsai.descriptorPool     = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts        = &program.m_descriptorSetLayout;
+			DescriptorSetCacheVK& descriptorSetCache = m_descriptorSetCache[m_cmd.m_currentFrameInFlight];
 
-			VK_CHECK(vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet) );
+			VkDescriptorSet descriptorSet = descriptorSetCache.find(key);
+
+			if (VK_NULL_HANDLE != descriptorSet)
+			{
+				return descriptorSet;
+			}
+
+			VK_CHECK(descriptorSetCache.alloc(key, &descriptorSet) );
 
 			VkDescriptorImageInfo  imageInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 			VkDescriptorBufferInfo bufferInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
@@ -3977,9 +4183,6 @@ VK_IMPORT_DEVICE
 				}
 			}
 
-			const uint32_t vsize = program.m_vsh->m_size;
-			const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
-
 			if (vsize > 0)
 			{
 				bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
@@ -4022,9 +4225,6 @@ VK_IMPORT_DEVICE
 
 			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
 
-			VkDescriptorSet temp = descriptorSet;
-			release(temp);
-
 			return descriptorSet;
 		}
 
@@ -4362,6 +4562,26 @@ VK_IMPORT_DEVICE
 			return result;
 		}
 
+		VkResult allocateMemory(const VkMemoryRequirements* requirements, VkMemoryPropertyFlags propertyFlags, bool _image, DeviceMemoryAllocationVK* _allocation)
+		{
+			VkResult result = VK_ERROR_UNKNOWN;
+			int32_t searchIndex = -1;
+			do
+			{
+				searchIndex++;
+				searchIndex = selectMemoryType(requirements->memoryTypeBits, propertyFlags, searchIndex);
+
+				if (searchIndex >= 0)
+				{
+					result = m_memoryAllocator.alloc(*requirements, searchIndex, _image, _allocation);
+				}
+			}
+			while (result != VK_SUCCESS
+			   &&  searchIndex >= 0);
+
+			return result;
+		}
+
 		VkResult createHostBuffer(uint32_t _size, VkMemoryPropertyFlags _flags, ::VkBuffer* _buffer, ::VkDeviceMemory* _memory, const void* _data = NULL)
 		{
 			BGFX_PROFILER_SCOPE("createHostBuffer", kColorResource);
@@ -4519,8 +4739,26 @@ VK_IMPORT_DEVICE
 		VkDevice m_device;
 		uint32_t m_globalQueueFamily;
 		VkQueue  m_globalQueue;
-		VkDescriptorPool m_descriptorPool;
 		VkPipelineCache  m_pipelineCache;
+		uint64_t         m_pipelineCacheId;
+
+		DeviceMemoryAllocatorVK m_memoryAllocator;
+
+		DescriptorSetCacheVK m_descriptorSetCache[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t             m_descriptorSetGeneration;
+		uint32_t             m_colorPaletteHash;
+
+		typedef stl::vector<DrawCommandVK> DrawCommandArray;
+		DrawRecorderVK   m_drawRecorder;
+		DrawCommandArray m_drawCommands;
+
+		PipelineCompilerVK m_pipelineCompiler;
+
+		typedef stl::unordered_set<uint32_t> PipelineHashSet;
+		PipelineHashSet m_pipelinePending;
+		uint32_t        m_pipelineCacheHits;
+		uint32_t        m_pipelineCacheMisses;
+		uint32_t        m_numPipelinesUnsaved;
 
 		TimerQueryVK m_gpuTimer;
 		OcclusionQueryVK m_occlusionQuery;
@@ -4621,16 +4859,6 @@ VK_DESTROY
 		}
 	}
 
-	void vkDestroy(VkDescriptorSet& _obj)
-	{
-		if (VK_NULL_HANDLE != _obj)
-		{
-			BGFX_PROFILER_SCOPE("vkFreeDescriptorSets", kColorResource);
-			vkFreeDescriptorSets(s_renderVK->m_device, s_renderVK->m_descriptorPool, 1, &_obj);
-			_obj = VK_NULL_HANDLE;
-		}
-	}
-
 	void release(VkDeviceMemory& _obj)
 	{
 		s_renderVK->release(_obj);
@@ -4641,11 +4869,6 @@ VK_DESTROY
 		s_renderVK->release(_obj);
 	}
 
-	void release(VkDescriptorSet& _obj)
-	{
-		s_renderVK->release(_obj);
-	}
-
 	void ScratchBufferVK::create(uint32_t _size, uint32_t _count, VkBufferUsageFlags usage, uint32_t _align)
 	{
 		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
@@ -4805,9 +5028,9 @@ VK_DESTROY
 		VkMemoryRequirements mr;
 		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_deviceMem) );
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false, &m_deviceMem) );
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem.m_memory, m_deviceMem.m_offset) );
 
 		if (!m_dynamic)
 		{
@@ -5908,14 +6131,14 @@ VK_DESTROY
 		VkMemoryRequirements imageMemReq;
 		vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
 
-		result = s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_textureDeviceMem);
+		result = s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &m_textureDeviceMem);
 		if (VK_SUCCESS != result)
 		{
 			BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
 			return result;
 		}
 
-		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem, 0);
+		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem.m_memory, m_textureDeviceMem.m_offset);
 		if (VK_SUCCESS != result)
 		{
 			BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
@@ -5951,14 +6174,14 @@ VK_DESTROY
 			VkMemoryRequirements imageMemReq_resolve;
 			vkGetImageMemoryRequirements(device, m_singleMsaaImage, &imageMemReq_resolve);
 
-			result = s_renderVK->allocateMemory(&imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_singleMsaaDeviceMem);
+			result = s_renderVK->allocateMemory(&imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true, &m_singleMsaaDeviceMem);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
 				return result;
 			}
 
-			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem, 0);
+			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem.m_memory, m_singleMsaaDeviceMem.m_offset);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
@@ -7931,120 +8154,1062 @@ VK_DESTROY
 			;
 	}
 
-	VkResult CommandQueueVK::init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight)
+	DeviceMemoryAllocatorVK::DeviceMemoryAllocatorVK()
+		: m_device(VK_NULL_HANDLE)
+		, m_allocatorCb(NULL)
+		, m_blockSize(0)
+		, m_dedicatedSize(0)
+		, m_numDedicated(0)
 	{
-		m_queueFamily = _queueFamily;
-		m_queue = _queue;
-		m_numFramesInFlight = bx::clamp<uint32_t>(_numFramesInFlight, 1, BGFX_CONFIG_MAX_FRAME_LATENCY);
-		m_activeCommandBuffer = VK_NULL_HANDLE;
-		m_consumeIndex = 0;
-
-		return reset();
 	}
 
-	VkResult CommandQueueVK::reset()
+	DeviceMemoryAllocatorVK::~DeviceMemoryAllocatorVK()
 	{
 		shutdown();
+	}
 
-		m_currentFrameInFlight = 0;
-		m_consumeIndex         = 0;
-
-		m_numSignalSemaphores = 0;
-		m_numWaitSemaphores   = 0;
-
-		m_activeCommandBuffer = VK_NULL_HANDLE;
-		m_currentFence        = VK_NULL_HANDLE;
-		m_completedFence      = VK_NULL_HANDLE;
-
-		m_submitted = 0;
-
-		VkCommandPoolCreateInfo cpci;
-		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-		cpci.pNext = NULL;
-		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
-		cpci.queueFamilyIndex = m_queueFamily;
-
-		VkCommandBufferAllocateInfo cbai;
-		cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		cbai.pNext = NULL;
-		cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-		cbai.commandBufferCount = 1;
+	void DeviceMemoryAllocatorVK::init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, VkDeviceSize _blockSize)
+	{
+		BX_ASSERT(_blockSize <= UINT32_MAX, "Device memory block size must fit into 32 bits.");
 
-		VkFenceCreateInfo fci;
-		fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		fci.pNext = NULL;
-		fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+		m_device        = _device;
+		m_allocatorCb   = _allocatorCb;
+		m_blockSize     = _blockSize;
+		m_dedicatedSize = 0;
+		m_numDedicated  = 0;
+	}
 
-		VkResult result = VK_SUCCESS;
+	void DeviceMemoryAllocatorVK::shutdown()
+	{
+		BX_WARN(0 == m_numDedicated, "Leaked %d dedicated device memory allocations.", m_numDedicated);
 
-		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+		for (uint32_t ii = 0, num = uint32_t(m_blocks.size() ); ii < num; ++ii)
 		{
-			result = vkCreateCommandPool(
-				  s_renderVK->m_device
-				, &cpci
-				, s_renderVK->m_allocatorCb
-				, &m_commandList[ii].m_commandPool
-				);
+			Block* block = m_blocks[ii];
 
-			if (VK_SUCCESS != result)
+			if (NULL != block)
 			{
-				BX_TRACE("Create command queue error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
-				return result;
-			}
-
-			cbai.commandPool = m_commandList[ii].m_commandPool;
-
-			result = vkAllocateCommandBuffers(
-				  s_renderVK->m_device
-				, &cbai
-				, &m_commandList[ii].m_commandBuffer
-				);
+				BX_WARN(0 == block->m_numAllocations
+					, "Leaked %d allocations in device memory block %d."
+					, block->m_numAllocations
+					, ii
+					);
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create command queue error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
-				return result;
+				vkFreeMemory(m_device, block->m_memory, m_allocatorCb);
+				bx::deleteObject(g_allocator, block);
 			}
+		}
 
-			result = vkCreateFence(
-				  s_renderVK->m_device
-				, &fci
-				, s_renderVK->m_allocatorCb
-				, &m_commandList[ii].m_fence
-				);
+		m_blocks.clear();
+	}
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create command queue error: vkCreateFence failed %d: %s.", result, getName(result) );
-				return result;
-			}
-		}
+	VkResult DeviceMemoryAllocatorVK::allocateMemory(VkDeviceSize _size, uint32_t _memoryTypeIndex, ::VkDeviceMemory* _memory)
+	{
+		BGFX_PROFILER_SCOPE("DeviceMemoryAllocatorVK::allocateMemory", kColorResource);
 
-		return result;
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = _size;
+		ma.memoryTypeIndex = _memoryTypeIndex;
+
+		return vkAllocateMemory(m_device, &ma, m_allocatorCb, _memory);
 	}
 
-	void CommandQueueVK::shutdown()
+	bool DeviceMemoryAllocatorVK::allocFromBlock(uint32_t _blockIdx, const VkMemoryRequirements& _requirements, DeviceMemoryAllocationVK* _allocation)
 	{
-		kick(true);
-		finish(true);
+		Block& block = *m_blocks[_blockIdx];
+		const VkDeviceSize align = bx::max<VkDeviceSize>(_requirements.alignment, 1);
 
-		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+		// NonLocalAllocator ranges are 16 bytes aligned, larger alignment is satisfied
+		// by allocating padding in front of resource.
+		const VkDeviceSize padding = align > 16 ? align - 16 : 0;
+
+		const uint64_t ptr = block.m_allocator.alloc(uint32_t(_requirements.size + padding) );
+		if (NonLocalAllocator::kInvalidBlock == ptr)
 		{
-			vkDestroy(m_commandList[ii].m_fence);
-			m_commandList[ii].m_commandBuffer = VK_NULL_HANDLE;
-			vkDestroy(m_commandList[ii].m_commandPool);
+			return false;
 		}
+
+		++block.m_numAllocations;
+
+		_allocation->m_memory      = block.m_memory;
+		_allocation->m_offset      = (ptr + align - 1) / align * align;
+		_allocation->m_size        = _requirements.size;
+		_allocation->m_blockOffset = ptr;
+		_allocation->m_block       = _blockIdx;
+
+		return true;
 	}
 
-	VkResult CommandQueueVK::alloc(VkCommandBuffer* _commandBuffer)
+	VkResult DeviceMemoryAllocatorVK::alloc(const VkMemoryRequirements& _requirements, uint32_t _memoryTypeIndex, bool _image, DeviceMemoryAllocationVK* _allocation)
 	{
-		BGFX_PROFILER_SCOPE("CommandQueueVK::alloc", kColorResource);
-		VkResult result = VK_SUCCESS;
+		BGFX_PROFILER_SCOPE("DeviceMemoryAllocatorVK::alloc", kColorResource);
 
-		if (m_activeCommandBuffer == VK_NULL_HANDLE)
+		if (_requirements.size > m_blockSize/2)
 		{
-			const VkDevice device = s_renderVK->m_device;
-			CommandList& commandList = m_commandList[m_currentFrameInFlight];
+			VkResult result = allocateMemory(_requirements.size, _memoryTypeIndex, &_allocation->m_memory);
+			if (VK_SUCCESS == result)
+			{
+				_allocation->m_offset      = 0;
+				_allocation->m_size        = _requirements.size;
+				_allocation->m_blockOffset = 0;
+				_allocation->m_block       = UINT32_MAX;
+
+				m_dedicatedSize += _requirements.size;
+				++m_numDedicated;
+			}
+
+			return result;
+		}
+
+		const uint32_t key = _memoryTypeIndex*2 + (_image ? 1 : 0);
+
+		uint32_t freeIdx = UINT32_MAX;
+		for (uint32_t ii = 0, num = uint32_t(m_blocks.size() ); ii < num; ++ii)
+		{
+			const Block* block = m_blocks[ii];
+
+			if (NULL == block)
+			{
+				freeIdx = ii;
+			}
+			else if (key == block->m_key
+			     &&  allocFromBlock(ii, _requirements, _allocation) )
+			{
+				return VK_SUCCESS;
+			}
+		}
+
+		::VkDeviceMemory memory;
+		VkResult result = allocateMemory(m_blockSize, _memoryTypeIndex, &memory);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Failed to allocate device memory block (type %d, size %d) %d: %s."
+				, _memoryTypeIndex
+				, uint32_t(m_blockSize)
+				, result
+				, getName(result)
+				);
+			dump();
+			return result;
+		}
+
+		Block* block = BX_NEW(g_allocator, Block);
+		block->m_memory         = memory;
+		block->m_size           = m_blockSize;
+		block->m_numAllocations = 0;
+		block->m_key            = key;
+		block->m_allocator.add(0, uint32_t(m_blockSize) );
+
+		if (UINT32_MAX == freeIdx)
+		{
+			freeIdx = uint32_t(m_blocks.size() );
+			m_blocks.push_back(block);
+		}
+		else
+		{
+			m_blocks[freeIdx] = block;
+		}
+
+		const bool allocated = allocFromBlock(freeIdx, _requirements, _allocation);
+		BX_ASSERT(allocated, "Resource must fit into empty device memory block.");
+		BX_UNUSED(allocated);
+
+		return VK_SUCCESS;
+	}
+
+	void DeviceMemoryAllocatorVK::free(const DeviceMemoryAllocationVK& _allocation)
+	{
+		if (UINT32_MAX == _allocation.m_block)
+		{
+			vkFreeMemory(m_device, _allocation.m_memory, m_allocatorCb);
+
+			m_dedicatedSize -= _allocation.m_size;
+			--m_numDedicated;
+			return;
+		}
+
+		Block& block = *m_blocks[_allocation.m_block];
+		BX_ASSERT(block.m_memory == _allocation.m_memory, "Allocation doesn't belong to device memory block.");
+
+		block.m_allocator.free(_allocation.m_blockOffset);
+		--block.m_numAllocations;
+
+		// Keep at least one empty block per memory type to avoid reallocating
+		// device memory when resources are recreated.
+		if (0 == block.m_numAllocations)
+		{
+			bool hasOther = false;
+			for (const Block* other : m_blocks)
+			{
+				hasOther |= NULL != other && other != &block && other->m_key == block.m_key;
+			}
+
+			if (hasOther)
+			{
+				vkFreeMemory(m_device, block.m_memory, m_allocatorCb);
+				bx::deleteObject(g_allocator, m_blocks[_allocation.m_block]);
+				m_blocks[_allocation.m_block] = NULL;
+			}
+		}
+	}
+
+	void DeviceMemoryAllocatorVK::getStats(Stats& _stats) const
+	{
+		_stats.allocated         = m_dedicatedSize;
+		_stats.blockFree         = 0;
+		_stats.blockLargestFree  = 0;
+		_stats.numAllocations    = m_numDedicated;
+		_stats.numSubAllocations = 0;
+
+		for (const Block* block : m_blocks)
+		{
+			if (NULL != block)
+			{
+				_stats.allocated         += block->m_size;
+				_stats.blockFree         += block->m_allocator.getFreeSize();
+				_stats.blockLargestFree   = bx::max<int64_t>(_stats.blockLargestFree, block->m_allocator.getLargestFree() );
+				_stats.numAllocations    += 1;
+				_stats.numSubAllocations += block->m_numAllocations;
+			}
+		}
+	}
+
+	void DeviceMemoryAllocatorVK::dump() const
+	{
+		BX_TRACE("Device memory blocks:");
+
+		for (uint32_t ii = 0, num = uint32_t(m_blocks.size() ); ii < num; ++ii)
+		{
+			const Block* block = m_blocks[ii];
+
+			if (NULL != block)
+			{
+				const NonLocalAllocator& allocator = block->m_allocator;
+
+				BX_TRACE("\t%3d: type %2d %s, used %10d / %10d, allocations %5d, largest free %10d"
+					, ii
+					, block->m_key/2
+					, 0 != (block->m_key&1) ? "image " : "buffer"
+					, uint32_t(allocator.getTotalSize() - allocator.getFreeSize() )
+					, uint32_t(block->m_size)
+					, block->m_numAllocations
+					, allocator.getLargestFree()
+					);
+			}
+		}
+
+		BX_TRACE("\tDedicated: %d allocations, %" PRId64 " bytes.", m_numDedicated, m_dedicatedSize);
+	}
+
+	DescriptorSetCacheVK::DescriptorSetCacheVK()
+		: m_device(VK_NULL_HANDLE)
+		, m_allocatorCb(NULL)
+		, m_maxSetsPerPool(0)
+		, m_currentPool(0)
+		, m_numSetsInPool(0)
+		, m_numAllocated(0)
+		, m_generation(0)
+	{
+	}
+
+	DescriptorSetCacheVK::~DescriptorSetCacheVK()
+	{
+		shutdown();
+	}
+
+	VkResult DescriptorSetCacheVK::init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, uint32_t _maxSetsPerPool)
+	{
+		m_device         = _device;
+		m_allocatorCb    = _allocatorCb;
+		m_maxSetsPerPool = _maxSetsPerPool;
+		m_currentPool    = 0;
+		m_numSetsInPool  = 0;
+		m_numAllocated   = 0;
+		m_generation     = 0;
+
+		::VkDescriptorPool pool;
+		VkResult result = createPool(&pool);
+
+		if (VK_SUCCESS == result)
+		{
+			m_pools.push_back(pool);
+		}
+
+		return result;
+	}
+
+	void DescriptorSetCacheVK::shutdown()
+	{
+		for (::VkDescriptorPool pool : m_pools)
+		{
+			vkDestroyDescriptorPool(m_device, pool, m_allocatorCb);
+		}
+
+		m_pools.clear();
+		m_descriptorSets.clear();
+	}
+
+	void DescriptorSetCacheVK::begin(uint32_t _generation)
+	{
+		if (m_generation  != _generation
+		||  m_currentPool != 0)
+		{
+			reset();
+			m_generation = _generation;
+		}
+
+		m_numAllocated = 0;
+	}
+
+	::VkDescriptorSet DescriptorSetCacheVK::find(const DescriptorSetKeyVK& _key) const
+	{
+		const uint32_t hash = bx::hash<bx::HashMurmur2A>(&_key, sizeof(_key) );
+
+		DescriptorSetHashMap::const_iterator it = m_descriptorSets.find(hash);
+		if (it != m_descriptorSets.end()
+		&&  0 == bx::memCmp(&it->second.m_key, &_key, sizeof(_key) ) )
+		{
+			return it->second.m_descriptorSet;
+		}
+
+		return VK_NULL_HANDLE;
+	}
+
+	VkResult DescriptorSetCacheVK::alloc(const DescriptorSetKeyVK& _key, ::VkDescriptorSet* _descriptorSet)
+	{
+		BGFX_PROFILER_SCOPE("DescriptorSetCacheVK::alloc", kColorResource);
+
+		if (m_numSetsInPool == m_maxSetsPerPool)
+		{
+			++m_currentPool;
+			m_numSetsInPool = 0;
+		}
+
+		if (m_currentPool == m_pools.size() )
+		{
+			::VkDescriptorPool pool;
+			VkResult result = createPool(&pool);
+
+			if (VK_SUCCESS != result)
+			{
+				return result;
+			}
+
+			m_pools.push_back(pool);
+		}
+
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext              = NULL;
+		dsai.descriptorPool     = m_pools[m_currentPool];
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &_key.m_layout;
+
+		VkResult result = vkAllocateDescriptorSets(m_device, &dsai, _descriptorSet);
+
+		if (VK_SUCCESS == result)
+		{
+			// On hash collision previous set is only dropped from cache, it stays
+			// allocated until pool is reset.
+			Entry& entry = m_descriptorSets[bx::hash<bx::HashMurmur2A>(&_key, sizeof(_key) )];
+			bx::memCopy(&entry.m_key, &_key, sizeof(_key) );
+			entry.m_descriptorSet = *_descriptorSet;
+			++m_numSetsInPool;
+			++m_numAllocated;
+		}
+
+		return result;
+	}
+
+	VkResult DescriptorSetCacheVK::createPool(::VkDescriptorPool* _pool)
+	{
+		BGFX_PROFILER_SCOPE("vkCreateDescriptorPool", kColorResource);
+
+		// Pool sizes cover the worst case for every set, so only the number of
+		// sets limits pool.
+		const VkDescriptorPoolSize dps[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          m_maxSetsPerPool * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,                m_maxSetsPerPool * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, m_maxSetsPerPool * 2                                },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         m_maxSetsPerPool * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          m_maxSetsPerPool * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+		};
+
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = 0;
+		dpci.maxSets       = m_maxSetsPerPool;
+		dpci.poolSizeCount = BX_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
+
+		return vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, _pool);
+	}
+
+	void DescriptorSetCacheVK::reset()
+	{
+		BGFX_PROFILER_SCOPE("DescriptorSetCacheVK::reset", kColorResource);
+
+		for (::VkDescriptorPool pool : m_pools)
+		{
+			vkResetDescriptorPool(m_device, pool, 0);
+		}
+
+		m_descriptorSets.clear();
+		m_currentPool   = 0;
+		m_numSetsInPool = 0;
+	}
+
+	void DrawEncoderVK::begin(VkCommandBuffer _commandBuffer, const VkRect2D& _scissor)
+	{
+		m_commandBuffer    = _commandBuffer;
+		m_pipeline         = VK_NULL_HANDLE;
+		m_pipelineLayout   = VK_NULL_HANDLE;
+		m_descriptorSet    = VK_NULL_HANDLE;
+		m_numOffsets       = 0;
+		m_numVertexBuffers = 0;
+		m_indexBuffer      = VK_NULL_HANDLE;
+		m_indexFormat      = VK_INDEX_TYPE_MAX_ENUM;
+		m_scissor          = _scissor;
+		m_stencilRef       = UINT32_MAX;
+		m_blendFactor      = UINT64_MAX;
+	}
+
+	void DrawEncoderVK::encode(const DrawCommandVK& _cmd)
+	{
+		if (m_pipeline != _cmd.m_pipeline)
+		{
+			m_pipeline = _cmd.m_pipeline;
+			vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _cmd.m_pipeline);
+		}
+
+		if (VK_NULL_HANDLE != _cmd.m_descriptorSet
+		&& (m_descriptorSet  != _cmd.m_descriptorSet
+		||  m_pipelineLayout != _cmd.m_pipelineLayout
+		||  m_numOffsets     != _cmd.m_numOffsets
+		||  0 != bx::memCmp(m_offsets, _cmd.m_offsets, _cmd.m_numOffsets*sizeof(uint32_t) ) ) )
+		{
+			m_descriptorSet  = _cmd.m_descriptorSet;
+			m_pipelineLayout = _cmd.m_pipelineLayout;
+			m_numOffsets     = _cmd.m_numOffsets;
+			bx::memCopy(m_offsets, _cmd.m_offsets, sizeof(m_offsets) );
+
+			vkCmdBindDescriptorSets(
+				  m_commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, _cmd.m_pipelineLayout
+				, 0
+				, 1
+				, &_cmd.m_descriptorSet
+				, _cmd.m_numOffsets
+				, _cmd.m_offsets
+				);
+		}
+
+		if (0 < _cmd.m_numVertexBuffers
+		&& (m_numVertexBuffers != _cmd.m_numVertexBuffers
+		||  0 != bx::memCmp(m_vertexBuffers, _cmd.m_vertexBuffers, _cmd.m_numVertexBuffers*sizeof(::VkBuffer) )
+		||  0 != bx::memCmp(m_vertexOffsets, _cmd.m_vertexOffsets, _cmd.m_numVertexBuffers*sizeof(VkDeviceSize) ) ) )
+		{
+			m_numVertexBuffers = _cmd.m_numVertexBuffers;
+			bx::memCopy(m_vertexBuffers, _cmd.m_vertexBuffers, _cmd.m_numVertexBuffers*sizeof(::VkBuffer) );
+			bx::memCopy(m_vertexOffsets, _cmd.m_vertexOffsets, _cmd.m_numVertexBuffers*sizeof(VkDeviceSize) );
+
+			vkCmdBindVertexBuffers(
+				  m_commandBuffer
+				, 0
+				, _cmd.m_numVertexBuffers
+				, _cmd.m_vertexBuffers
+				, _cmd.m_vertexOffsets
+				);
+		}
+
+		if (VK_NULL_HANDLE != _cmd.m_indexBuffer
+		&& (m_indexBuffer != _cmd.m_indexBuffer
+		||  m_indexFormat != _cmd.m_indexFormat) )
+		{
+			m_indexBuffer = _cmd.m_indexBuffer;
+			m_indexFormat = _cmd.m_indexFormat;
+			vkCmdBindIndexBuffer(m_commandBuffer, _cmd.m_indexBuffer, 0, _cmd.m_indexFormat);
+		}
+
+		if (0 != bx::memCmp(&m_scissor, &_cmd.m_scissor, sizeof(VkRect2D) ) )
+		{
+			m_scissor = _cmd.m_scissor;
+			vkCmdSetScissor(m_commandBuffer, 0, 1, &_cmd.m_scissor);
+		}
+
+		if (UINT32_MAX != _cmd.m_stencilRef
+		&&  m_stencilRef != _cmd.m_stencilRef)
+		{
+			m_stencilRef = _cmd.m_stencilRef;
+			vkCmdSetStencilReference(m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, _cmd.m_stencilRef);
+		}
+
+		if (UINT64_MAX != _cmd.m_blendFactor
+		&&  m_blendFactor != _cmd.m_blendFactor)
+		{
+			m_blendFactor = _cmd.m_blendFactor;
+
+			const uint32_t rgba = uint32_t(_cmd.m_blendFactor);
+
+			float bf[4];
+			bf[0] = ( (rgba>>24)     )/255.0f;
+			bf[1] = ( (rgba>>16)&0xff)/255.0f;
+			bf[2] = ( (rgba>> 8)&0xff)/255.0f;
+			bf[3] = ( (rgba    )&0xff)/255.0f;
+			vkCmdSetBlendConstants(m_commandBuffer, bf);
+		}
+
+		if (VK_NULL_HANDLE == _cmd.m_indexBuffer)
+		{
+			if (VK_NULL_HANDLE != _cmd.m_indirectBuffer)
+			{
+				if (VK_NULL_HANDLE != _cmd.m_numIndirectBuffer)
+				{
+					vkCmdDrawIndirectCountKHR(
+						  m_commandBuffer
+						, _cmd.m_indirectBuffer
+						, _cmd.m_indirectOffset
+						, _cmd.m_numIndirectBuffer
+						, _cmd.m_numIndirectOffset
+						, _cmd.m_numIndirect
+						, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+						);
+				}
+				else
+				{
+					vkCmdDrawIndirect(
+						  m_commandBuffer
+						, _cmd.m_indirectBuffer
+						, _cmd.m_indirectOffset
+						, _cmd.m_numIndirect
+						, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+						);
+				}
+			}
+			else
+			{
+				vkCmdDraw(
+					  m_commandBuffer
+					, _cmd.m_num
+					, _cmd.m_numInstances
+					, 0
+					, 0
+					);
+			}
+		}
+		else
+		{
+			if (VK_NULL_HANDLE != _cmd.m_indirectBuffer)
+			{
+				if (VK_NULL_HANDLE != _cmd.m_numIndirectBuffer)
+				{
+					vkCmdDrawIndexedIndirectCountKHR(
+						  m_commandBuffer
+						, _cmd.m_indirectBuffer
+						, _cmd.m_indirectOffset
+						, _cmd.m_numIndirectBuffer
+						, _cmd.m_numIndirectOffset
+						, _cmd.m_numIndirect
+						, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+						);
+				}
+				else
+				{
+					vkCmdDrawIndexedIndirect(
+						  m_commandBuffer
+						, _cmd.m_indirectBuffer
+						, _cmd.m_indirectOffset
+						, _cmd.m_numIndirect
+						, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+						);
+				}
+			}
+			else
+			{
+				vkCmdDrawIndexed(
+					  m_commandBuffer
+					, _cmd.m_num
+					, _cmd.m_numInstances
+					, _cmd.m_startIndex
+					, 0
+					, 0
+					);
+			}
+		}
+	}
+
+	DrawRecorderVK::DrawRecorderVK()
+		: m_device(VK_NULL_HANDLE)
+		, m_allocatorCb(NULL)
+		, m_numFramesInFlight(0)
+		, m_frameInFlight(0)
+		, m_inheritanceInfo(NULL)
+		, m_viewport(NULL)
+		, m_scissor(NULL)
+		, m_cmds(NULL)
+		, m_numCmds(0)
+		, m_commandBuffers(NULL)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_FRAME_LATENCY; ++ii)
+		{
+			for (uint32_t jj = 0; jj < kMaxTasks; ++jj)
+			{
+				m_pool[ii][jj].m_commandPool = VK_NULL_HANDLE;
+				m_pool[ii][jj].m_numUsed     = 0;
+			}
+		}
+	}
+
+	DrawRecorderVK::~DrawRecorderVK()
+	{
+		shutdown();
+	}
+
+	VkResult DrawRecorderVK::init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, uint32_t _queueFamily, uint32_t _numFramesInFlight, uint32_t _numThreads)
+	{
+		m_device            = _device;
+		m_allocatorCb       = _allocatorCb;
+		m_numFramesInFlight = _numFramesInFlight;
+		m_frameInFlight     = 0;
+
+		m_workerPool.init(_numThreads, "bgfx - vk record");
+
+		if (!isEnabled() )
+		{
+			return VK_SUCCESS;
+		}
+
+		VkCommandPoolCreateInfo cpci;
+		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cpci.pNext = NULL;
+		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		cpci.queueFamilyIndex = _queueFamily;
+
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+		{
+			for (uint32_t jj = 0, num = m_workerPool.getNumThreads(); jj < num; ++jj)
+			{
+				VkResult result = vkCreateCommandPool(m_device, &cpci, m_allocatorCb, &m_pool[ii][jj].m_commandPool);
+
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Create draw recorder error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
+					return result;
+				}
+			}
+		}
+
+		BX_TRACE("Recording draw calls with %d threads.", m_workerPool.getNumThreads() );
+
+		return VK_SUCCESS;
+	}
+
+	void DrawRecorderVK::shutdown()
+	{
+		m_workerPool.shutdown();
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_FRAME_LATENCY; ++ii)
+		{
+			for (uint32_t jj = 0; jj < kMaxTasks; ++jj)
+			{
+				CommandPool& pool = m_pool[ii][jj];
+
+				if (VK_NULL_HANDLE != pool.m_commandPool)
+				{
+					vkDestroyCommandPool(m_device, pool.m_commandPool, m_allocatorCb);
+					pool.m_commandPool = VK_NULL_HANDLE;
+				}
+
+				pool.m_commandBuffers.clear();
+				pool.m_numUsed = 0;
+			}
+		}
+	}
+
+	void DrawRecorderVK::begin(uint32_t _frameInFlight)
+	{
+		m_frameInFlight = _frameInFlight;
+
+		for (uint32_t jj = 0; jj < kMaxTasks; ++jj)
+		{
+			CommandPool& pool = m_pool[_frameInFlight][jj];
+
+			if (0 < pool.m_numUsed)
+			{
+				VK_CHECK(vkResetCommandPool(m_device, pool.m_commandPool, 0) );
+				pool.m_numUsed = 0;
+			}
+		}
+	}
+
+	uint32_t DrawRecorderVK::record(
+		  const VkCommandBufferInheritanceInfo& _inheritanceInfo
+		, const VkViewport& _viewport
+		, const VkRect2D& _scissor
+		, const DrawCommandVK* _cmds
+		, uint32_t _num
+		, ::VkCommandBuffer* _commandBuffers
+		)
+	{
+		BGFX_PROFILER_SCOPE("DrawRecorderVK::record", kColorDraw);
+
+		if (0 == _num)
+		{
+			return 0;
+		}
+
+		m_inheritanceInfo = &_inheritanceInfo;
+		m_viewport        = &_viewport;
+		m_scissor         = &_scissor;
+		m_cmds            = _cmds;
+		m_numCmds         = _num;
+		m_commandBuffers  = _commandBuffers;
+
+		const uint32_t numTasks = bx::clamp<uint32_t>(
+			  (_num + kMinDrawsPerTask - 1) / kMinDrawsPerTask
+			, 1
+			, m_workerPool.getNumThreads()
+			);
+
+		m_workerPool.run(recordTask, this, numTasks);
+
+		return numTasks;
+	}
+
+	void DrawRecorderVK::recordTask(void* _userData, uint32_t _idx, uint32_t _num)
+	{
+		BGFX_PROFILER_SCOPE("DrawRecorderVK::recordTask", kColorDraw);
+
+		DrawRecorderVK& recorder = *(DrawRecorderVK*)_userData;
+		CommandPool& pool = recorder.m_pool[recorder.m_frameInFlight][_idx];
+
+		if (pool.m_numUsed == pool.m_commandBuffers.size() )
+		{
+			VkCommandBufferAllocateInfo cbai;
+			cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cbai.pNext = NULL;
+			cbai.commandPool        = pool.m_commandPool;
+			cbai.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			cbai.commandBufferCount = 1;
+
+			::VkCommandBuffer commandBuffer;
+			VK_CHECK(vkAllocateCommandBuffers(recorder.m_device, &cbai, &commandBuffer) );
+			pool.m_commandBuffers.push_back(commandBuffer);
+		}
+
+		const VkCommandBuffer commandBuffer = pool.m_commandBuffers[pool.m_numUsed++];
+
+		VkCommandBufferBeginInfo cbbi;
+		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cbbi.pNext = NULL;
+		cbbi.flags = 0
+			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+			| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+			;
+		cbbi.pInheritanceInfo = recorder.m_inheritanceInfo;
+
+		VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
+
+		// Dynamic state is not inherited from primary command buffer.
+		vkCmdSetViewport(commandBuffer, 0, 1, recorder.m_viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, recorder.m_scissor);
+
+		DrawEncoderVK encoder;
+		encoder.begin(commandBuffer, *recorder.m_scissor);
+
+		const uint32_t begin = uint32_t(uint64_t(recorder.m_numCmds) *  _idx    / _num);
+		const uint32_t end   = uint32_t(uint64_t(recorder.m_numCmds) * (_idx+1) / _num);
+
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			encoder.encode(recorder.m_cmds[ii]);
+		}
+
+		VK_CHECK(vkEndCommandBuffer(commandBuffer) );
+
+		recorder.m_commandBuffers[_idx] = commandBuffer;
+	}
+
+	PipelineCompilerVK::PipelineCompilerVK()
+		: m_device(VK_NULL_HANDLE)
+		, m_cache(VK_NULL_HANDLE)
+		, m_allocatorCb(NULL)
+		, m_queueHead(NULL)
+		, m_queueTail(NULL)
+		, m_done(NULL)
+		, m_numThreads(0)
+		, m_numPending(0)
+		, m_exit(false)
+	{
+	}
+
+	PipelineCompilerVK::~PipelineCompilerVK()
+	{
+		shutdown();
+	}
+
+	void PipelineCompilerVK::init(VkDevice _device, VkPipelineCache _cache, const VkAllocationCallbacks* _allocatorCb, uint32_t _numThreads)
+	{
+		m_device      = _device;
+		m_cache       = _cache;
+		m_allocatorCb = _allocatorCb;
+		m_exit        = false;
+		m_numThreads  = bx::min<uint32_t>(_numThreads, BX_COUNTOF(m_thread) );
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			char name[64];
+			bx::snprintf(name, BX_COUNTOF(name), "bgfx - vk pipeline %d", ii);
+			m_thread[ii].init(threadFunc, this, 0, name);
+		}
+	}
+
+	void PipelineCompilerVK::shutdown()
+	{
+		BX_ASSERT(0 == m_numPending, "All pending pipelines must be collected before shutdown.");
+
+		if (0 < m_numThreads)
+		{
+			{
+				bx::MutexScope lock(m_mutex);
+				m_exit = true;
+			}
+
+			m_queued.post(m_numThreads);
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+
+			m_numThreads = 0;
+		}
+	}
+
+	void PipelineCompilerVK::compile(PipelineCreateInfoVK* _pci)
+	{
+		_pci->m_result = vkCreateGraphicsPipelines(
+			  m_device
+			, m_cache
+			, 1
+			, &_pci->m_info
+			, m_allocatorCb
+			, &_pci->m_pipeline
+			);
+	}
+
+	void PipelineCompilerVK::push(PipelineCreateInfoVK* _pci)
+	{
+		BX_ASSERT(0 < m_numThreads, "Pipeline compiler doesn't have worker threads.");
+
+		_pci->m_next = NULL;
+
+		{
+			bx::MutexScope lock(m_mutex);
+
+			if (NULL == m_queueTail)
+			{
+				m_queueHead = _pci;
+			}
+			else
+			{
+				m_queueTail->m_next = _pci;
+			}
+
+			m_queueTail = _pci;
+		}
+
+		++m_numPending;
+		m_queued.post();
+	}
+
+	PipelineCreateInfoVK* PipelineCompilerVK::pop(bool _wait)
+	{
+		while (0 != m_numPending)
+		{
+			{
+				bx::MutexScope lock(m_mutex);
+
+				PipelineCreateInfoVK* pci = m_done;
+				if (NULL != pci)
+				{
+					m_done = pci->m_next;
+					--m_numPending;
+					return pci;
+				}
+			}
+
+			if (!_wait)
+			{
+				break;
+			}
+
+			m_compiled.wait();
+		}
+
+		return NULL;
+	}
+
+	int32_t PipelineCompilerVK::threadFunc(bx::Thread* /*_thread*/, void* _userData)
+	{
+		PipelineCompilerVK* compiler = (PipelineCompilerVK*)_userData;
+
+		for (;;)
+		{
+			compiler->m_queued.wait();
+
+			PipelineCreateInfoVK* pci;
+
+			{
+				bx::MutexScope lock(compiler->m_mutex);
+
+				if (compiler->m_exit)
+				{
+					break;
+				}
+
+				pci = compiler->m_queueHead;
+				compiler->m_queueHead = pci->m_next;
+
+				if (NULL == compiler->m_queueHead)
+				{
+					compiler->m_queueTail = NULL;
+				}
+			}
+
+			compiler->compile(pci);
+
+			{
+				bx::MutexScope lock(compiler->m_mutex);
+				pci->m_next = compiler->m_done;
+				compiler->m_done = pci;
+			}
+
+			compiler->m_compiled.post();
+		}
+
+		return 0;
+	}
+
+	VkResult CommandQueueVK::init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight)
+	{
+		m_queueFamily = _queueFamily;
+		m_queue = _queue;
+		m_numFramesInFlight = bx::clamp<uint32_t>(_numFramesInFlight, 1, BGFX_CONFIG_MAX_FRAME_LATENCY);
+		m_activeCommandBuffer = VK_NULL_HANDLE;
+		m_consumeIndex = 0;
+
+		return reset();
+	}
+
+	VkResult CommandQueueVK::reset()
+	{
+		shutdown();
+
+		m_currentFrameInFlight = 0;
+		m_consumeIndex         = 0;
+
+		m_numSignalSemaphores = 0;
+		m_numWaitSemaphores   = 0;
+
+		m_activeCommandBuffer = VK_NULL_HANDLE;
+		m_currentFence        = VK_NULL_HANDLE;
+		m_completedFence      = VK_NULL_HANDLE;
+
+		m_submitted = 0;
+
+		VkCommandPoolCreateInfo cpci;
+		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cpci.pNext = NULL;
+		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		cpci.queueFamilyIndex = m_queueFamily;
+
+		VkCommandBufferAllocateInfo cbai;
+		cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		cbai.pNext = NULL;
+		cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cbai.commandBufferCount = 1;
+
+		VkFenceCreateInfo fci;
+		fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fci.pNext = NULL;
+		fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		VkResult result = VK_SUCCESS;
+
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+		{
+			result = vkCreateCommandPool(
+				  s_renderVK->m_device
+				, &cpci
+				, s_renderVK->m_allocatorCb
+				, &m_commandList[ii].m_commandPool
+				);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create command queue error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			cbai.commandPool = m_commandList[ii].m_commandPool;
+
+			result = vkAllocateCommandBuffers(
+				  s_renderVK->m_device
+				, &cbai
+				, &m_commandList[ii].m_commandBuffer
+				);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create command queue error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			result = vkCreateFence(
+				  s_renderVK->m_device
+				, &fci
+				, s_renderVK->m_allocatorCb
+				, &m_commandList[ii].m_fence
+				);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create command queue error: vkCreateFence failed %d: %s.", result, getName(result) );
+				return result;
+			}
+		}
+
+		return result;
+	}
+
+	void CommandQueueVK::shutdown()
+	{
+		kick(true);
+		finish(true);
+
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+		{
+			vkDestroy(m_commandList[ii].m_fence);
+			m_commandList[ii].m_commandBuffer = VK_NULL_HANDLE;
+			vkDestroy(m_commandList[ii].m_commandPool);
+		}
+	}
+
+	VkResult CommandQueueVK::alloc(VkCommandBuffer* _commandBuffer)
+	{
+		BGFX_PROFILER_SCOPE("CommandQueueVK::alloc", kColorResource);
+		VkResult result = VK_SUCCESS;
+
+		if (m_activeCommandBuffer == VK_NULL_HANDLE)
+		{
+			const VkDevice device = s_renderVK->m_device;
+			CommandList& commandList = m_commandList[m_currentFrameInFlight];
 
 			{
 				BGFX_PROFILER_SCOPE("vkWaitForFences", kColorFrame);
@@ -8186,11 +9351,23 @@ VK_DESTROY
 		m_release[m_currentFrameInFlight].push_back(resource);
 	}
 
+	void CommandQueueVK::release(const DeviceMemoryAllocationVK& _allocation)
+	{
+		m_releaseMemory[m_currentFrameInFlight].push_back(_allocation);
+	}
+
 	void CommandQueueVK::consume()
 	{
 		BGFX_PROFILER_SCOPE("CommandQueueVK::consume", kColorResource);
 		m_consumeIndex = (m_consumeIndex + 1) % m_numFramesInFlight;
 
+		for (const DeviceMemoryAllocationVK& allocation : m_releaseMemory[m_consumeIndex])
+		{
+			s_renderVK->m_memoryAllocator.free(allocation);
+		}
+
+		m_releaseMemory[m_consumeIndex].clear();
+
 		for (const Resource& resource : m_release[m_consumeIndex])
 		{
 			switch (resource.m_type)
@@ -8201,7 +9378,6 @@ VK_DESTROY
 			case VK_OBJECT_TYPE_FRAMEBUFFER:           destroy<VkFramebuffer        >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_PIPELINE_LAYOUT:       destroy<VkPipelineLayout     >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_PIPELINE:              destroy<VkPipeline           >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_DESCRIPTOR_SET:        destroy<VkDescriptorSet      >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: destroy<VkDescriptorSetLayout>(resource.m_handle); break;
 			case VK_OBJECT_TYPE_RENDER_PASS:           destroy<VkRenderPass         >(resource.m_handle); break;
 			case VK_OBJECT_TYPE_SAMPLER:               destroy<VkSampler            >(resource.m_handle); break;
@@ -8354,6 +9530,17 @@ VK_DESTROY
 
 		BGFX_VK_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
 
+		updatePipelines(false);
+
+		// Pipeline cache is written periodically, so that it's not lost if
+		// application doesn't shut down cleanly. Pipeline cache is internally
+		// synchronized, compile threads don't need to be stopped.
+		if (0 < BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_COUNT
+		&&  BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_CACHE_SAVE_COUNT <= m_numPipelinesUnsaved)
+		{
+			savePipelineCache();
+		}
+
 		int64_t timeBegin = bx::getHPCounter();
 		int64_t captureElapsed = 0;
 
@@ -8385,6 +9572,10 @@ VK_DESTROY
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
+		RenderBind renderBind;
+		renderBind.clear();
+		RenderBindRef renderBindRef = { UINT32_MAX, 0 };
+
 		static ViewState viewState;
 		viewState.reset(_render);
 
@@ -8397,21 +9588,27 @@ VK_DESTROY
 		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
 		uint32_t currentBindHash = 0;
 		uint32_t descriptorSetCount = 0;
-		VkIndexType currentIndexFormat = VK_INDEX_TYPE_MAX_ENUM;
+		uint32_t currentNumOffsets = 0;
+		uint32_t currentOffsets[2] = { 0, 0 };
+		VkRect2D currentScissor = {};
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
 
-		uint64_t blendFactor = UINT64_MAX;
-
-		bool wasCompute     = false;
-		bool viewHasScissor = false;
-		bool restoreScissor = false;
+		bool wasCompute = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
 
+		VkViewport viewport = {};
+		VkRect2D viewScissor = {};
+
+		DrawEncoderVK drawEncoder;
+		bool recordView = false;
+		uint32_t numRecordedViews = 0;
+		uint32_t numRecordedCommandBuffers = 0;
+
 		bool isFrameBufferValid = false;
 
 		uint32_t statsNumPrimsSubmitted[BX_COUNTOF(s_primInfo)] = {};
@@ -8431,6 +9628,19 @@ VK_DESTROY
 		ScratchBufferVK& scratchStagingBuffer = m_scratchStagingBuffer[m_cmd.m_currentFrameInFlight];
 		scratchStagingBuffer.reset();
 
+		const uint32_t colorPaletteHash = bx::hash<bx::HashMurmur2A>(_render->m_colorPalette, sizeof(_render->m_colorPalette) );
+		if (m_colorPaletteHash != colorPaletteHash)
+		{
+			// Border color samplers are created from palette.
+			m_colorPaletteHash = colorPaletteHash;
+			invalidateDescriptorSets();
+		}
+
+		DescriptorSetCacheVK& descriptorSetCache = m_descriptorSetCache[m_cmd.m_currentFrameInFlight];
+		descriptorSetCache.begin(m_descriptorSetGeneration);
+
+		m_drawRecorder.begin(m_cmd.m_currentFrameInFlight);
+
 		setMemoryBarrier(
 			  m_commandBuffer
 			, VK_PIPELINE_STAGE_TRANSFER_BIT
@@ -8472,17 +9682,31 @@ VK_DESTROY
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				_render->updateRenderBind(itemIdx, renderBindRef, renderBind);
 				++item;
 
 				if (viewChanged)
 				{
 					if (beginRenderPass)
 					{
-						vkCmdEndRenderPass(m_commandBuffer);
+						if (recordView)
+						{
+							numRecordedCommandBuffers += executeDrawCommands(rpbi, viewport, viewScissor);
+							++numRecordedViews;
+
+							// Executing secondary command buffers leaves bound state undefined.
+							currentPipeline = VK_NULL_HANDLE;
+						}
+						else
+						{
+							vkCmdEndRenderPass(m_commandBuffer);
+						}
+
 						beginRenderPass = false;
 					}
 
+					recordView = false;
+
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 					hasPredefined  = false;
@@ -8516,9 +9740,7 @@ VK_DESTROY
 						viewState.m_rect = _render->m_view[view].m_rect;
 						const Rect& rect        = _render->m_view[view].m_rect;
 						const Rect& scissorRect = _render->m_view[view].m_scissor;
-						viewHasScissor  = !scissorRect.isZero();
-						viewScissorRect = viewHasScissor ? scissorRect : rect;
-						restoreScissor = false;
+						viewScissorRect = scissorRect.isZero() ? rect : scissorRect;
 
 						rpbi.framebuffer = fb.m_currentFramebuffer;
 						rpbi.renderPass  = fb.m_renderPass;
@@ -8527,21 +9749,19 @@ VK_DESTROY
 						rpbi.renderArea.extent.width  = rect.m_width;
 						rpbi.renderArea.extent.height = rect.m_height;
 
-						VkViewport vp;
-						vp.x        =  float(rect.m_x);
-						vp.y        =  float(rect.m_y + rect.m_height);
-						vp.width    =  float(rect.m_width);
-						vp.height   = -float(rect.m_height);
-						vp.minDepth = 0.0f;
-						vp.maxDepth = 1.0f;
-						vkCmdSetViewport(m_commandBuffer, 0, 1, &vp);
-
-						VkRect2D rc;
-						rc.offset.x      = viewScissorRect.m_x;
-						rc.offset.y      = viewScissorRect.m_y;
-						rc.extent.width  = viewScissorRect.m_width;
-						rc.extent.height = viewScissorRect.m_height;
-						vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
+						viewport.x        =  float(rect.m_x);
+						viewport.y        =  float(rect.m_y + rect.m_height);
+						viewport.width    =  float(rect.m_width);
+						viewport.height   = -float(rect.m_height);
+						viewport.minDepth = 0.0f;
+						viewport.maxDepth = 1.0f;
+						vkCmdSetViewport(m_commandBuffer, 0, 1, &viewport);
+
+						viewScissor.offset.x      = viewScissorRect.m_x;
+						viewScissor.offset.y      = viewScissorRect.m_y;
+						viewScissor.extent.width  = viewScissorRect.m_width;
+						viewScissor.extent.height = viewScissorRect.m_height;
+						vkCmdSetScissor(m_commandBuffer, 0, 1, &viewScissor);
 
 						const Clear& clr = _render->m_view[view].m_clear;
 						if (BGFX_CLEAR_NONE != clr.m_flags)
@@ -8556,6 +9776,37 @@ VK_DESTROY
 						}
 
 						submitBlit(bs, view);
+
+						if (m_drawRecorder.isEnabled() )
+						{
+							// Occlusion queries are begun on primary command buffer,
+							// views using them are recorded on render thread.
+							uint32_t numViewDraws = 0;
+							bool viewHasOcclusionQuery = false;
+
+							for (int32_t ii = item-1; ii < numItems; ++ii)
+							{
+								SortKey viewKey;
+								const bool isViewCompute = viewKey.decode(_render->m_sortKeys[ii], _render->m_viewRemap);
+
+								if (viewKey.m_view != view)
+								{
+									break;
+								}
+
+								if (!isViewCompute)
+								{
+									const RenderDraw& viewDraw = _render->m_renderItem[_render->m_sortValues[ii] ].draw;
+									viewHasOcclusionQuery |= 0 != (viewDraw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
+									++numViewDraws;
+								}
+							}
+
+							recordView = true
+								&& !viewHasOcclusionQuery
+								&& BGFX_CONFIG_RENDERER_VULKAN_RECORD_MIN_DRAWS <= numViewDraws
+								;
+						}
 					}
 				}
 
@@ -8728,7 +9979,16 @@ VK_DESTROY
 					setViewType(view, " ");
 					BGFX_VK_PROFILER_BEGIN(view, kColorDraw);
 
-					vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+					if (recordView)
+					{
+						m_drawCommands.clear();
+					}
+					else
+					{
+						vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+						drawEncoder.begin(m_commandBuffer, viewScissor);
+					}
+
 					beginRenderPass = true;
 
 					currentProgram = BGFX_INVALID_HANDLE;
@@ -8737,16 +9997,14 @@ VK_DESTROY
 
 				if (0 != draw.m_streamMask)
 				{
-					const bool bindAttribs = hasVertexStreamChanged(currentState, draw);
-
 					currentState.m_streamMask         = draw.m_streamMask;
 					currentState.m_instanceDataBuffer = draw.m_instanceDataBuffer;
 					currentState.m_instanceDataOffset = draw.m_instanceDataOffset;
 					currentState.m_instanceDataStride = draw.m_instanceDataStride;
 
+					DrawCommandVK cmd;
+
 					const VertexLayout* layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
-					VkBuffer streamBuffers[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
-					VkDeviceSize streamOffsets[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
 					uint8_t numStreams = 0;
 					uint32_t numVertices = draw.m_numVertices;
 					if (UINT8_MAX != draw.m_streamMask)
@@ -8771,9 +10029,9 @@ VK_DESTROY
 							const VertexLayout& layout = m_vertexLayouts[decl];
 							const uint32_t stride = layout.m_stride;
 
-							streamBuffers[numStreams] = m_vertexBuffers[handle.idx].m_buffer;
-							streamOffsets[numStreams] = draw.m_stream[idx].m_startVertex * stride;
-							layouts[numStreams]       = &layout;
+							cmd.m_vertexBuffers[numStreams] = m_vertexBuffers[handle.idx].m_buffer;
+							cmd.m_vertexOffsets[numStreams] = draw.m_stream[idx].m_startVertex * stride;
+							layouts[numStreams]             = &layout;
 
 							numVertices = bx::uint32_min(UINT32_MAX == draw.m_numVertices
 								? vb.m_size/stride
@@ -8783,27 +10041,13 @@ VK_DESTROY
 						}
 					}
 
-					if (bindAttribs)
-					{
-						uint32_t numVertexBuffers = numStreams;
-
-						if (isValid(draw.m_instanceDataBuffer) )
-						{
-							streamOffsets[numVertexBuffers] = draw.m_instanceDataOffset;
-							streamBuffers[numVertexBuffers] = m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_buffer;
-							numVertexBuffers++;
-						}
+					cmd.m_numVertexBuffers = numStreams;
 
-						if (0 < numVertexBuffers)
-						{
-							vkCmdBindVertexBuffers(
-								  m_commandBuffer
-								, 0
-								, numVertexBuffers
-								, &streamBuffers[0]
-								, streamOffsets
-								);
-						}
+					if (isValid(draw.m_instanceDataBuffer) )
+					{
+						cmd.m_vertexOffsets[cmd.m_numVertexBuffers] = draw.m_instanceDataOffset;
+						cmd.m_vertexBuffers[cmd.m_numVertexBuffers] = m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_buffer;
+						cmd.m_numVertexBuffers++;
 					}
 
 					const VkPipeline pipeline =
@@ -8813,24 +10057,28 @@ VK_DESTROY
 							, layouts
 							, key.m_program
 							, uint8_t(draw.m_instanceDataStride/16)
+							, true
 							);
 
-					if (currentPipeline != pipeline)
+					if (VK_NULL_HANDLE == pipeline)
 					{
-						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+						// Pipeline is still being compiled, skip draw call. Force
+						// uniform commit for next draw call since uniforms of this
+						// draw call were already applied.
+						currentProgram = BGFX_INVALID_HANDLE;
+						continue;
 					}
 
-					const bool hasStencil = 0 != draw.m_stencil;
+					cmd.m_pipeline = pipeline;
 
-					if (hasStencil
-					&&  currentState.m_stencil != draw.m_stencil)
+					if (0 != draw.m_stencil)
 					{
-						currentState.m_stencil = draw.m_stencil;
-
 						const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
-						const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
-						vkCmdSetStencilReference(m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
+						cmd.m_stencilRef = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
+					}
+					else
+					{
+						cmd.m_stencilRef = UINT32_MAX;
 					}
 
 					const bool hasFactor = 0
@@ -8840,18 +10088,7 @@ VK_DESTROY
 						|| f3 == (draw.m_stateFlags & f3)
 						;
 
-					if (hasFactor
-					&&  blendFactor != draw.m_rgba)
-					{
-						blendFactor = draw.m_rgba;
-
-						float bf[4];
-						bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
-						bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
-						bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
-						bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
-						vkCmdSetBlendConstants(m_commandBuffer, bf);
-					}
+					cmd.m_blendFactor = hasFactor ? draw.m_rgba : UINT64_MAX;
 
 					const uint16_t scissor = draw.m_scissor;
 
@@ -8859,35 +10096,21 @@ VK_DESTROY
 					{
 						currentState.m_scissor = scissor;
 
-						if (UINT16_MAX == scissor)
-						{
-							if (restoreScissor
-							||  viewHasScissor)
-							{
-								restoreScissor = false;
-								VkRect2D rc;
-								rc.offset.x      = viewScissorRect.m_x;
-								rc.offset.y      = viewScissorRect.m_y;
-								rc.extent.width  = viewScissorRect.m_width;
-								rc.extent.height = viewScissorRect.m_height;
-								vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
-							}
-						}
-						else
+						Rect scissorRect = viewScissorRect;
+
+						if (UINT16_MAX != scissor)
 						{
-							restoreScissor = true;
-							Rect scissorRect;
 							scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
-
-							VkRect2D rc;
-							rc.offset.x      = scissorRect.m_x;
-							rc.offset.y      = scissorRect.m_y;
-							rc.extent.width  = scissorRect.m_width;
-							rc.extent.height = scissorRect.m_height;
-							vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
 						}
+
+						currentScissor.offset.x      = scissorRect.m_x;
+						currentScissor.offset.y      = scissorRect.m_y;
+						currentScissor.extent.width  = scissorRect.m_width;
+						currentScissor.extent.height = scissorRect.m_height;
 					}
 
+					cmd.m_scissor = currentScissor;
+
 					bool constantsChanged = false;
 					if (draw.m_uniformBegin < draw.m_uniformEnd
 					||  currentProgram.idx != key.m_program.idx
@@ -8924,24 +10147,28 @@ VK_DESTROY
 						viewState.setPredefined<4>(this, view, program, _render, draw);
 					}
 
+					cmd.m_pipelineLayout = VK_NULL_HANDLE;
+					cmd.m_descriptorSet  = VK_NULL_HANDLE;
+					cmd.m_numOffsets     = 0;
+
 					if (VK_NULL_HANDLE != program.m_descriptorSetLayout)
 					{
 						const uint32_t vsize = program.m_vsh->m_size;
 						const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
-						uint32_t numOffset = 0;
-						uint32_t offsets[2] = { 0, 0 };
 
 						if (constantsChanged
 						||  hasPredefined)
 						{
+							currentNumOffsets = 0;
+
 							if (vsize > 0)
 							{
-								offsets[numOffset++] = scratchBuffer.write(m_vsScratch, vsize);
+								currentOffsets[currentNumOffsets++] = scratchBuffer.write(m_vsScratch, vsize);
 							}
 
 							if (fsize > 0)
 							{
-								offsets[numOffset++] = scratchBuffer.write(m_fsScratch, fsize);
+								currentOffsets[currentNumOffsets++] = scratchBuffer.write(m_fsScratch, fsize);
 							}
 						}
 
@@ -8967,45 +10194,36 @@ VK_DESTROY
 							descriptorSetCount++;
 						}
 
-						vkCmdBindDescriptorSets(
-							  m_commandBuffer
-							, VK_PIPELINE_BIND_POINT_GRAPHICS
-							, program.m_pipelineLayout
-							, 0
-							, 1
-							, &currentDescriptorSet
-							, numOffset
-							, offsets
-							);
+						cmd.m_pipelineLayout = program.m_pipelineLayout;
+						cmd.m_descriptorSet  = currentDescriptorSet;
+						cmd.m_numOffsets     = currentNumOffsets;
+						cmd.m_offsets[0]     = currentOffsets[0];
+						cmd.m_offsets[1]     = currentOffsets[1];
 					}
 
-					VkBuffer bufferIndirect = VK_NULL_HANDLE;
-					VkBuffer bufferNumIndirect = VK_NULL_HANDLE;
-					uint32_t numDrawIndirect = 0;
-					uint32_t bufferOffsetIndirect = 0;
-					uint32_t bufferNumOffsetIndirect = 0;
+					cmd.m_indirectBuffer    = VK_NULL_HANDLE;
+					cmd.m_numIndirectBuffer = VK_NULL_HANDLE;
+					cmd.m_indirectOffset    = 0;
+					cmd.m_numIndirectOffset = 0;
+					cmd.m_numIndirect       = 0;
+
 					if (isValid(draw.m_indirectBuffer) )
 					{
 						const VertexBufferVK& vb = m_vertexBuffers[draw.m_indirectBuffer.idx];
-						bufferIndirect = vb.m_buffer;
-						numDrawIndirect = UINT32_MAX == draw.m_numIndirect
+						cmd.m_indirectBuffer = vb.m_buffer;
+						cmd.m_numIndirect = UINT32_MAX == draw.m_numIndirect
 							? vb.m_size / BGFX_CONFIG_DRAW_INDIRECT_STRIDE
 							: draw.m_numIndirect
 							;
-						bufferOffsetIndirect = draw.m_startIndirect * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
+						cmd.m_indirectOffset = draw.m_startIndirect * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
 
 						if (isValid(draw.m_numIndirectBuffer) )
 						{
-							bufferNumIndirect = m_indexBuffers[draw.m_numIndirectBuffer.idx].m_buffer;
-							bufferNumOffsetIndirect = draw.m_numIndirectIndex * sizeof(uint32_t);
+							cmd.m_numIndirectBuffer = m_indexBuffers[draw.m_numIndirectBuffer.idx].m_buffer;
+							cmd.m_numIndirectOffset = draw.m_numIndirectIndex * sizeof(uint32_t);
 						}
 					}
 
-					if (hasOcclusionQuery)
-					{
-						m_occlusionQuery.begin(draw.m_occlusionQuery);
-					}
-
 					const uint8_t primIndex = uint8_t((draw.m_stateFlags & BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT);
 					const PrimInfo& prim = s_primInfo[primIndex];
 
@@ -9016,41 +10234,10 @@ VK_DESTROY
 					{
 						numPrimsSubmitted = numVertices / prim.m_div - prim.m_sub;
 
-						if (isValid(draw.m_indirectBuffer) )
-						{
-							if (isValid(draw.m_numIndirectBuffer) )
-							{
-								vkCmdDrawIndirectCountKHR(
-									  m_commandBuffer
-									, bufferIndirect
-									, bufferOffsetIndirect
-									, bufferNumIndirect
-									, bufferNumOffsetIndirect
-									, numDrawIndirect
-									, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
-									);
-							}
-							else
-							{
-								vkCmdDrawIndirect(
-									  m_commandBuffer
-									, bufferIndirect
-									, bufferOffsetIndirect
-									, numDrawIndirect
-									, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
-									);
-							}
-						}
-						else
-						{
-							vkCmdDraw(
-								  m_commandBuffer
-								, numVertices
-								, draw.m_numInstances
-								, 0
-								, 0
-								);
-						}
+						cmd.m_indexBuffer = VK_NULL_HANDLE;
+						cmd.m_indexFormat = VK_INDEX_TYPE_MAX_ENUM;
+						cmd.m_num         = numVertices;
+						cmd.m_startIndex  = 0;
 					}
 					else
 					{
@@ -9066,56 +10253,28 @@ VK_DESTROY
 
 						numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
 
-						if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx
-						||  currentIndexFormat != indexFormat)
-						{
-							currentState.m_indexBuffer = draw.m_indexBuffer;
-							currentIndexFormat = indexFormat;
+						currentState.m_indexBuffer = draw.m_indexBuffer;
 
-							vkCmdBindIndexBuffer(
-								  m_commandBuffer
-								, m_indexBuffers[draw.m_indexBuffer.idx].m_buffer
-								, 0
-								, indexFormat
-								);
-						}
+						cmd.m_indexBuffer = ib.m_buffer;
+						cmd.m_indexFormat = indexFormat;
+						cmd.m_num         = numIndices;
+						cmd.m_startIndex  = draw.m_startIndex;
+					}
 
-						if (isValid(draw.m_indirectBuffer) )
-						{
-							if (isValid(draw.m_numIndirectBuffer) )
-							{
-								vkCmdDrawIndexedIndirectCountKHR(
-									  m_commandBuffer
-									, bufferIndirect
-									, bufferOffsetIndirect
-									, bufferNumIndirect
-									, bufferNumOffsetIndirect
-									, numDrawIndirect
-									, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
-									);
-							}
-							else
-							{
-								vkCmdDrawIndexedIndirect(
-									  m_commandBuffer
-									, bufferIndirect
-									, bufferOffsetIndirect
-									, numDrawIndirect
-									, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
-									);
-							}
-						}
-						else
+					cmd.m_numInstances = draw.m_numInstances;
+
+					if (recordView)
+					{
+						m_drawCommands.push_back(cmd);
+					}
+					else
+					{
+						if (hasOcclusionQuery)
 						{
-							vkCmdDrawIndexed(
-								  m_commandBuffer
-								, numIndices
-								, draw.m_numInstances
-								, draw.m_startIndex
-								, 0
-								, 0
-								);
+							m_occlusionQuery.begin(draw.m_occlusionQuery);
 						}
+
+						drawEncoder.encode(cmd);
 					}
 
 					uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
@@ -9134,7 +10293,16 @@ VK_DESTROY
 
 			if (beginRenderPass)
 			{
-				vkCmdEndRenderPass(m_commandBuffer);
+				if (recordView)
+				{
+					numRecordedCommandBuffers += executeDrawCommands(rpbi, viewport, viewScissor);
+					++numRecordedViews;
+				}
+				else
+				{
+					vkCmdEndRenderPass(m_commandBuffer);
+				}
+
 				beginRenderPass = false;
 			}
 
@@ -9233,10 +10401,21 @@ VK_DESTROY
 		perfStats.numBlit       = _render->m_numBlitItems;
 		perfStats.maxGpuLatency = maxGpuLatency;
 		perfStats.gpuFrameNum   = result.m_frameNum;
+		perfStats.numPipelinesPending    = m_pipelineCompiler.getNumPending();
+		perfStats.numPipelineCacheHits   = m_pipelineCacheHits;
+		perfStats.numPipelineCacheMisses = m_pipelineCacheMisses;
 		bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
 		perfStats.gpuMemoryMax  = gpuMemoryAvailable;
 		perfStats.gpuMemoryUsed = gpuMemoryUsed;
 
+		DeviceMemoryAllocatorVK::Stats memoryStats;
+		m_memoryAllocator.getStats(memoryStats);
+		perfStats.gpuMemoryAllocated    = memoryStats.allocated;
+		perfStats.gpuMemoryBlockFree    = memoryStats.blockFree;
+		perfStats.gpuMemoryLargestFree  = memoryStats.blockLargestFree;
+		perfStats.numGpuMemoryAllocs    = memoryStats.numAllocations;
+		perfStats.numGpuMemorySubAllocs = memoryStats.numSubAllocations;
+
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
 			BGFX_VK_PROFILER_BEGIN_LITERAL("debugstats", kColorFrame);
@@ -9292,6 +10471,27 @@ VK_DESTROY
 					}
 				}
 
+				{
+					char allocated[16];
+					bx::prettify(allocated, BX_COUNTOF(allocated), memoryStats.allocated);
+
+					char blockFree[16];
+					bx::prettify(blockFree, BX_COUNTOF(blockFree), memoryStats.blockFree);
+
+					const double fragmentation = 0 < memoryStats.blockFree
+						? 1.0 - double(memoryStats.blockLargestFree)/double(memoryStats.blockFree)
+						: 0.0
+						;
+
+					tvm.printf(0, pos++, 0x8f, " Allocated: %12s (%5d allocs, %6d resources), block free: %12s, fragmentation: %3.0f%%"
+						, allocated
+						, memoryStats.numAllocations
+						, memoryStats.numSubAllocations
+						, blockFree
+						, fragmentation*100.0
+						);
+				}
+
 				pos = 10;
 				tvm.printf(10, pos++, 0x8b, "       Frame: % 7.3f, % 7.3f \x1f, % 7.3f \x1e [ms] / % 6.2f FPS"
 					, double(frameTime)*toMs
@@ -9355,6 +10555,24 @@ VK_DESTROY
 					, m_descriptorSetLayoutCache.getCount()
 					, descriptorSetCount
 					);
+				tvm.printf(10, pos++, 0x8b, " DS cache: %6d, new: %6d, pools: %2d "
+					, descriptorSetCache.getCount()
+					, descriptorSetCache.getNumAllocated()
+					, descriptorSetCache.getNumPools()
+					);
+
+				if (m_drawRecorder.isEnabled() )
+				{
+					tvm.printf(10, pos++, 0x8b, " Recorded views: %3d, secondary CB: %4d "
+						, numRecordedViews
+						, numRecordedCommandBuffers
+						);
+				}
+				tvm.printf(10, pos++, 0x8b, " PSO pending: %5d, cache hit/miss: %5d / %5d "
+					, m_pipelineCompiler.getNumPending()
+					, m_pipelineCacheHits
+					, m_pipelineCacheMisses
+					);
 				pos++;
 
 				double captureMs = double(captureElapsed)*toMs;
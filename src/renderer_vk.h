@@ -188,6 +188,7 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdPipelineBarrier);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdBeginRenderPass);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdEndRenderPass);               \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdExecuteCommands);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdSetViewport);                 \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdDraw);                        \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdDrawIndexed);                 \
@@ -330,7 +331,6 @@ namespace bgfx { namespace vk
 VK_DESTROY
 VK_DESTROY_FUNC(DeviceMemory);
 VK_DESTROY_FUNC(SurfaceKHR);
-VK_DESTROY_FUNC(DescriptorSet);
 #undef VK_DESTROY_FUNC
 
 	template<typename Ty>
@@ -429,11 +429,277 @@ VK_DESTROY_FUNC(DescriptorSet);
 		uint32_t m_align;
 	};
 
+	/// Device memory range resource is bound to.
+	struct DeviceMemoryAllocationVK
+	{
+		DeviceMemoryAllocationVK()
+			: m_memory(VK_NULL_HANDLE)
+			, m_offset(0)
+			, m_size(0)
+			, m_blockOffset(0)
+			, m_block(UINT32_MAX)
+		{
+		}
+
+		::VkDeviceMemory m_memory;
+		VkDeviceSize     m_offset;
+		VkDeviceSize     m_size;
+		VkDeviceSize     m_blockOffset; //!< Start of block range, before alignment.
+		uint32_t         m_block;       //!< Memory block index, UINT32_MAX for dedicated allocation.
+	};
+
+	/// Places resources into large device memory blocks, instead of doing one
+	/// device memory allocation per resource. Blocks are kept per memory type,
+	/// separately for buffers and images, so buffer-image granularity doesn't
+	/// have to be considered. Resources larger than half of block size get
+	/// dedicated allocation. Ranges inside block are managed by TLSF
+	/// NonLocalAllocator.
+	class DeviceMemoryAllocatorVK
+	{
+	public:
+		struct Stats
+		{
+			int64_t  allocated;         //!< Device memory allocated, including dedicated allocations.
+			int64_t  blockFree;         //!< Free space inside blocks.
+			int64_t  blockLargestFree;  //!< Largest free range inside blocks.
+			uint32_t numAllocations;    //!< Number of device memory allocations.
+			uint32_t numSubAllocations; //!< Number of resources placed inside blocks.
+		};
+
+		DeviceMemoryAllocatorVK();
+		~DeviceMemoryAllocatorVK();
+
+		void init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, VkDeviceSize _blockSize);
+		void shutdown();
+
+		VkResult alloc(const VkMemoryRequirements& _requirements, uint32_t _memoryTypeIndex, bool _image, DeviceMemoryAllocationVK* _allocation);
+		void free(const DeviceMemoryAllocationVK& _allocation);
+
+		void getStats(Stats& _stats) const;
+		void dump() const;
+
+	private:
+		struct Block
+		{
+			::VkDeviceMemory  m_memory;
+			VkDeviceSize      m_size;
+			uint32_t          m_numAllocations;
+			uint32_t          m_key;
+			NonLocalAllocator m_allocator;
+		};
+
+		VkResult allocateMemory(VkDeviceSize _size, uint32_t _memoryTypeIndex, ::VkDeviceMemory* _memory);
+		bool allocFromBlock(uint32_t _blockIdx, const VkMemoryRequirements& _requirements, DeviceMemoryAllocationVK* _allocation);
+
+		VkDevice                     m_device;
+		const VkAllocationCallbacks* m_allocatorCb;
+		VkDeviceSize                 m_blockSize;
+
+		typedef stl::vector<Block*> BlockArray;
+		BlockArray m_blocks;
+
+		int64_t  m_dedicatedSize;
+		uint32_t m_numDedicated;
+	};
+
+	/// Everything descriptor set content depends on. Key is compared as whole
+	/// on lookup, so it must be zeroed before it's filled.
+	struct DescriptorSetKeyVK
+	{
+		struct Bind
+		{
+			uint32_t m_samplerFlags;
+			uint16_t m_idx;
+			uint8_t  m_type;
+			uint8_t  m_mip;
+		};
+
+		::VkDescriptorSetLayout m_layout;
+		::VkBuffer              m_buffer;
+		uint32_t                m_vsize;
+		uint32_t                m_fsize;
+		uint32_t                m_palette;
+		Bind                    m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+	};
+
+	/// Descriptor sets keyed by their content. Sets are never freed
+	/// individually, pools are reset as whole once GPU is done with them and
+	/// cached sets became stale, or working set didn't fit into single pool.
+	/// There is one cache per frame in flight.
+	class DescriptorSetCacheVK
+	{
+	public:
+		DescriptorSetCacheVK();
+		~DescriptorSetCacheVK();
+
+		VkResult init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, uint32_t _maxSetsPerPool);
+		void shutdown();
+
+		/// Start using cache. Sets allocated before are reused, unless they were
+		/// cached with different generation.
+		void begin(uint32_t _generation);
+
+		::VkDescriptorSet find(const DescriptorSetKeyVK& _key) const;
+		VkResult alloc(const DescriptorSetKeyVK& _key, ::VkDescriptorSet* _descriptorSet);
+
+		uint32_t getCount() const
+		{
+			return uint32_t(m_descriptorSets.size() );
+		}
+
+		uint32_t getNumAllocated() const
+		{
+			return m_numAllocated;
+		}
+
+		uint32_t getNumPools() const
+		{
+			return uint32_t(m_pools.size() );
+		}
+
+	private:
+		VkResult createPool(::VkDescriptorPool* _pool);
+		void reset();
+
+		struct Entry
+		{
+			DescriptorSetKeyVK m_key;
+			::VkDescriptorSet  m_descriptorSet;
+		};
+
+		typedef stl::unordered_map<uint32_t, Entry> DescriptorSetHashMap;
+		DescriptorSetHashMap m_descriptorSets;
+
+		typedef stl::vector< ::VkDescriptorPool> DescriptorPoolArray;
+		DescriptorPoolArray m_pools;
+
+		VkDevice                     m_device;
+		const VkAllocationCallbacks* m_allocatorCb;
+
+		uint32_t m_maxSetsPerPool;
+		uint32_t m_currentPool;
+		uint32_t m_numSetsInPool;
+		uint32_t m_numAllocated;
+		uint32_t m_generation;
+	};
+
+	/// Draw call with all state resolved, so it can be encoded into command
+	/// buffer without access to renderer state.
+	struct DrawCommandVK
+	{
+		::VkPipeline       m_pipeline;
+		::VkPipelineLayout m_pipelineLayout;
+		::VkDescriptorSet  m_descriptorSet;
+		uint32_t           m_numOffsets;
+		uint32_t           m_offsets[2];
+
+		uint32_t     m_numVertexBuffers;
+		::VkBuffer   m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		VkDeviceSize m_vertexOffsets[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		::VkBuffer   m_indexBuffer;
+		VkIndexType  m_indexFormat;
+
+		::VkBuffer m_indirectBuffer;
+		::VkBuffer m_numIndirectBuffer;
+		uint32_t   m_indirectOffset;
+		uint32_t   m_numIndirectOffset;
+		uint32_t   m_numIndirect;
+
+		uint32_t m_num;          //!< Number of vertices, or indices when index buffer is used.
+		uint32_t m_numInstances;
+		uint32_t m_startIndex;
+
+		VkRect2D m_scissor;
+		uint32_t m_stencilRef;   //!< UINT32_MAX when stencil is not used.
+		uint64_t m_blendFactor;  //!< UINT64_MAX when blend factor is not used.
+	};
+
+	/// Encodes draw commands, skipping state that is already set.
+	struct DrawEncoderVK
+	{
+		void begin(VkCommandBuffer _commandBuffer, const VkRect2D& _scissor);
+		void encode(const DrawCommandVK& _cmd);
+
+		VkCommandBuffer    m_commandBuffer;
+		::VkPipeline       m_pipeline;
+		::VkPipelineLayout m_pipelineLayout;
+		::VkDescriptorSet  m_descriptorSet;
+		uint32_t           m_numOffsets;
+		uint32_t           m_offsets[2];
+		uint32_t           m_numVertexBuffers;
+		::VkBuffer         m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		VkDeviceSize       m_vertexOffsets[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		::VkBuffer         m_indexBuffer;
+		VkIndexType        m_indexFormat;
+		VkRect2D           m_scissor;
+		uint32_t           m_stencilRef;
+		uint64_t           m_blendFactor;
+	};
+
+	/// Records draw commands of a render pass into secondary command buffers
+	/// using worker threads. Render thread participates in recording.
+	class DrawRecorderVK
+	{
+	public:
+		static constexpr uint32_t kMaxTasks        = BGFX_CONFIG_MAX_WORKER_THREADS+1;
+		static constexpr uint32_t kMinDrawsPerTask = 64;
+
+		DrawRecorderVK();
+		~DrawRecorderVK();
+
+		VkResult init(VkDevice _device, const VkAllocationCallbacks* _allocatorCb, uint32_t _queueFamily, uint32_t _numFramesInFlight, uint32_t _numThreads);
+		void shutdown();
+
+		/// Reset command buffers of frame. Must be called when GPU is done with
+		/// them.
+		void begin(uint32_t _frameInFlight);
+
+		/// Record draw commands, returns number of secondary command buffers
+		/// written into `_commandBuffers`.
+		uint32_t record(
+			  const VkCommandBufferInheritanceInfo& _inheritanceInfo
+			, const VkViewport& _viewport
+			, const VkRect2D& _scissor
+			, const DrawCommandVK* _cmds
+			, uint32_t _num
+			, ::VkCommandBuffer* _commandBuffers
+			);
+
+		bool isEnabled() const
+		{
+			return 1 < m_workerPool.getNumThreads();
+		}
+
+	private:
+		static void recordTask(void* _userData, uint32_t _idx, uint32_t _num);
+
+		struct CommandPool
+		{
+			::VkCommandPool m_commandPool;
+			stl::vector< ::VkCommandBuffer> m_commandBuffers;
+			uint32_t m_numUsed;
+		};
+
+		CommandPool m_pool[BGFX_CONFIG_MAX_FRAME_LATENCY][kMaxTasks];
+		WorkerPool  m_workerPool;
+
+		VkDevice                     m_device;
+		const VkAllocationCallbacks* m_allocatorCb;
+		uint32_t                     m_numFramesInFlight;
+		uint32_t                     m_frameInFlight;
+
+		const VkCommandBufferInheritanceInfo* m_inheritanceInfo;
+		const VkViewport*    m_viewport;
+		const VkRect2D*      m_scissor;
+		const DrawCommandVK* m_cmds;
+		uint32_t             m_numCmds;
+		::VkCommandBuffer*   m_commandBuffers;
+	};
+
 	struct BufferVK
 	{
 		BufferVK()
 			: m_buffer(VK_NULL_HANDLE)
-			, m_deviceMem(VK_NULL_HANDLE)
 			, m_size(0)
 			, m_flags(BGFX_BUFFER_NONE)
 			, m_dynamic(false)
@@ -445,7 +711,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 		void destroy();
 
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_deviceMem;
 		uint32_t m_size;
 		uint16_t m_flags;
 		bool m_dynamic;
@@ -658,10 +924,8 @@ VK_DESTROY_FUNC(DescriptorSet);
 			, m_sampler({ 1, VK_SAMPLE_COUNT_1_BIT })
 			, m_format(VK_FORMAT_UNDEFINED)
 			, m_textureImage(VK_NULL_HANDLE)
-			, m_textureDeviceMem(VK_NULL_HANDLE)
 			, m_currentImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 			, m_singleMsaaImage(VK_NULL_HANDLE)
-			, m_singleMsaaDeviceMem(VK_NULL_HANDLE)
 			, m_currentSingleMsaaImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 		{
 		}
@@ -698,13 +962,13 @@ VK_DESTROY_FUNC(DescriptorSet);
 		VkComponentMapping m_components;
 		VkImageAspectFlags m_aspectMask;
 
-		VkImage        m_textureImage;
-		VkDeviceMemory m_textureDeviceMem;
-		VkImageLayout  m_currentImageLayout;
+		VkImage                  m_textureImage;
+		DeviceMemoryAllocationVK m_textureDeviceMem;
+		VkImageLayout            m_currentImageLayout;
 
-		VkImage        m_singleMsaaImage;
-		VkDeviceMemory m_singleMsaaDeviceMem;
-		VkImageLayout  m_currentSingleMsaaImageLayout;
+		VkImage                  m_singleMsaaImage;
+		DeviceMemoryAllocationVK m_singleMsaaDeviceMem;
+		VkImageLayout            m_currentSingleMsaaImageLayout;
 
 		VkImageLayout m_sampledLayout;
 
@@ -846,6 +1110,88 @@ VK_DESTROY_FUNC(DescriptorSet);
 		VkFramebuffer m_currentFramebuffer;
 	};
 
+	/// Graphics pipeline create info with storage for all state it points to,
+	/// so pipeline can be compiled after the function filling it returns.
+	struct PipelineCreateInfoVK
+	{
+		VkGraphicsPipelineCreateInfo                          m_info;
+		VkPipelineShaderStageCreateInfo                       m_shaderStages[2];
+		VkPipelineVertexInputStateCreateInfo                  m_vertexInputState;
+		VkVertexInputBindingDescription                       m_inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		VkVertexInputAttributeDescription                     m_inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+		VkPipelineInputAssemblyStateCreateInfo                m_inputAssemblyState;
+		VkPipelineViewportStateCreateInfo                     m_viewportState;
+		VkPipelineRasterizationStateCreateInfo                m_rasterizationState;
+		VkPipelineRasterizationConservativeStateCreateInfoEXT m_conservativeRasterizationState;
+		VkPipelineRasterizationLineStateCreateInfoEXT         m_lineRasterizationState;
+		VkPipelineMultisampleStateCreateInfo                  m_multisampleState;
+		VkPipelineDepthStencilStateCreateInfo                 m_depthStencilState;
+		VkPipelineColorBlendStateCreateInfo                   m_colorBlendState;
+		VkPipelineColorBlendAttachmentState                   m_blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		VkPipelineDynamicStateCreateInfo                      m_dynamicState;
+		VkPipelineCreationFeedbackCreateInfoEXT               m_feedbackInfo;
+		VkPipelineCreationFeedbackEXT                         m_feedback;
+		VkPipelineCreationFeedbackEXT                         m_stageFeedback[2];
+
+		uint32_t   m_hash;
+		VkPipeline m_pipeline;
+		VkResult   m_result;
+
+		PipelineCreateInfoVK* m_next;
+	};
+
+	/// Compiles graphics pipelines on worker threads. All pipelines are
+	/// compiled with single pipeline cache shared between threads.
+	class PipelineCompilerVK
+	{
+	public:
+		PipelineCompilerVK();
+		~PipelineCompilerVK();
+
+		void init(VkDevice _device, VkPipelineCache _cache, const VkAllocationCallbacks* _allocatorCb, uint32_t _numThreads);
+		void shutdown();
+
+		/// Compile pipeline on calling thread.
+		void compile(PipelineCreateInfoVK* _pci);
+
+		/// Queue pipeline for compilation on worker thread.
+		void push(PipelineCreateInfoVK* _pci);
+
+		/// Returns compiled pipeline, or NULL if there is none. When `_wait`
+		/// is true, waits until pipeline is compiled if any is pending.
+		PipelineCreateInfoVK* pop(bool _wait);
+
+		uint32_t getNumPending() const
+		{
+			return m_numPending;
+		}
+
+		uint32_t getNumThreads() const
+		{
+			return m_numThreads;
+		}
+
+	private:
+		static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+
+		VkDevice                     m_device;
+		VkPipelineCache              m_cache;
+		const VkAllocationCallbacks* m_allocatorCb;
+
+		bx::Thread    m_thread[BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS > 0 ? BGFX_CONFIG_RENDERER_VULKAN_PIPELINE_COMPILE_THREADS : 1];
+		bx::Mutex     m_mutex;
+		bx::Semaphore m_queued;
+		bx::Semaphore m_compiled;
+
+		PipelineCreateInfoVK* m_queueHead;
+		PipelineCreateInfoVK* m_queueTail;
+		PipelineCreateInfoVK* m_done;
+
+		uint32_t m_numThreads;
+		uint32_t m_numPending;
+		bool     m_exit;
+	};
+
 	struct CommandQueueVK
 	{
 		VkResult init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight);
@@ -859,6 +1205,7 @@ VK_DESTROY_FUNC(DescriptorSet);
 		void finish(bool _finishAll = false);
 
 		void release(uint64_t _handle, VkObjectType _type);
+		void release(const DeviceMemoryAllocationVK& _allocation);
 		void consume();
 
 		uint32_t m_queueFamily;
@@ -900,6 +1247,9 @@ VK_DESTROY_FUNC(DescriptorSet);
 		typedef stl::vector<Resource> ResourceArray;
 		ResourceArray m_release[BGFX_CONFIG_MAX_FRAME_LATENCY];
 
+		typedef stl::vector<DeviceMemoryAllocationVK> DeviceMemoryArray;
+		DeviceMemoryArray m_releaseMemory[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
 	private:
 		template<typename Ty>
 		void destroy(uint64_t _handle)
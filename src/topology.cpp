@@ -6,11 +6,13 @@
 #include <bx/allocator.h>
 #include <bx/debug.h>
 #include <bx/math.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/uint32_t.h>
 
 #include "config.h"
 #include "topology.h"
+#include "worker.h"
 
 namespace bgfx
 {
@@ -262,120 +264,469 @@ namespace bgfx
 		return 0;
 	}
 
-	inline float fmin3(float _a, float _b, float _c)
+	inline bx::simd128_t simdMin3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		return bx::min(_a, _b, _c);
+		return bx::simd_min(bx::simd_min(_a, _b), _c);
 	}
 
-	inline float fmax3(float _a, float _b, float _c)
+	inline bx::simd128_t simdMax3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		return bx::max(_a, _b, _c);
+		return bx::simd_max(bx::simd_max(_a, _b), _c);
 	}
 
-	inline float favg3(float _a, float _b, float _c)
+	inline bx::simd128_t simdAvg3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		return (_a + _b + _c) * 1.0f/3.0f;
+		return bx::simd_mul(bx::simd_add(bx::simd_add(_a, _b), _c), bx::simd_splat(1.0f/3.0f) );
 	}
 
-	const bx::Vec3 vertexPos(const void* _vertices, uint32_t _stride, uint32_t _index)
+	inline bx::simd128_t simdDistanceDir(const bx::simd128_t _dir[3], bx::simd128_t _x, bx::simd128_t _y, bx::simd128_t _z)
 	{
-		const uint8_t* vertices = (const uint8_t*)_vertices;
-		return bx::load<bx::Vec3>(&vertices[_index*_stride]);
+		using namespace bx;
+		const simd128_t xx = simd_mul(_x, _dir[0]);
+		const simd128_t yy = simd_mul(_y, _dir[1]);
+		const simd128_t zz = simd_mul(_z, _dir[2]);
+		return simd_add(simd_add(xx, yy), zz);
 	}
 
-	inline float distanceDir(const float* _dir, const void* _vertices, uint32_t _stride, uint32_t _index)
+	inline bx::simd128_t simdDistancePos(const bx::simd128_t _pos[3], bx::simd128_t _x, bx::simd128_t _y, bx::simd128_t _z)
 	{
-		return bx::dot(vertexPos(_vertices, _stride, _index), bx::load<bx::Vec3>(_dir) );
+		using namespace bx;
+		const simd128_t dx = simd_sub(_pos[0], _x);
+		const simd128_t dy = simd_sub(_pos[1], _y);
+		const simd128_t dz = simd_sub(_pos[2], _z);
+		const simd128_t xx = simd_mul(dx, dx);
+		const simd128_t yy = simd_mul(dy, dy);
+		const simd128_t zz = simd_mul(dz, dz);
+		return simd_sqrt(simd_add(simd_add(xx, yy), zz) );
 	}
 
-	inline float distancePos(const float* _pos, const void* _vertices, uint32_t _stride, uint32_t _index)
-	{
-		const bx::Vec3 tmp = bx::sub(bx::load<bx::Vec3>(_pos), vertexPos(_vertices, _stride, _index) );
-		return bx::sqrt(bx::dot(tmp, tmp) );
-	}
+	typedef bx::simd128_t (*KeyFn)(bx::simd128_t, bx::simd128_t, bx::simd128_t);
+	typedef bx::simd128_t (*DistanceFn)(const bx::simd128_t*, bx::simd128_t, bx::simd128_t, bx::simd128_t);
 
-	typedef float (*KeyFn)(float, float, float);
-	typedef float (*DistanceFn)(const float*, const void*, uint32_t, uint32_t);
+	/// Calculates sort keys of triangles in range [_begin, _end). When `_order` is not NULL
+	/// keys are calculated for triangles `_order[ii]`, otherwise for triangles `ii`.
+	typedef void (*CalcSortKeysFn)(
+		  uint32_t* _keys
+		, uint32_t* _values
+		, const uint32_t* _order
+		, const float _dirOrPos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _begin
+		, uint32_t _end
+		);
 
 	template<typename IndexT, DistanceFn dfn, KeyFn kfn, uint32_t xorBits>
-	inline void calcSortKeys(
+	static void calcSortKeys(
 		  uint32_t* _keys
 		, uint32_t* _values
+		, const uint32_t* _order
 		, const float _dirOrPos[3]
 		, const void* _vertices
 		, uint32_t _stride
-		, const IndexT* _indices
-		, uint32_t _num
+		, const void* _indices
+		, uint32_t _begin
+		, uint32_t _end
 		)
 	{
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		using namespace bx;
+
+		const IndexT*  indices  = (const IndexT*)_indices;
+		const uint8_t* vertices = (const uint8_t*)_vertices;
+
+		const simd128_t dirOrPos[3] =
 		{
-			const uint32_t idx0 = _indices[0];
-			const uint32_t idx1 = _indices[1];
-			const uint32_t idx2 = _indices[2];
-			_indices += 3;
-
-			float distance0 = dfn(_dirOrPos, _vertices, _stride, idx0);
-			float distance1 = dfn(_dirOrPos, _vertices, _stride, idx1);
-			float distance2 = dfn(_dirOrPos, _vertices, _stride, idx2);
-
-			uint32_t ui = bx::floatToBits(kfn(distance0, distance1, distance2) );
-			_keys[ii]   = bx::floatFlip(ui) ^ xorBits;
-			_values[ii] = ii;
+			simd_splat(_dirOrPos[0]),
+			simd_splat(_dirOrPos[1]),
+			simd_splat(_dirOrPos[2]),
+		};
+
+		const simd128_t signBit = simd_isplat<simd128_t>(UINT32_C(0x80000000) );
+		const simd128_t xorMask = simd_isplat<simd128_t>(xorBits);
+
+		// Triangles are processed in batches of 4, one per SIMD lane. Last batch
+		// repeats last triangle in unused lanes.
+		for (uint32_t ii = _begin; ii < _end; ii += 4)
+		{
+			BX_ALIGN_DECL_16(float) xx[3][4];
+			BX_ALIGN_DECL_16(float) yy[3][4];
+			BX_ALIGN_DECL_16(float) zz[3][4];
+			uint32_t face[4];
+
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const uint32_t idx = bx::min(ii+lane, _end-1);
+				face[lane] = NULL != _order ? _order[idx] : idx;
+
+				const IndexT* tri = &indices[face[lane]*3];
+
+				for (uint32_t jj = 0; jj < 3; ++jj)
+				{
+					const float* pos = (const float*)&vertices[tri[jj]*_stride];
+					xx[jj][lane] = pos[0];
+					yy[jj][lane] = pos[1];
+					zz[jj][lane] = pos[2];
+				}
+			}
+
+			const simd128_t distance0 = dfn(dirOrPos, simd_ld<simd128_t>(xx[0]), simd_ld<simd128_t>(yy[0]), simd_ld<simd128_t>(zz[0]) );
+			const simd128_t distance1 = dfn(dirOrPos, simd_ld<simd128_t>(xx[1]), simd_ld<simd128_t>(yy[1]), simd_ld<simd128_t>(zz[1]) );
+			const simd128_t distance2 = dfn(dirOrPos, simd_ld<simd128_t>(xx[2]), simd_ld<simd128_t>(yy[2]), simd_ld<simd128_t>(zz[2]) );
+			const simd128_t key       = kfn(distance0, distance1, distance2);
+
+			// Same as bx::floatFlip, makes float bits sortable as unsigned integer.
+			const simd128_t mask    = simd_or(simd_sra(key, 31), signBit);
+			const simd128_t flipped = simd_xor(simd_xor(key, mask), xorMask);
+
+			BX_ALIGN_DECL_16(uint32_t) keys[4];
+			simd_st(keys, flipped);
+
+			for (uint32_t lane = 0, num = bx::min<uint32_t>(4, _end-ii); lane < num; ++lane)
+			{
+				_keys[ii+lane]   = keys[lane];
+				_values[ii+lane] = face[lane];
+			}
 		}
 	}
 
 	template<typename IndexT>
-	void topologySortTriList(
+	static CalcSortKeysFn getCalcSortKeysFn(TopologySort::Enum _sort)
+	{
+		switch (_sort)
+		{
+		default:
+		case TopologySort::DirectionFrontToBackMin: return calcSortKeys<IndexT, simdDistanceDir, simdMin3, 0         >;
+		case TopologySort::DirectionFrontToBackAvg: return calcSortKeys<IndexT, simdDistanceDir, simdAvg3, 0         >;
+		case TopologySort::DirectionFrontToBackMax: return calcSortKeys<IndexT, simdDistanceDir, simdMax3, 0         >;
+		case TopologySort::DirectionBackToFrontMin: return calcSortKeys<IndexT, simdDistanceDir, simdMin3, UINT32_MAX>;
+		case TopologySort::DirectionBackToFrontAvg: return calcSortKeys<IndexT, simdDistanceDir, simdAvg3, UINT32_MAX>;
+		case TopologySort::DirectionBackToFrontMax: return calcSortKeys<IndexT, simdDistanceDir, simdMax3, UINT32_MAX>;
+		case TopologySort::DistanceFrontToBackMin:  return calcSortKeys<IndexT, simdDistancePos, simdMin3, 0         >;
+		case TopologySort::DistanceFrontToBackAvg:  return calcSortKeys<IndexT, simdDistancePos, simdAvg3, 0         >;
+		case TopologySort::DistanceFrontToBackMax:  return calcSortKeys<IndexT, simdDistancePos, simdMax3, 0         >;
+		case TopologySort::DistanceBackToFrontMin:  return calcSortKeys<IndexT, simdDistancePos, simdMin3, UINT32_MAX>;
+		case TopologySort::DistanceBackToFrontAvg:  return calcSortKeys<IndexT, simdDistancePos, simdAvg3, UINT32_MAX>;
+		case TopologySort::DistanceBackToFrontMax:  return calcSortKeys<IndexT, simdDistancePos, simdMax3, UINT32_MAX>;
+		}
+	}
+
+	inline bool isSortByDirection(TopologySort::Enum _sort)
+	{
+		return _sort < TopologySort::DistanceFrontToBackMin;
+	}
+
+	template<typename IndexT>
+	static void writeSortedTriList(IndexT* _dst, const IndexT* _indices, const uint32_t* _values, uint32_t _begin, uint32_t _end)
+	{
+		IndexT* sorted = &_dst[_begin*3];
+
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const uint32_t face = _values[ii]*3;
+			sorted[0] = _indices[face+0];
+			sorted[1] = _indices[face+1];
+			sorted[2] = _indices[face+2];
+			sorted += 3;
+		}
+	}
+
+	/// Insertion sort of nearly sorted keys. Gives up after `_maxMoves` element moves,
+	/// leaving keys and values in valid, partially sorted state.
+	static bool insertionSort(uint32_t* _keys, uint32_t* _values, uint32_t _num, uint32_t _maxMoves)
+	{
+		uint32_t numMoves = 0;
+
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const uint32_t key   = _keys[ii];
+			const uint32_t value = _values[ii];
+
+			uint32_t jj = ii;
+			for (; 0 < jj && _keys[jj-1] > key; --jj)
+			{
+				_keys[jj]   = _keys[jj-1];
+				_values[jj] = _values[jj-1];
+				++numMoves;
+			}
+
+			_keys[jj]   = key;
+			_values[jj] = value;
+
+			if (numMoves > _maxMoves)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Multi-threaded triangle sort. Keys are calculated per task range, and sorted with
+	// LSD radix sort with per-task histograms, same as render item sort. Context is
+	// static since it's used only while sort worker pool is owned by the caller.
+	struct TopologySortMt
+	{
+		static constexpr uint32_t kRadixBits      = 11;
+		static constexpr uint32_t kHistogramSize  = 1<<kRadixBits;
+		static constexpr uint32_t kHistogramMask  = kHistogramSize-1;
+		static constexpr uint32_t kNumPasses      = (32+kRadixBits-1)/kRadixBits;
+		static constexpr uint32_t kMinTrisPerTask = 16<<10;
+		static constexpr uint32_t kMaxTasks       = BGFX_CONFIG_MAX_WORKER_THREADS+1;
+
+		void getRange(uint32_t _idx, uint32_t _numTasks, uint32_t& _begin, uint32_t& _end) const
+		{
+			_begin = uint32_t(uint64_t(m_num)*(_idx  )/_numTasks);
+			_end   = uint32_t(uint64_t(m_num)*(_idx+1)/_numTasks);
+		}
+
+		static void calcSortKeysTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			TopologySortMt& ctx = *(TopologySortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			if (begin < end)
+			{
+				ctx.m_calcSortKeys(ctx.m_keys[0], ctx.m_values[0], ctx.m_order, ctx.m_dirOrPos, ctx.m_vertices, ctx.m_stride, ctx.m_indices, begin, end);
+			}
+		}
+
+		static void histogramTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			TopologySortMt& ctx = *(TopologySortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			uint32_t* histogram = ctx.m_histogram[_idx];
+			bx::memSet(histogram, 0, sizeof(ctx.m_histogram[0]) );
+
+			const uint32_t* keys  = ctx.m_keys[ctx.m_src];
+			const uint32_t  shift = ctx.m_shift;
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				++histogram[(keys[ii] >> shift) & kHistogramMask];
+			}
+		}
+
+		static void scatterTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			TopologySortMt& ctx = *(TopologySortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			uint32_t* offset = ctx.m_histogram[_idx];
+
+			const uint32_t* srcKeys   = ctx.m_keys[ctx.m_src];
+			const uint32_t* srcValues = ctx.m_values[ctx.m_src];
+			uint32_t*       dstKeys   = ctx.m_keys[ctx.m_src^1];
+			uint32_t*       dstValues = ctx.m_values[ctx.m_src^1];
+			const uint32_t  shift     = ctx.m_shift;
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				const uint32_t key  = srcKeys[ii];
+				const uint32_t dest = offset[(key >> shift) & kHistogramMask]++;
+
+				dstKeys[dest]   = key;
+				dstValues[dest] = srcValues[ii];
+			}
+		}
+
+		template<typename IndexT>
+		static void writeTask(void* _userData, uint32_t _idx, uint32_t _num)
+		{
+			TopologySortMt& ctx = *(TopologySortMt*)_userData;
+
+			uint32_t begin, end;
+			ctx.getRange(_idx, _num, begin, end);
+
+			writeSortedTriList( (IndexT*)ctx.m_dst, (const IndexT*)ctx.m_indices, ctx.m_values[0], begin, end);
+		}
+
+		// Converts per-task histograms into per-task scatter offsets. Returns
+		// false when all keys fall into the same bucket, and pass can be skipped.
+		bool prefixSum(uint32_t _numTasks)
+		{
+			uint32_t offset = 0;
+
+			for (uint32_t bucket = 0; bucket < kHistogramSize; ++bucket)
+			{
+				uint32_t count = 0;
+
+				for (uint32_t task = 0; task < _numTasks; ++task)
+				{
+					const uint32_t num = m_histogram[task][bucket];
+					m_histogram[task][bucket] = offset + count;
+					count += num;
+				}
+
+				if (count == m_num)
+				{
+					return false;
+				}
+
+				offset += count;
+			}
+
+			return true;
+		}
+
+		void sort(WorkerPool& _pool, uint32_t _numTasks)
+		{
+			m_src = 0;
+
+			for (uint32_t pass = 0; pass < kNumPasses; ++pass)
+			{
+				m_shift = pass*kRadixBits;
+
+				_pool.run(histogramTask, this, _numTasks);
+
+				if (prefixSum(_numTasks) )
+				{
+					_pool.run(scatterTask, this, _numTasks);
+					m_src ^= 1;
+				}
+			}
+
+			if (0 != m_src)
+			{
+				bx::memCopy(m_keys[0],   m_keys[1],   m_num*sizeof(uint32_t) );
+				bx::memCopy(m_values[0], m_values[1], m_num*sizeof(uint32_t) );
+			}
+		}
+
+		CalcSortKeysFn  m_calcSortKeys;
+		const uint32_t* m_order;
+		const float*    m_dirOrPos;
+		const void*     m_vertices;
+		const void*     m_indices;
+		void*           m_dst;
+		uint32_t*       m_keys[2];
+		uint32_t*       m_values[2];
+		uint32_t m_stride;
+		uint32_t m_num;
+		uint32_t m_shift;
+		uint32_t m_src;
+
+		uint32_t m_histogram[kMaxTasks][kHistogramSize];
+	};
+
+	static TopologySortMt s_topologySortMt;
+
+	// Scratch memory starts with header, followed by triangle order of last sort, keys and
+	// temporary keys and values used by radix sort.
+	static constexpr uint32_t kTopologySortScratchMagic  = BX_MAKEFOURCC('T', 'S', 'R', 'T');
+	static constexpr uint32_t kTopologySortScratchHeader = 4;
+
+	uint32_t topologySortTriListScratchSize(uint32_t _numIndices)
+	{
+		return (kTopologySortScratchHeader + _numIndices/3*4)*sizeof(uint32_t);
+	}
+
+	template<typename IndexT>
+	static void topologySortTriList(
 		  TopologySort::Enum  _sort
 		, IndexT* _dst
-		, uint32_t* _keys
-		, uint32_t* _values
-		, uint32_t* _tempKeys
-		, uint32_t* _tempValues
+		, uint32_t* _scratch
+		, bool      _coherent
 		, uint32_t  _num
 		, const float _dir[3]
 		, const float _pos[3]
 		, const void* _vertices
 		, uint32_t    _stride
 		, const IndexT* _indices
+		, WorkerPool* _pool
 		)
 	{
-		using namespace bx;
+		uint32_t* header     = _scratch;
+		uint32_t* values     = &_scratch[kTopologySortScratchHeader + _num*0];
+		uint32_t* keys       = &_scratch[kTopologySortScratchHeader + _num*1];
+		uint32_t* tempKeys   = &_scratch[kTopologySortScratchHeader + _num*2];
+		uint32_t* tempValues = &_scratch[kTopologySortScratchHeader + _num*3];
+
+		// Triangle order of previous sort of the same number of triangles is good
+		// starting point when view changes a little between frames.
+		const bool coherent = true
+			&& _coherent
+			&& kTopologySortScratchMagic == header[0]
+			&& _num == header[1]
+			;
 
-		switch (_sort)
+		header[0] = kTopologySortScratchMagic;
+		header[1] = _num;
+
+		const CalcSortKeysFn calcSortKeys = getCalcSortKeysFn<IndexT>(_sort);
+		const float* dirOrPos = isSortByDirection(_sort) ? _dir : _pos;
+
+		const uint32_t numTasks = NULL != _pool
+			? bx::min(_pool->getNumThreads(), _num/TopologySortMt::kMinTrisPerTask)
+			: 1
+			;
+
+		if (1 < numTasks)
 		{
-		default:
-		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		}
+			TopologySortMt& ctx = s_topologySortMt;
+			ctx.m_calcSortKeys = calcSortKeys;
+			ctx.m_order        = NULL;
+			ctx.m_dirOrPos     = dirOrPos;
+			ctx.m_vertices     = _vertices;
+			ctx.m_indices      = _indices;
+			ctx.m_dst          = _dst;
+			ctx.m_keys[0]      = keys;
+			ctx.m_keys[1]      = tempKeys;
+			ctx.m_values[0]    = values;
+			ctx.m_values[1]    = tempValues;
+			ctx.m_stride       = _stride;
+			ctx.m_num          = _num;
+
+			if (coherent)
+			{
+				// Keys are calculated in previous order into temporary buffer, and
+				// copied back since values can't be read and written in place.
+				ctx.m_order     = values;
+				ctx.m_values[0] = tempValues;
+				_pool->run(TopologySortMt::calcSortKeysTask, &ctx, numTasks);
+				bx::memCopy(values, tempValues, _num*sizeof(uint32_t) );
+				ctx.m_order     = NULL;
+				ctx.m_values[0] = values;
+			}
+			else
+			{
+				_pool->run(TopologySortMt::calcSortKeysTask, &ctx, numTasks);
+			}
 
-		radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+			if (!coherent
+			||  !insertionSort(keys, values, _num, _num) )
+			{
+				ctx.sort(*_pool, numTasks);
+			}
 
-		IndexT* sorted = _dst;
+			_pool->run(TopologySortMt::writeTask<IndexT>, &ctx, numTasks);
+			return;
+		}
 
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		if (coherent)
 		{
-			uint32_t face = _values[ii]*3;
-			const IndexT idx0 = _indices[face+0];
-			const IndexT idx1 = _indices[face+1];
-			const IndexT idx2 = _indices[face+2];
-
-			sorted[0] = idx0;
-			sorted[1] = idx1;
-			sorted[2] = idx2;
-			sorted += 3;
+			calcSortKeys(keys, tempValues, values, dirOrPos, _vertices, _stride, _indices, 0, _num);
+			bx::memCopy(values, tempValues, _num*sizeof(uint32_t) );
 		}
+		else
+		{
+			calcSortKeys(keys, values, NULL, dirOrPos, _vertices, _stride, _indices, 0, _num);
+		}
+
+		if (!coherent
+		||  !insertionSort(keys, values, _num, _num) )
+		{
+			bx::radixSort(keys, tempKeys, values, tempValues, _num);
+		}
+
+		writeSortedTriList(_dst, _indices, values, 0, _num);
 	}
 
 	void topologySortTriList(
@@ -389,36 +740,31 @@ namespace bgfx
 		, const void* _indices
 		, uint32_t    _numIndices
 		, bool        _index32
-		, bx::AllocatorI* _allocator
+		, void*       _scratch
+		, bool        _coherent
+		, WorkerPool* _pool
 		)
 	{
 		uint32_t indexSize = _index32
 			? sizeof(uint32_t)
 			: sizeof(uint16_t)
 			;
-		uint32_t  num  = bx::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
-		uint32_t* temp = (uint32_t*)bx::alloc(_allocator, sizeof(uint32_t)*num*4);
-
-		uint32_t* keys       = &temp[num*0];
-		uint32_t* values     = &temp[num*1];
-		uint32_t* tempKeys   = &temp[num*2];
-		uint32_t* tempValues = &temp[num*3];
+		uint32_t num = bx::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
 
 		if (_index32)
 		{
 			topologySortTriList(
 					  _sort
 					, (uint32_t*)_dst
-					, keys
-					, values
-					, tempKeys
-					, tempValues
+					, (uint32_t*)_scratch
+					, _coherent
 					, num
 					, _dir
 					, _pos
 					, _vertices
 					, _stride
 					, (const uint32_t*)_indices
+					, _pool
 					);
 		}
 		else
@@ -426,20 +772,53 @@ namespace bgfx
 			topologySortTriList(
 					  _sort
 					, (uint16_t*)_dst
-					, keys
-					, values
-					, tempKeys
-					, tempValues
+					, (uint32_t*)_scratch
+					, _coherent
 					, num
 					, _dir
 					, _pos
 					, _vertices
 					, _stride
 					, (const uint16_t*)_indices
+					, _pool
 					);
 		}
+	}
 
-		bx::free(_allocator, temp);
+	void topologySortTriList(
+		  TopologySort::Enum  _sort
+		, void*       _dst
+		, uint32_t    _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t    _stride
+		, const void* _indices
+		, uint32_t    _numIndices
+		, bool        _index32
+		, bx::AllocatorI* _allocator
+		, WorkerPool* _pool
+		)
+	{
+		void* scratch = bx::alloc(_allocator, topologySortTriListScratchSize(_numIndices) );
+
+		topologySortTriList(
+			  _sort
+			, _dst
+			, _dstSize
+			, _dir
+			, _pos
+			, _vertices
+			, _stride
+			, _indices
+			, _numIndices
+			, _index32
+			, scratch
+			, false
+			, _pool
+			);
+
+		bx::free(_allocator, scratch);
 	}
 
 } //namespace bgfx
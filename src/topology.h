@@ -10,6 +10,8 @@
 
 namespace bgfx
 {
+	class WorkerPool;
+
 	/// Convert index buffer for use with different primitive topologies.
 	///
 	/// @param[in] _conversion Conversion type, see `TopologyConvert::Enum`.
@@ -36,6 +38,30 @@ namespace bgfx
 		, bx::AllocatorI* _allocator
 		);
 
+	/// Returns size of scratch memory in bytes required to sort `_numIndices` indices.
+	///
+	uint32_t topologySortTriListScratchSize(uint32_t _numIndices);
+
+	/// Sort indices using caller provided scratch memory. When `_coherent` is set, triangle
+	/// order from previous sort stored in scratch memory is used as starting point. If
+	/// `_pool` is not NULL it must be owned by the caller, and it's used to split work.
+	///
+	void topologySortTriList(
+		  TopologySort::Enum _sort
+		, void* _dst
+		, uint32_t _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t _stride
+		, const void* _indices
+		, uint32_t _numIndices
+		, bool _index32
+		, void* _scratch
+		, bool _coherent
+		, WorkerPool* _pool
+		);
+
 	///
 	void topologySortTriList(
 		  TopologySort::Enum _sort
@@ -49,6 +75,7 @@ namespace bgfx
 		, uint32_t _numIndices
 		, bool _index32
 		, bx::AllocatorI* _allocator
+		, WorkerPool* _pool
 		);
 
 } // namespace bgfx
@@ -6,6 +6,7 @@
 #include <bx/debug.h>
 #include <bx/hash.h>
 #include <bx/readerwriter.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/string.h>
 #include <bx/uint32_t.h>
@@ -625,6 +626,375 @@ namespace bgfx
 		}
 	}
 
+	/// Number of vertices converted per kernel call.
+	static constexpr uint32_t kConvertBlockSize = 64;
+
+	/// Unpacks `_num` attributes into block of float4, unused components are set to zero.
+	typedef void (*UnpackBlockFn)(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num);
+
+	/// Packs `_num` float4 from block into attributes.
+	typedef void (*PackBlockFn)(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num);
+
+	inline bx::simd128_t simdComponentMask(uint32_t _numComp)
+	{
+		return bx::simd_ild<bx::simd128_t>(
+			  0 < _numComp ? UINT32_MAX : 0
+			, 1 < _numComp ? UINT32_MAX : 0
+			, 2 < _numComp ? UINT32_MAX : 0
+			, 3 < _numComp ? UINT32_MAX : 0
+			);
+	}
+
+	/// _output = (_output + _bias) / _div, with components past `_numComp` cleared.
+	static void unpackBlockNormalize(float* _output, uint32_t _num, uint32_t _numComp, float _bias, float _div)
+	{
+		using namespace bx;
+
+		const simd128_t bias = simd_splat(_bias);
+		const simd128_t div  = simd_splat(_div);
+		const simd128_t mask = simdComponentMask(_numComp);
+
+		for (uint32_t ii = 0; ii < _num; ++ii, _output += 4)
+		{
+			const simd128_t value  = simd_ld<simd128_t>(_output);
+			const simd128_t biased = simd_add(value, bias);
+			const simd128_t result = simd_div(biased, div);
+			simd_st(_output, simd_and(result, mask) );
+		}
+	}
+
+	/// _output = _input * _scale + _bias, converted to integer with truncation like scalar cast.
+	static void packBlockScale(int32_t* _output, const float* _input, uint32_t _num, float _scale, float _bias)
+	{
+		using namespace bx;
+
+		const simd128_t scale = simd_splat(_scale);
+		const simd128_t bias  = simd_splat(_bias);
+
+		for (uint32_t ii = 0; ii < _num; ++ii, _input += 4, _output += 4)
+		{
+			const simd128_t value  = simd_ld<simd128_t>(_input);
+			const simd128_t scaled = simd_mul(value, scale);
+			simd_st(_output, simd_ftoi(simd_add(scaled, bias) ) );
+		}
+	}
+
+	inline bool simdAnyLane(bx::simd128_t _mask)
+	{
+		BX_ALIGN_DECL_16(uint32_t) lanes[4];
+		bx::simd_st(lanes, _mask);
+		return 0 != (lanes[0] | lanes[1] | lanes[2] | lanes[3]);
+	}
+
+	/// Converts half floats from low 16 bits of lanes to floats. Zero and normal values are
+	/// exact, lanes with denormal, infinity or NaN are flagged in `_special`.
+	inline bx::simd128_t simdHalfToFloat(bx::simd128_t _half, bx::simd128_t& _special)
+	{
+		using namespace bx;
+
+		const simd128_t zero     = simd_zero<simd128_t>();
+		const simd128_t expMask  = simd_isplat<simd128_t>(0x7c00);
+		const simd128_t absolute = simd_and(_half, simd_isplat<simd128_t>(0x7fff) );
+		const simd128_t exponent = simd_and(_half, expMask);
+		const simd128_t isZero   = simd_icmpeq(absolute, zero);
+		const simd128_t isDenorm = simd_andc(simd_icmpeq(exponent, zero), isZero);
+		_special = simd_or(isDenorm, simd_icmpeq(exponent, expMask) );
+
+		// Exponent is rebiased from 15 to 127.
+		const simd128_t normal = simd_iadd(simd_sll(absolute, 13), simd_isplat<simd128_t>(0x38000000) );
+		const simd128_t sign   = simd_sll(simd_and(_half, simd_isplat<simd128_t>(0x8000) ), 16);
+		return simd_or(simd_andc(normal, isZero), sign);
+	}
+
+	/// Converts floats to half floats in low 16 bits of lanes, mantissa is rounded half up like
+	/// bx::halfFromFloat. Only zero and values in normal half range are converted, other lanes
+	/// are flagged in `_special`.
+	inline bx::simd128_t simdHalfFromFloat(bx::simd128_t _float, bx::simd128_t& _special)
+	{
+		using namespace bx;
+
+		const simd128_t absolute = simd_and(_float, simd_isplat<simd128_t>(0x7fffffff) );
+		const simd128_t isZero   = simd_icmpeq(absolute, simd_zero<simd128_t>() );
+
+		// Normal half range is [2^-14, 65520), anything larger rounds to infinity.
+		const simd128_t isNormal = simd_and(
+			  simd_icmpgt(absolute, simd_isplat<simd128_t>(0x387fffff) )
+			, simd_icmplt(absolute, simd_isplat<simd128_t>(0x477ff000) )
+			);
+		_special = simd_xor(simd_or(isNormal, isZero), simd_isplat<simd128_t>(UINT32_MAX) );
+
+		// Exponent is rebiased from 127 to 15, and half of dropped mantissa LSB is added.
+		const simd128_t rounded = simd_iadd(absolute, simd_isplat<simd128_t>(0xc8001000) );
+		const simd128_t result  = simd_andc(simd_srl(rounded, 13), isZero);
+		const simd128_t sign    = simd_srl(simd_and(_float, simd_isplat<simd128_t>(0x80000000) ), 16);
+		return simd_or(result, sign);
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void unpackBlockUint8(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num)
+	{
+		using namespace bx;
+
+		// Each lane masks its byte in place and scales it down by byte position, which is exact.
+		// Top byte is shifted down instead, so that integer stays positive.
+		const simd128_t mask  = simd_ild<simd128_t>(0xff, 0xff00, 0xff0000, 0);
+		const simd128_t top   = simd_ild<simd128_t>(0, 0, 0, 0xff);
+		const simd128_t scale = simd_ld<simd128_t>(1.0f, 1.0f/256.0f, 1.0f/65536.0f, 1.0f);
+
+		float* output = _output;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, output += 4)
+		{
+			uint32_t packed = 0;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				packed |= uint32_t(_data[jj]) << (jj*8);
+			}
+
+			const simd128_t word  = simd_isplat<simd128_t>(packed);
+			const simd128_t bytes = simd_or(simd_and(word, mask), simd_and(simd_srl(word, 24), top) );
+			simd_st(output, simd_mul(simd_itof(bytes), scale) );
+		}
+
+		unpackBlockNormalize(_output, _num, NumT, AsIntT ? -128.0f : 0.0f, AsIntT ? 127.0f : 255.0f);
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void packBlockUint8(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num)
+	{
+		BX_ALIGN_DECL_16(int32_t) scaled[kConvertBlockSize*4];
+		packBlockScale(scaled, _input, _num, AsIntT ? 127.0f : 255.0f, AsIntT ? 128.0f : 0.0f);
+
+		const int32_t* input = scaled;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, input += 4)
+		{
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				_data[jj] = uint8_t(input[jj]);
+			}
+		}
+	}
+
+	// Uint10 keeps vertexPack/vertexUnpack component order, first component is packed in
+	// the highest used bits, and unpacked from the lowest bits. Only 3 components are used.
+	template<uint32_t NumT, bool AsIntT>
+	static void unpackBlockUint10(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num)
+	{
+		using namespace bx;
+
+		constexpr uint32_t kNum = NumT < 3 ? NumT : 3;
+
+		// Same as Uint8, each lane masks its 10 bits in place and scales them down.
+		const simd128_t mask  = simd_ild<simd128_t>(0x3ff, 0x3ff<<10, 0x3ff<<20, 0);
+		const simd128_t scale = simd_ld<simd128_t>(1.0f, 1.0f/1024.0f, 1.0f/1048576.0f, 0.0f);
+
+		float* output = _output;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, output += 4)
+		{
+			const simd128_t word = simd_isplat<simd128_t>(*(const uint32_t*)_data);
+			simd_st(output, simd_mul(simd_itof(simd_and(word, mask) ), scale) );
+		}
+
+		unpackBlockNormalize(_output, _num, kNum, AsIntT ? -512.0f : 0.0f, AsIntT ? 511.0f : 1023.0f);
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void packBlockUint10(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num)
+	{
+		constexpr uint32_t kNum = NumT < 3 ? NumT : 3;
+
+		BX_ALIGN_DECL_16(int32_t) scaled[kConvertBlockSize*4];
+		packBlockScale(scaled, _input, _num, AsIntT ? 511.0f : 1023.0f, AsIntT ? 512.0f : 0.0f);
+
+		const int32_t* input = scaled;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, input += 4)
+		{
+			uint32_t packed = 0;
+
+			for (uint32_t jj = 0; jj < kNum; ++jj)
+			{
+				packed <<= 10;
+				packed |= uint32_t(input[jj]);
+			}
+
+			*(uint32_t*)_data = packed;
+		}
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void unpackBlockInt16(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num)
+	{
+		using namespace bx;
+
+		// Pairs of components are loaded as 32-bit words, and sign extended from low half in
+		// even lanes and from high half in odd lanes.
+		const simd128_t even = simd_ild<simd128_t>(UINT32_MAX, 0, UINT32_MAX, 0);
+
+		float* output = _output;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, output += 4)
+		{
+			const uint16_t* packed = (const uint16_t*)_data;
+
+			const uint32_t xy = 1 < NumT ? packed[0] | uint32_t(packed[1])<<16 : packed[0];
+			const uint32_t zw = 3 < NumT ? packed[2] | uint32_t(packed[3])<<16 : 2 < NumT ? packed[2] : 0;
+
+			const simd128_t words = simd_ild<simd128_t>(xy, xy, zw, zw);
+			const simd128_t low   = simd_sra(simd_sll(words, 16), 16);
+			const simd128_t high  = simd_sra(words, 16);
+			simd_st(output, simd_itof(simd_selb(even, low, high) ) );
+		}
+
+		unpackBlockNormalize(_output, _num, NumT, AsIntT ? 0.0f : 32768.0f, AsIntT ? 32767.0f : 65535.0f);
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void packBlockInt16(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num)
+	{
+		BX_ALIGN_DECL_16(int32_t) scaled[kConvertBlockSize*4];
+		packBlockScale(scaled, _input, _num, AsIntT ? 32767.0f : 65535.0f, AsIntT ? 0.0f : -32768.0f);
+
+		const int32_t* input = scaled;
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, input += 4)
+		{
+			int16_t* packed = (int16_t*)_data;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				packed[jj] = int16_t(input[jj]);
+			}
+		}
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void unpackBlockHalf(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num)
+	{
+		using namespace bx;
+
+		simd128_t special = simd_zero<simd128_t>();
+
+		const uint8_t* data = _data;
+		float* output = _output;
+		for (uint32_t ii = 0; ii < _num; ++ii, data += _stride, output += 4)
+		{
+			const uint16_t* packed = (const uint16_t*)data;
+
+			const simd128_t bits = simd_ild<simd128_t>(
+				  packed[0]
+				, 1 < NumT ? packed[1] : 0
+				, 2 < NumT ? packed[2] : 0
+				, 3 < NumT ? packed[3] : 0
+				);
+
+			simd128_t laneSpecial;
+			simd_st(output, simdHalfToFloat(bits, laneSpecial) );
+			special = simd_or(special, laneSpecial);
+		}
+
+		// Rare denormal, infinity or NaN values, whole block is redone with scalar conversion.
+		if (simdAnyLane(special) )
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, _output += 4)
+			{
+				const uint16_t* packed = (const uint16_t*)_data;
+
+				for (uint32_t jj = 0; jj < NumT; ++jj)
+				{
+					_output[jj] = bx::halfToFloat(packed[jj]);
+				}
+			}
+		}
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void packBlockHalf(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num)
+	{
+		using namespace bx;
+
+		const simd128_t mask = simdComponentMask(NumT);
+		simd128_t special = simd_zero<simd128_t>();
+
+		BX_ALIGN_DECL_16(uint32_t) bits[4];
+
+		uint8_t* data = _data;
+		const float* input = _input;
+		for (uint32_t ii = 0; ii < _num; ++ii, data += _stride, input += 4)
+		{
+			simd128_t laneSpecial;
+			simd_st(bits, simdHalfFromFloat(simd_ld<simd128_t>(input), laneSpecial) );
+			special = simd_or(special, simd_and(laneSpecial, mask) );
+
+			uint16_t* packed = (uint16_t*)data;
+
+			for (uint32_t jj = 0; jj < NumT; ++jj)
+			{
+				packed[jj] = uint16_t(bits[jj]);
+			}
+		}
+
+		// Rare values outside of normal half range, whole block is redone with scalar conversion.
+		if (simdAnyLane(special) )
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, _input += 4)
+			{
+				uint16_t* packed = (uint16_t*)_data;
+
+				for (uint32_t jj = 0; jj < NumT; ++jj)
+				{
+					packed[jj] = bx::halfFromFloat(_input[jj]);
+				}
+			}
+		}
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void unpackBlockFloat(float* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, _output += 4)
+		{
+			const float* packed = (const float*)_data;
+
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				_output[jj] = jj < NumT ? packed[jj] : 0.0f;
+			}
+		}
+	}
+
+	template<uint32_t NumT, bool AsIntT>
+	static void packBlockFloat(uint8_t* _data, uint32_t _stride, const float* _input, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride, _input += 4)
+		{
+			bx::memCopy(_data, _input, NumT*sizeof(float) );
+		}
+	}
+
+#define BGFX_CONVERT_KERNELS(_fn)                                          \
+		{                                                                  \
+			{ _fn<1, false>, _fn<2, false>, _fn<3, false>, _fn<4, false> }, \
+			{ _fn<1, true>,  _fn<2, true>,  _fn<3, true>,  _fn<4, true>  }, \
+		}
+
+	static const UnpackBlockFn s_unpackBlock[AttribType::Count][2][4] =
+	{
+		BGFX_CONVERT_KERNELS(unpackBlockUint8),  // Uint8
+		BGFX_CONVERT_KERNELS(unpackBlockUint10), // Uint10
+		BGFX_CONVERT_KERNELS(unpackBlockInt16),  // Int16
+		BGFX_CONVERT_KERNELS(unpackBlockHalf),   // Half
+		BGFX_CONVERT_KERNELS(unpackBlockFloat),  // Float
+	};
+
+	static const PackBlockFn s_packBlock[AttribType::Count][2][4] =
+	{
+		BGFX_CONVERT_KERNELS(packBlockUint8),  // Uint8
+		BGFX_CONVERT_KERNELS(packBlockUint10), // Uint10
+		BGFX_CONVERT_KERNELS(packBlockInt16),  // Int16
+		BGFX_CONVERT_KERNELS(packBlockHalf),   // Half
+		BGFX_CONVERT_KERNELS(packBlockFloat),  // Float
+	};
+
+#undef BGFX_CONVERT_KERNELS
+
 	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
 	{
 		if (_destLayout.m_hash == _srcLayout.m_hash)
@@ -635,7 +1005,8 @@ namespace bgfx
 
 		struct ConvertOp
 		{
-			Attrib::Enum attr;
+			UnpackBlockFn unpack;
+			PackBlockFn pack;
 			uint32_t src;
 			uint32_t dest;
 			uint32_t size;
@@ -657,7 +1028,6 @@ namespace bgfx
 			if (_destLayout.has(attr) )
 			{
 				ConvertOp& cop = convertOp[numOps];
-				cop.attr = attr;
 				cop.dest = _destLayout.getOffset(attr);
 
 				uint8_t num;
@@ -666,11 +1036,15 @@ namespace bgfx
 				bool asInt;
 				_destLayout.decode(attr, num, type, normalized, asInt);
 				cop.size = (*s_attribTypeSize[0])[type][num-1];
+				cop.pack = s_packBlock[type][asInt][num-1];
 
 				if (_srcLayout.has(attr) )
 				{
 					cop.src = _srcLayout.getOffset(attr);
 
+					_srcLayout.decode(attr, num, type, normalized, asInt);
+					cop.unpack = s_unpackBlock[type][asInt][num-1];
+
 					if (_destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr])
 					{
 						bx::memCopy(dest + cop.dest, destStride, src + cop.src, srcStride, cop.size, _num);
@@ -689,19 +1063,21 @@ namespace bgfx
 
 		if (0 < numOps)
 		{
-			float unpacked[4];
+			BX_ALIGN_DECL_16(float) unpacked[kConvertBlockSize*4];
 
-			for (uint32_t ii = 0; ii < _num; ++ii)
+			for (uint32_t ii = 0; ii < _num; ii += kConvertBlockSize)
 			{
+				const uint32_t num = bx::min(kConvertBlockSize, _num - ii);
+
 				for (uint32_t jj = 0; jj < numOps; ++jj)
 				{
 					const ConvertOp& cop = convertOp[jj];
-					vertexUnpack(unpacked, cop.attr, _srcLayout, src);
-					vertexPack(unpacked, true, cop.attr, _destLayout, dest);
+					cop.unpack(unpacked, src + cop.src, srcStride, num);
+					cop.pack(dest + cop.dest, destStride, unpacked, num);
 				}
 
-				src  += srcStride;
-				dest += destStride;
+				src  += num*srcStride;
+				dest += num*destStride;
 			}
 		}
 	}
@@ -756,42 +1132,125 @@ namespace bgfx
 		return IndexT(numVertices);
 	}
 
+	/// Number of bits per axis of spatial hash grid cell coordinates used by vertex welding.
+	static constexpr uint32_t kWeldGridBits = 21;
+
+	inline uint32_t weldCellHash(uint32_t _x, uint32_t _y, uint32_t _z)
+	{
+		return (_x*73856093u) ^ (_y*19349663u) ^ (_z*83492791u);
+	}
+
 	template<typename IndexT>
 	static IndexT weldVertices(IndexT* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon, bx::AllocatorI* _allocator)
 	{
+		using namespace bx;
+
+		if (0 == _num)
+		{
+			return 0;
+		}
+
 		const uint32_t hashSize = bx::uint32_nextpow2(_num);
 		const uint32_t hashMask = hashSize-1;
 		const float epsilonSq = _epsilon*_epsilon;
 
 		uint32_t numVertices = 0;
 
-		const uint32_t size = sizeof(IndexT)*(hashSize + _num);
-		IndexT* hashTable = (IndexT*)bx::alloc(_allocator, size);
-		bx::memSet(hashTable, 0xff, size);
+		const uint32_t posSize = _num*4*sizeof(float);
+		const uint32_t size    = posSize + sizeof(IndexT)*(hashSize + _num);
+		float* positions = (float*)bx::alignedAlloc(_allocator, size, 16);
+
+		IndexT* hashTable = (IndexT*)( (uint8_t*)positions + posSize);
+		bx::memSet(hashTable, 0xff, sizeof(IndexT)*(hashSize + _num) );
 
 		IndexT* next = hashTable + hashSize;
 
+		// Decode all positions in blocks into float4 array.
+		if (_layout.has(Attrib::Position) )
+		{
+			uint8_t num;
+			AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_layout.decode(Attrib::Position, num, type, normalized, asInt);
+			const UnpackBlockFn unpack = s_unpackBlock[type][asInt][num-1];
+
+			const uint32_t stride = _layout.getStride();
+			const uint8_t* src = (const uint8_t*)_data + _layout.getOffset(Attrib::Position);
+
+			for (uint32_t ii = 0; ii < _num; ii += kConvertBlockSize)
+			{
+				const uint32_t numBlock = bx::min(kConvertBlockSize, _num - ii);
+				unpack(&positions[ii*4], src + ii*stride, stride, numBlock);
+			}
+		}
+		else
+		{
+			bx::memSet(positions, 0, posSize);
+		}
+
+		simd128_t vmin = simd_ld<simd128_t>(positions);
+		simd128_t vmax = vmin;
+
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const simd128_t pos = simd_ld<simd128_t>(&positions[ii*4]);
+			vmin = simd_min(vmin, pos);
+			vmax = simd_max(vmax, pos);
+		}
+
+		BX_ALIGN_DECL_16(float) bbMin[4];
+		BX_ALIGN_DECL_16(float) bbMax[4];
+		simd_st(bbMin, vmin);
+		simd_st(bbMax, vmax);
+
+		// Cell is at least twice the epsilon, so any vertex within epsilon is either in the
+		// same cell, or in neighbouring cell on the side closer to the vertex, which means
+		// only 2x2x2 cells need to be checked. Cell is also large enough that grid coordinates
+		// fit in kWeldGridBits.
+		const float extent   = bx::max(bbMax[0]-bbMin[0], bbMax[1]-bbMin[1], bbMax[2]-bbMin[2]);
+		const float cellSize = bx::max(_epsilon*2.0f, extent/float( (1<<kWeldGridBits)-1) );
+		const float invCell  = 0.0f < cellSize ? 1.0f/cellSize : 0.0f;
+		const uint32_t maxCell = (1<<kWeldGridBits)-1;
+
 		for (uint32_t ii = 0; ii < _num; ++ii)
 		{
-			float pos[4];
-			vertexUnpack(pos, Attrib::Position, _layout, _data, ii);
-			uint32_t hashValue = bx::hash<bx::HashMurmur2A>(pos, 3*sizeof(float) ) & hashMask;
+			const float* pos = &positions[ii*4];
+
+			uint32_t cell[3];
+			uint32_t side[3];
 
-			IndexT offset = hashTable[hashValue];
-			for (; IndexT(-1) != offset; offset = next[offset])
+			for (uint32_t jj = 0; jj < 3; ++jj)
 			{
-				float test[4];
-				vertexUnpack(test, Attrib::Position, _layout, _data, _output[offset]);
+				const float grid = (pos[jj] - bbMin[jj])*invCell;
+				cell[jj] = bx::min(uint32_t(grid), maxCell);
+				side[jj] = grid - float(cell[jj]) < 0.5f ? cell[jj]-1 : cell[jj]+1;
+			}
 
-				if (sqLength(test, pos) < epsilonSq)
+			IndexT offset = IndexT(-1);
+
+			for (uint32_t jj = 0; jj < 8 && IndexT(-1) == offset; ++jj)
+			{
+				const uint32_t hashValue = weldCellHash(
+					  jj&1 ? side[0] : cell[0]
+					, jj&2 ? side[1] : cell[1]
+					, jj&4 ? side[2] : cell[2]
+					) & hashMask;
+
+				for (offset = hashTable[hashValue]; IndexT(-1) != offset; offset = next[offset])
 				{
-					_output[ii] = _output[offset];
-					break;
+					if (sqLength(&positions[offset*4], pos) < epsilonSq)
+					{
+						_output[ii] = offset;
+						break;
+					}
 				}
 			}
 
 			if (IndexT(-1) == offset)
 			{
+				const uint32_t hashValue = weldCellHash(cell[0], cell[1], cell[2]) & hashMask;
+
 				_output[ii] = IndexT(ii);
 				next[ii] = hashTable[hashValue];
 				hashTable[hashValue] = IndexT(ii);
@@ -799,7 +1258,7 @@ namespace bgfx
 			}
 		}
 
-		bx::free(_allocator, hashTable);
+		bx::alignedFree(_allocator, positions, 16);
 
 		return IndexT(numVertices);
 	}
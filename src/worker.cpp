@@ -0,0 +1,137 @@
+/*
+ * Copyright 2011-2024 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#include <bx/cpu.h>
+#include <bx/string.h>
+
+#include "worker.h"
+
+namespace bgfx
+{
+	WorkerPool::WorkerPool()
+		: m_fn(NULL)
+		, m_userData(NULL)
+		, m_numTasks(0)
+		, m_nextTask(0)
+		, m_numThreads(0)
+		, m_owned(0)
+		, m_exit(false)
+	{
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		shutdown();
+	}
+
+	void WorkerPool::init(uint32_t _numThreads, const char* _name)
+	{
+		shutdown();
+
+		m_exit = false;
+
+#if BGFX_CONFIG_MULTITHREADED
+		m_numThreads = bx::min<uint32_t>(_numThreads, BGFX_CONFIG_MAX_WORKER_THREADS);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			char name[64];
+			bx::snprintf(name, BX_COUNTOF(name), "%s %d", _name, ii);
+			m_thread[ii].init(threadFunc, this, 0, name);
+		}
+#else
+		BX_UNUSED(_numThreads, _name);
+		m_numThreads = 0;
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	void WorkerPool::shutdown()
+	{
+		if (0 < m_numThreads)
+		{
+			m_exit = true;
+			m_start.post(m_numThreads);
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+
+			m_numThreads = 0;
+		}
+	}
+
+	void WorkerPool::run(TaskFn _fn, void* _userData, uint32_t _num)
+	{
+		if (0 == m_numThreads
+		||  1 >= _num)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_fn(_userData, ii, _num);
+			}
+
+			return;
+		}
+
+		m_fn       = _fn;
+		m_userData = _userData;
+		m_numTasks = _num;
+		m_nextTask = 0;
+
+		const uint32_t numThreads = bx::min(m_numThreads, _num-1);
+		m_start.post(numThreads);
+
+		execute();
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			m_done.wait();
+		}
+	}
+
+	bool WorkerPool::tryAcquire()
+	{
+		return 0 == bx::atomicCompareAndSwap<uint32_t>(&m_owned, 0, 1);
+	}
+
+	void WorkerPool::release()
+	{
+		BX_ASSERT(0 != m_owned, "Releasing worker pool that is not owned.");
+		bx::atomicCompareAndSwap<uint32_t>(&m_owned, 1, 0);
+	}
+
+	int32_t WorkerPool::threadFunc(bx::Thread* /*_thread*/, void* _userData)
+	{
+		WorkerPool* pool = (WorkerPool*)_userData;
+
+		for (;;)
+		{
+			pool->m_start.wait();
+
+			if (pool->m_exit)
+			{
+				break;
+			}
+
+			pool->execute();
+			pool->m_done.post();
+		}
+
+		return 0;
+	}
+
+	void WorkerPool::execute()
+	{
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_nextTask, 1)
+			; idx < m_numTasks
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&m_nextTask, 1)
+			)
+		{
+			m_fn(m_userData, idx, m_numTasks);
+		}
+	}
+
+} // namespace bgfx
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2011-2024 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx/blob/master/LICENSE
+ */
+
+#ifndef BGFX_WORKER_H_HEADER_GUARD
+#define BGFX_WORKER_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+#include "config.h"
+
+namespace bgfx
+{
+	/// Small fixed size pool of threads used to split internal work into
+	/// parallel tasks. Calling thread always participates in the work, so pool
+	/// without worker threads executes all tasks serially.
+	///
+	class WorkerPool
+	{
+	public:
+		/// Task function, `_idx` is task index in range [0, `_num`).
+		typedef void (*TaskFn)(void* _userData, uint32_t _idx, uint32_t _num);
+
+		///
+		WorkerPool();
+
+		///
+		~WorkerPool();
+
+		/// Start `_numThreads` worker threads.
+		void init(uint32_t _numThreads, const char* _name);
+
+		/// Stop all worker threads.
+		void shutdown();
+
+		/// Execute `_num` tasks and wait until all of them are done.
+		void run(TaskFn _fn, void* _userData, uint32_t _num);
+
+		/// Try to take exclusive ownership of pool shared between multiple
+		/// users. Only owner may call `run`.
+		bool tryAcquire();
+
+		/// Release ownership taken by `tryAcquire`.
+		void release();
+
+		/// Returns number of threads executing tasks, including calling thread.
+		uint32_t getNumThreads() const
+		{
+			return m_numThreads + 1;
+		}
+
+	private:
+		static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+
+		void execute();
+
+		bx::Thread    m_thread[BGFX_CONFIG_MAX_WORKER_THREADS];
+		bx::Semaphore m_start;
+		bx::Semaphore m_done;
+
+		TaskFn   m_fn;
+		void*    m_userData;
+		uint32_t m_numTasks;
+		uint32_t m_nextTask;
+		uint32_t m_numThreads;
+		uint32_t m_owned;
+		bool     m_exit;
+	};
+
+} // namespace bgfx
+
+#endif // BGFX_WORKER_H_HEADER_GUARD
@@ -5,7 +5,12 @@
 
 #include "shaderc.h"
 #include <bx/commandline.h>
+#include <bx/cpu.h>
 #include <bx/filepath.h>
+#include <bx/mutex.h>
+#include <bx/thread.h>
+
+#include <thread>
 
 #define MAX_TAGS 256
 extern "C"
@@ -19,7 +24,7 @@ extern "C"
 #define BGFX_CHUNK_MAGIC_VSH BX_MAKEFOURCC('V', 'S', 'H', BGFX_SHADER_BIN_VERSION)
 
 #define BGFX_SHADERC_VERSION_MAJOR 1
-#define BGFX_SHADERC_VERSION_MINOR 18
+#define BGFX_SHADERC_VERSION_MINOR 19
 
 namespace bgfx
 {
@@ -620,55 +625,63 @@ namespace bgfx
 
 	typedef std::unordered_map<std::string, Varying> VaryingMap;
 
-	class File
+	/// Cache of input files shared between compile jobs, each file is read from disk only once.
+	/// Safe to call from multiple threads.
+	class FileCache
 	{
 	public:
-		File()
-			: m_data(NULL)
-			, m_size(0)
+		/// Returns file content without UTF-8 BOM, or NULL if file can't be opened.
+		const std::string* load(const char* _filePath)
 		{
-		}
+			const std::string key(_filePath);
 
-		~File()
-		{
-			delete [] m_data;
-		}
+			{
+				bx::MutexScope scope(m_mutex);
+				FileMap::const_iterator it = m_files.find(key);
+				if (it != m_files.end() )
+				{
+					return it->second.m_valid ? &it->second.m_data : NULL;
+				}
+			}
+
+			Entry entry;
+			entry.m_valid = false;
 
-		void load(const bx::FilePath& _filePath)
-		{
 			bx::FileReader reader;
 			if (bx::open(&reader, _filePath) )
 			{
-				m_size = (uint32_t)bx::getSize(&reader);
-				m_data = new char[m_size+1];
-				m_size = (uint32_t)bx::read(&reader, m_data, m_size, bx::ErrorAssert{});
+				uint32_t size = (uint32_t)bx::getSize(&reader);
+				entry.m_data.resize(size);
+				size = (uint32_t)bx::read(&reader, &entry.m_data[0], size, bx::ErrorAssert{});
+				entry.m_data.resize(size);
+				entry.m_valid = true;
 				bx::close(&reader);
 
-				if (m_data[0] == '\xef'
-				&&  m_data[1] == '\xbb'
-				&&  m_data[2] == '\xbf')
+				if (3 <= size
+				&&  entry.m_data[0] == '\xef'
+				&&  entry.m_data[1] == '\xbb'
+				&&  entry.m_data[2] == '\xbf')
 				{
-					bx::memMove(m_data, &m_data[3], m_size-3);
-					m_size -= 3;
+					entry.m_data.erase(0, 3);
 				}
-
-				m_data[m_size] = '\0';
 			}
-		}
 
-		const char* getData() const
-		{
-			return m_data;
+			bx::MutexScope scope(m_mutex);
+			FileMap::const_iterator it = m_files.emplace(key, std::move(entry) ).first;
+			return it->second.m_valid ? &it->second.m_data : NULL;
 		}
 
-		uint32_t getSize() const
+	private:
+		struct Entry
 		{
-			return m_size;
-		}
+			std::string m_data;
+			bool m_valid;
+		};
 
-	private:
-		char* m_data;
-		uint32_t m_size;
+		typedef std::unordered_map<std::string, Entry> FileMap;
+
+		bx::Mutex m_mutex;
+		FileMap m_files;
 	};
 
 	char* strInsert(char* _str, const char* _insert)
@@ -707,9 +720,9 @@ namespace bgfx
 		strReplace(_str, "\r",   "\n");
 	}
 
-	void printCode(const char* _code, int32_t _line, int32_t _start, int32_t _end, int32_t _column)
+	void printCode(bx::WriterI* _messageWriter, const char* _code, int32_t _line, int32_t _start, int32_t _end, int32_t _column)
 	{
-		bx::printf("Code:\n---\n");
+		writef(_messageWriter, "Code:\n---\n");
 
 		bx::LineReader reader(_code);
 		for (int32_t line = 1; !reader.isDone() && line < _end; ++line)
@@ -720,22 +733,22 @@ namespace bgfx
 			{
 				if (_line == line)
 				{
-					bx::printf("\n");
-					bx::printf(">>> %3d: %.*s\n", line, strLine.getLength(), strLine.getPtr() );
+					writef(_messageWriter, "\n");
+					writef(_messageWriter, ">>> %3d: %.*s\n", line, strLine.getLength(), strLine.getPtr() );
 					if (-1 != _column)
 					{
-						bx::printf(">>> %3d: %*s\n", _column, _column, "^");
+						writef(_messageWriter, ">>> %3d: %*s\n", _column, _column, "^");
 					}
-					bx::printf("\n");
+					writef(_messageWriter, "\n");
 				}
 				else
 				{
-					bx::printf("    %3d: %.*s\n", line, strLine.getLength(), strLine.getPtr() );
+					writef(_messageWriter, "    %3d: %.*s\n", line, strLine.getLength(), strLine.getPtr() );
 				}
 			}
 		}
 
-		bx::printf("---\n");
+		writef(_messageWriter, "---\n");
 	}
 
 	void writeFile(const char* _filePath, const void* _data, int32_t _size)
@@ -1047,6 +1060,11 @@ namespace bgfx
 			  "      --stdout                  Output to console.\n"
 			  "      --bin2c [array name]      Generate C header file. If array name is not specified base file name will be used as name.\n"
 			  "      --depends                 Generate makefile style depends file.\n"
+			  "      --batch <file path>       Compile all jobs listed in manifest file in single process. Each line\n"
+			  "                                holds regular shaderc options. -p and --define can be repeated to\n"
+			  "                                compile every profile and define set combination, output file name\n"
+			  "                                must contain {profile} and {variant} in that case.\n"
+			  "  -j <num>                      Number of batch compile threads. Defaults to number of CPU cores.\n"
 			  "      --platform <platform>     Target platform.\n"
 			  "           android\n"
 			  "           asm.js\n"
@@ -2646,34 +2664,44 @@ namespace bgfx
 		return compiled;
 	}
 
-	int compileShader(int _argc, const char* _argv[])
+	class StringWriter : public bx::WriterI
 	{
-		bx::CommandLine cmdLine(_argc, _argv);
+	public:
+		virtual ~StringWriter()
+		{
+		}
 
-		if (cmdLine.hasArg('v', "version") )
+		virtual int32_t write(const void* _data, int32_t _size, bx::Error*) override
 		{
-			bx::printf(
-				  "shaderc, bgfx shader compiler tool, version %d.%d.%d.\n"
-				, BGFX_SHADERC_VERSION_MAJOR
-				, BGFX_SHADERC_VERSION_MINOR
-				, BGFX_API_VERSION
-				);
-			return bx::kExitSuccess;
+			m_data.append( (const char*)_data, _size);
+			return _size;
 		}
 
-		if (cmdLine.hasArg('h', "help") )
+		std::string m_data;
+	};
+
+	int usageError(bool _batch, bx::WriterI* _messageWriter, const char* _error)
+	{
+		if (_batch)
 		{
-			help();
-			return bx::kExitFailure;
+			writef(_messageWriter, "Error: %s\n", _error);
+		}
+		else
+		{
+			help(_error);
 		}
 
-		g_verbose = cmdLine.hasArg("verbose");
+		return bx::kExitFailure;
+	}
+
+	int compileShader(const bx::CommandLine& _cmdLine, FileCache& _fileCache, bx::WriterI* _messageWriter, bool _batch)
+	{
+		const bx::CommandLine& cmdLine = _cmdLine;
 
 		const char* filePath = cmdLine.findOption('f');
 		if (NULL == filePath)
 		{
-			help("Shader file name must be specified.");
-			return bx::kExitFailure;
+			return usageError(_batch, _messageWriter, "Shader file name must be specified.");
 		}
 
 		bool consoleOut = cmdLine.hasArg("stdout");
@@ -2681,15 +2709,19 @@ namespace bgfx
 		if (NULL == outFilePath
 		&&  !consoleOut)
 		{
-			help("Output file name must be specified or use \"--stdout\" to output to stdout.");
-			return bx::kExitFailure;
+			return usageError(_batch, _messageWriter, "Output file name must be specified or use \"--stdout\" to output to stdout.");
+		}
+
+		if (consoleOut
+		&&  _batch)
+		{
+			return usageError(_batch, _messageWriter, "\"--stdout\" can't be used in batch mode.");
 		}
 
 		const char* type = cmdLine.findOption('\0', "type");
 		if (NULL == type)
 		{
-			help("Must specify shader type.");
-			return bx::kExitFailure;
+			return usageError(_batch, _messageWriter, "Must specify shader type.");
 		}
 
 		Options options;
@@ -2812,22 +2844,21 @@ namespace bgfx
 
 		bool compiled = false;
 
-		bx::FileReader reader;
-		if (!bx::open(&reader, filePath) )
+		const std::string* source = _fileCache.load(filePath);
+		if (NULL == source)
 		{
-			bx::printf("Unable to open file '%s'.\n", filePath);
+			writef(_messageWriter, "Unable to open file '%s'.\n", filePath);
 		}
 		else
 		{
 			const char* varying = NULL;
-			File attribdef;
 
 			if ('c' != options.shaderType)
 			{
 				std::string defaultVarying = dir + "varying.def.sc";
 				const char* varyingdef = cmdLine.findOption("varyingdef", defaultVarying.c_str() );
-				attribdef.load(varyingdef);
-				varying = attribdef.getData();
+				const std::string* attribdef = _fileCache.load(varyingdef);
+				varying = NULL != attribdef ? attribdef->c_str() : NULL;
 
 				if (NULL     != varying
 				&&  *varying != '\0')
@@ -2836,25 +2867,12 @@ namespace bgfx
 				}
 				else
 				{
-					bx::printf("ERROR: Failed to parse varying def file: \"%s\" No input/output semantics will be generated in the code!\n", varyingdef);
+					writef(_messageWriter, "ERROR: Failed to parse varying def file: \"%s\" No input/output semantics will be generated in the code!\n", varyingdef);
 				}
 			}
 
-			int32_t size = (int32_t)bx::getSize(&reader);
-			const int32_t total = size + 16384;
-			char* data = new char[total];
-			size = bx::read(&reader, data, size, bx::ErrorAssert{});
-
-			// Trim UTF-8 BOM
-			if (data[0] == '\xef'
-			&&  data[1] == '\xbb'
-			&&  data[2] == '\xbf')
-			{
-				bx::memMove(data, &data[3], size-3);
-				size -= 3;
-			}
-
-			const char ch = data[0];
+			int32_t size = (int32_t)source->size();
+			const char ch = 0 < size ? source->at(0) : '\0';
 			if (false // https://en.wikipedia.org/wiki/Byte_order_mark#Byte_order_marks_by_encoding
 			||  '\x00' == ch
 			||  '\x0e' == ch
@@ -2867,15 +2885,19 @@ namespace bgfx
 			||  '\xff' == ch
 			   )
 			{
-				bx::printf("Shader input file has unsupported BOM.\n");
+				writef(_messageWriter, "Shader input file has unsupported BOM.\n");
 				return bx::kExitFailure;
 			}
 
+			// Shader buffer is modified and released by compiler, each job works on its own copy.
+			const int32_t total = size + 16384;
+			char* data = new char[total];
+			bx::memCopy(data, source->c_str(), size);
+
 			// Compiler generates "error X3000: syntax error: unexpected end of file"
 			// if input doesn't have empty line at EOF.
 			data[size] = '\n';
 			bx::memSet(&data[size+1], 0, total-size-1);
-			bx::close(&reader);
 
 			{
 				bx::FileWriter* writer = NULL;
@@ -2893,7 +2915,9 @@ namespace bgfx
 
 					if (!bx::open(writer, outFilePath) )
 					{
-						bx::printf("Unable to open output file '%s'.\n", outFilePath);
+						writef(_messageWriter, "Unable to open output file '%s'.\n", outFilePath);
+						delete writer;
+						delete [] data;
 						return bx::kExitFailure;
 					}
 				}
@@ -2905,7 +2929,7 @@ namespace bgfx
 						, size
 						, options
 						, consoleOut ? bx::getStdOut() : writer
-						, bx::getStdOut()
+						, _messageWriter
 						);
 
 				if (!consoleOut)
@@ -2923,10 +2947,297 @@ namespace bgfx
 
 		bx::remove(outFilePath);
 
-		bx::printf("Failed to build shader.\n");
+		writef(_messageWriter, "Failed to build shader.\n");
 		return bx::kExitFailure;
 	}
 
+	struct BatchJob
+	{
+		std::vector<std::string> m_args;
+	};
+
+	struct Batch
+	{
+		std::vector<BatchJob> m_jobs;
+		FileCache m_fileCache;
+		bx::Mutex m_mutex;
+		uint32_t m_nextJob;
+		uint32_t m_numFailed;
+	};
+
+	void replaceAll(std::string& _str, const char* _find, const std::string& _replace)
+	{
+		const size_t len = bx::strLen(_find);
+
+		for (size_t pos = _str.find(_find)
+			; std::string::npos != pos
+			; pos = _str.find(_find, pos + _replace.size() )
+			)
+		{
+			_str.replace(pos, len, _replace);
+		}
+	}
+
+	bool parseManifest(Batch& _batch, const char* _manifestPath, const std::string& _manifest)
+	{
+		int32_t line = 0;
+
+		for (bx::StringView next(_manifest.c_str(), int32_t(_manifest.size() ) ); !next.isEmpty(); )
+		{
+			char commandLine[4096];
+			uint32_t len = sizeof(commandLine);
+			int argc;
+			char* argv[128];
+			next = bx::tokenizeCommandLine(next, commandLine, len, argc, argv, BX_COUNTOF(argv), '\n');
+			++line;
+
+			if (0 == argc
+			||  '#' == argv[0][0])
+			{
+				continue;
+			}
+
+			// Profiles and define sets can be repeated on the same line, every line expands
+			// into profiles x define sets jobs.
+			std::vector<std::string> args;
+			std::vector<std::string> profiles;
+			std::vector<std::string> defines;
+			std::string output;
+
+			for (int ii = 0; ii < argc; ++ii)
+			{
+				const bool hasValue = ii+1 < argc;
+
+				if (hasValue
+				&& (0 == bx::strCmp(argv[ii], "-p") || 0 == bx::strCmp(argv[ii], "--profile") ) )
+				{
+					profiles.push_back(argv[++ii]);
+				}
+				else if (hasValue
+				&&  0 == bx::strCmp(argv[ii], "--define") )
+				{
+					defines.push_back(argv[++ii]);
+				}
+				else if (hasValue
+				&&  0 == bx::strCmp(argv[ii], "-o") )
+				{
+					output = argv[++ii];
+				}
+				else
+				{
+					args.push_back(argv[ii]);
+				}
+			}
+
+			if (output.empty() )
+			{
+				bx::printf("Error: %s(%d): Output file name must be specified.\n", _manifestPath, line);
+				return false;
+			}
+
+			if (1 < profiles.size()
+			&&  std::string::npos == output.find("{profile}") )
+			{
+				bx::printf("Error: %s(%d): Output file name must contain {profile} when multiple profiles are specified.\n", _manifestPath, line);
+				return false;
+			}
+
+			if (1 < defines.size()
+			&&  std::string::npos == output.find("{variant}") )
+			{
+				bx::printf("Error: %s(%d): Output file name must contain {variant} when multiple define sets are specified.\n", _manifestPath, line);
+				return false;
+			}
+
+			const uint32_t numProfiles = bx::max<uint32_t>(1, uint32_t(profiles.size() ) );
+			const uint32_t numVariants = bx::max<uint32_t>(1, uint32_t(defines.size() ) );
+
+			for (uint32_t pp = 0; pp < numProfiles; ++pp)
+			{
+				for (uint32_t vv = 0; vv < numVariants; ++vv)
+				{
+					char variant[16];
+					bx::snprintf(variant, BX_COUNTOF(variant), "%d", vv);
+
+					BatchJob job;
+					job.m_args.push_back("shaderc");
+					job.m_args.insert(job.m_args.end(), args.begin(), args.end() );
+
+					if (!profiles.empty() )
+					{
+						job.m_args.push_back("-p");
+						job.m_args.push_back(profiles[pp]);
+					}
+
+					if (!defines.empty() )
+					{
+						job.m_args.push_back("--define");
+						job.m_args.push_back(defines[vv]);
+					}
+
+					std::string outFilePath = output;
+					replaceAll(outFilePath, "{profile}", profiles.empty() ? std::string() : profiles[pp]);
+					replaceAll(outFilePath, "{variant}", variant);
+
+					job.m_args.push_back("-o");
+					job.m_args.push_back(outFilePath);
+
+					_batch.m_jobs.push_back(job);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void batchExecute(Batch* _batch)
+	{
+		const uint32_t numJobs = uint32_t(_batch->m_jobs.size() );
+
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&_batch->m_nextJob, 1)
+			; idx < numJobs
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&_batch->m_nextJob, 1)
+			)
+		{
+			const BatchJob& job = _batch->m_jobs[idx];
+
+			std::vector<const char*> argv;
+			for (size_t ii = 0; ii < job.m_args.size(); ++ii)
+			{
+				argv.push_back(job.m_args[ii].c_str() );
+			}
+
+			bx::CommandLine cmdLine(int32_t(argv.size() ), argv.data() );
+
+			// Messages are buffered per job, so that output of jobs running in parallel
+			// doesn't get interleaved.
+			StringWriter messages;
+			const int result = compileShader(cmdLine, _batch->m_fileCache, &messages, true);
+
+			bx::MutexScope scope(_batch->m_mutex);
+
+			if (bx::kExitSuccess != result)
+			{
+				++_batch->m_numFailed;
+			}
+
+			if (!messages.m_data.empty() )
+			{
+				const char* outFilePath = cmdLine.findOption('o');
+				bx::printf("%s:\n", NULL != outFilePath ? outFilePath : "?");
+				bx::write(bx::getStdOut(), messages.m_data.c_str(), int32_t(messages.m_data.size() ), bx::ErrorAssert{});
+			}
+		}
+	}
+
+	int32_t batchThreadFunc(bx::Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+		batchExecute( (Batch*)_userData);
+		return 0;
+	}
+
+	int compileBatch(const char* _manifestPath, uint32_t _numThreads)
+	{
+		Batch batch;
+		batch.m_nextJob   = 0;
+		batch.m_numFailed = 0;
+
+		{
+			FileCache manifestCache;
+			const std::string* manifest = manifestCache.load(_manifestPath);
+			if (NULL == manifest)
+			{
+				bx::printf("Unable to open batch manifest file '%s'.\n", _manifestPath);
+				return bx::kExitFailure;
+			}
+
+			if (!parseManifest(batch, _manifestPath, *manifest) )
+			{
+				return bx::kExitFailure;
+			}
+		}
+
+		const uint32_t numJobs    = uint32_t(batch.m_jobs.size() );
+		const uint32_t numThreads = bx::clamp<uint32_t>(_numThreads, 1, bx::max<uint32_t>(numJobs, 1) );
+
+		if (g_verbose)
+		{
+			bx::printf("Compiling %d shaders on %d threads.\n", numJobs, numThreads);
+		}
+
+		initGlslang();
+
+		// Calling thread executes jobs too.
+		bx::Thread* threads = new bx::Thread[numThreads-1];
+
+		for (uint32_t ii = 0; ii < numThreads-1; ++ii)
+		{
+			threads[ii].init(batchThreadFunc, &batch, 0, "shaderc");
+		}
+
+		batchExecute(&batch);
+
+		for (uint32_t ii = 0; ii < numThreads-1; ++ii)
+		{
+			threads[ii].shutdown();
+		}
+
+		delete [] threads;
+
+		shutdownGlslang();
+
+		if (0 != batch.m_numFailed)
+		{
+			bx::printf("Failed to build %d of %d shaders.\n", batch.m_numFailed, numJobs);
+			return bx::kExitFailure;
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	int compileShader(int _argc, const char* _argv[])
+	{
+		bx::CommandLine cmdLine(_argc, _argv);
+
+		if (cmdLine.hasArg('v', "version") )
+		{
+			bx::printf(
+				  "shaderc, bgfx shader compiler tool, version %d.%d.%d.\n"
+				, BGFX_SHADERC_VERSION_MAJOR
+				, BGFX_SHADERC_VERSION_MINOR
+				, BGFX_API_VERSION
+				);
+			return bx::kExitSuccess;
+		}
+
+		if (cmdLine.hasArg('h', "help") )
+		{
+			help();
+			return bx::kExitFailure;
+		}
+
+		g_verbose = cmdLine.hasArg("verbose");
+
+		const char* manifestPath = cmdLine.findOption("batch");
+		if (NULL != manifestPath)
+		{
+			uint32_t numThreads = bx::max<uint32_t>(1, std::thread::hardware_concurrency() );
+			cmdLine.hasArg(numThreads, 'j');
+
+			return compileBatch(manifestPath, numThreads);
+		}
+
+		initGlslang();
+
+		FileCache fileCache;
+		const int result = compileShader(cmdLine, fileCache, bx::getStdOut(), false);
+
+		shutdownGlslang();
+
+		return result;
+	}
+
 } // namespace bgfx
 
 int main(int _argc, const char* _argv[])
@@ -6,8 +6,13 @@
 #include "shaderc.h"
 #include "glsl_optimizer.h"
 
+#include <bx/mutex.h>
+
 namespace bgfx { namespace glsl
 {
+	// glsl-optimizer keeps global state, batch compile jobs must not run it in parallel.
+	static bx::Mutex s_mutex;
+
 	static bool compile(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
 		bx::ErrorAssert messageErr;
@@ -54,7 +59,7 @@ namespace bgfx { namespace glsl
 				end   = start + 20;
 			}
 
-			printCode(_code.c_str(), line, start, end, column);
+			printCode(_messageWriter, _code.c_str(), line, start, end, column);
 			bx::write(_messageWriter, &messageErr, "Error: %s\n", log);
 			glslopt_shader_delete(shader);
 			glslopt_cleanup(ctx);
@@ -398,6 +403,7 @@ namespace bgfx { namespace glsl
 
 	bool compileGLSLShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
+		bx::MutexScope scope(glsl::s_mutex);
 		return glsl::compile(_options, _version, _code, _shaderWriter, _messageWriter);
 	}
 
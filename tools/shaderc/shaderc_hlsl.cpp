@@ -17,6 +17,7 @@
 #include <d3dcompiler.h>
 #include <d3d11shader.h>
 #include <bx/os.h>
+#include <bx/mutex.h>
 
 #ifndef D3D_SVF_USED
 #	define D3D_SVF_USED 2
@@ -77,6 +78,10 @@ namespace bgfx { namespace hlsl
 		{ "D3DCompiler_43.dll", { 0x0a233719, 0x3960, 0x4578, { 0x9d, 0x7c, 0x20, 0x3b, 0x8b, 0x1d, 0x9c, 0xc1 } } },
 	};
 
+	// D3DCompiler library is loaded and unloaded for every compile, batch compile jobs must
+	// not run it in parallel.
+	static bx::Mutex s_mutex;
+
 	static const D3DCompiler* s_compiler;
 	static void* s_d3dcompilerdll;
 
@@ -667,7 +672,7 @@ namespace bgfx { namespace hlsl
 				end   = start + 20;
 			}
 
-			printCode(_code.c_str(), line, start, end, column);
+			printCode(_messageWriter, _code.c_str(), line, start, end, column);
 			bx::write(_messageWriter, &messageErr, "Error: D3DCompile failed 0x%08x %s\n", (uint32_t)hr, log);
 			errorMsg->Release();
 			return false;
@@ -842,6 +847,7 @@ namespace bgfx { namespace hlsl
 
 	bool compileHLSLShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
+		bx::MutexScope scope(hlsl::s_mutex);
 		return hlsl::compile(_options, _version, _code, _shaderWriter, _messageWriter, true);
 	}
 
@@ -356,8 +356,6 @@ namespace bgfx { namespace metal
 
 		bx::ErrorAssert messageErr;
 
-		glslang::InitializeProcess();
-
 		EShLanguage stage = getLang(_options.shaderType);
 		if (EShLangCount == stage)
 		{
@@ -427,7 +425,7 @@ namespace bgfx { namespace metal
 					end   = start + 20;
 				}
 
-				printCode(_code.c_str(), line, start, end, column);
+				printCode(_messageWriter, _code.c_str(), line, start, end, column);
 
 				bx::write(_messageWriter, &messageErr, "%s\n", log);
 			}
@@ -804,8 +802,6 @@ namespace bgfx { namespace metal
 		delete program;
 		delete shader;
 
-		glslang::FinalizeProcess();
-
 		return compiled && linked && validated;
 	}
 
@@ -452,8 +452,6 @@ namespace bgfx { namespace spirv
 
 		bx::ErrorAssert messageErr;
 
-		glslang::InitializeProcess();
-
 		EShLanguage stage = getLang(_options.shaderType);
 		if (EShLangCount == stage)
 		{
@@ -528,7 +526,7 @@ namespace bgfx { namespace spirv
 					end   = start + 20;
 				}
 
-				printCode(_code.c_str(), line, start, end, column);
+				printCode(_messageWriter, _code.c_str(), line, start, end, column);
 
 				bx::write(_messageWriter, &messageErr, "%s\n", log);
 			}
@@ -886,13 +884,21 @@ namespace bgfx { namespace spirv
 		delete program;
 		delete shader;
 
-		glslang::FinalizeProcess();
-
 		return compiled && linked && validated;
 	}
 
 } // namespace spirv
 
+	void initGlslang()
+	{
+		glslang::InitializeProcess();
+	}
+
+	void shutdownGlslang()
+	{
+		glslang::FinalizeProcess();
+	}
+
 	bool compileSPIRVShader(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _shaderWriter, bx::WriterI* _messageWriter)
 	{
 		return spirv::compile(_options, _version, _code, _shaderWriter, _messageWriter, true);